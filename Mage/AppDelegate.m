@@ -316,6 +316,10 @@
             self.backgroundOverlay.darkTheme = NO;
             
             self.backgroundOverlay.canReplaceMapContent = true;
+            
+            // The base map is on every map, draw each tile once
+            self.backgroundOverlay.tileCache = [[FeatureTileCache alloc] initWithGeoPackagePath:self.backgroundGeoPackage.path geoPackageName:@"countries" table:@"countries" style:@"base" theme:@"light"];
+            [self.backgroundOverlay prerenderTilesWithMaxZoom:3];
         }
         @catch (NSException *e) {
             NSLog(@"Exception initializing the base map GP %@", e);
@@ -358,6 +362,9 @@
             self.darkBackgroundOverlay.darkTheme = YES;
             
             self.darkBackgroundOverlay.canReplaceMapContent = true;
+            
+            self.darkBackgroundOverlay.tileCache = [[FeatureTileCache alloc] initWithGeoPackagePath:self.darkBackgroundGeoPackage.path geoPackageName:@"countries_dark" table:@"countries" style:@"base" theme:@"dark"];
+            [self.darkBackgroundOverlay prerenderTilesWithMaxZoom:3];
             }
             @catch (NSException *e) {
                 NSLog(@"Exception initializing the dark base map GP %@", e);
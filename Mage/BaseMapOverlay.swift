@@ -9,7 +9,7 @@
 import Foundation
 import GeoPackage
 
-@objc class BaseMapOverlay: GPKGFeatureOverlay, OverlayRenderable {
+@objc class BaseMapOverlay: CachedFeatureOverlay, OverlayRenderable {
     var renderer: MKOverlayRenderer {
         get {
             return MKTileOverlayRenderer(overlay: self)
@@ -18,6 +18,7 @@ import GeoPackage
     @objc public var darkTheme = false
     
     @objc public func cleanup() {
+        tileCache = nil
         super.close()
         featureTiles = nil
     }
@@ -26,7 +27,7 @@ import GeoPackage
         super.init(featureTiles: featureTiles)
     }
     
-    override func retrieveTileWith(x: Int, andY y: Int, andZoom zoom: Int) -> Data! {
+    override func renderTile(x: Int, y: Int, zoom: Int) -> Data? {
         let tileWidth = self.tileSize.width
         let tileHeight = self.tileSize.height
         
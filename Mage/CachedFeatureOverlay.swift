@@ -0,0 +1,71 @@
+//
+//  CachedFeatureOverlay.swift
+//  MAGE
+//
+//  Copyright © 2026 National Geospatial Intelligence Agency. All rights reserved.
+//
+
+import Foundation
+import GeoPackage
+
+/// Feature overlay which draws each tile once and then serves it from a FeatureTileCache
+@objc class CachedFeatureOverlay: GPKGFeatureOverlay {
+    @objc public var tileCache: FeatureTileCache?
+
+    override func retrieveTileWith(x: Int, andY y: Int, andZoom zoom: Int) -> Data! {
+        guard let tileCache = tileCache else {
+            return renderTile(x: x, y: y, zoom: zoom)
+        }
+        if let data = tileCache.tile(x: x, y: y, zoom: zoom) {
+            return data.isEmpty ? nil : data
+        }
+        let data = renderTile(x: x, y: y, zoom: zoom)
+        if let data = data, !data.isEmpty {
+            tileCache.setTile(data, x: x, y: y, zoom: zoom)
+        } else if hasNoFeatures(x: x, y: y, zoom: zoom) {
+            tileCache.setTile(nil, x: x, y: y, zoom: zoom)
+        }
+        return data
+    }
+
+    /// Only the feature index can confirm a tile is empty, a tile which was not drawn for any other reason is drawn again the next time
+    func hasNoFeatures(x: Int, y: Int, zoom: Int) -> Bool {
+        guard let featureTiles = featureTiles, featureTiles.isIndexQuery() else {
+            return false
+        }
+        return featureTiles.queryIndexedFeaturesCount(withX: Int32(x), andY: Int32(y), andZoom: Int32(zoom)) == 0
+    }
+
+    /// Draw the tile from the features
+    func renderTile(x: Int, y: Int, zoom: Int) -> Data? {
+        return super.retrieveTileWith(x: x, andY: y, andZoom: zoom)
+    }
+
+    /// Draw the tiles of the low zoom levels which are not cached yet in the background
+    @objc public func prerenderTiles(maxZoom: Int) {
+        guard tileCache != nil else {
+            return
+        }
+        DispatchQueue.global(qos: .utility).async { [weak self] in
+            let start = Date()
+            var rendered = 0
+            for zoom in 0...maxZoom {
+                let tiles = 1 << zoom
+                for x in 0..<tiles {
+                    for y in 0..<tiles {
+                        guard let self = self, let tileCache = self.tileCache, self.featureTiles != nil else {
+                            return
+                        }
+                        if tileCache.tile(x: x, y: y, zoom: zoom) == nil {
+                            autoreleasepool {
+                                _ = self.retrieveTileWith(x: x, andY: y, andZoom: zoom)
+                            }
+                            rendered += 1
+                        }
+                    }
+                }
+            }
+            NSLog("TIMING Rendered \(rendered) feature tiles through zoom \(maxZoom). Elapsed: \(start.timeIntervalSinceNow) seconds")
+        }
+    }
+}
@@ -0,0 +1,81 @@
+//
+//  CachedGridTileOverlay.swift
+//  MAGE
+//
+//  Copyright © 2026 National Geospatial Intelligence Agency. All rights reserved.
+//
+
+import Foundation
+import MapKit
+
+/// Serves the tiles of a grid tile overlay from memory and disk so each grid tile is only drawn once
+/// no matter how many maps show the grid or how often the grid overlay is replaced.  Tiles are kept
+/// apart by the interface style of the map and the content scale factor they were drawn at.
+@objc class CachedGridTileOverlay: MKTileOverlay {
+
+    private static let memoryCache: NSCache<NSString, NSData> = {
+        let cache = NSCache<NSString, NSData>()
+        cache.totalCostLimit = 16 * 1024 * 1024
+        return cache
+    }()
+
+    let gridOverlay: MKTileOverlay
+    let gridType: String
+    let version: String
+    /// light or dark, tiles drawn for one interface style are never shown in the other
+    let theme: String
+    private let tileCachesLock = NSLock()
+    private var tileCaches: [Int: FeatureTileCache] = [:]
+
+    /// The grid overlay is shared by every cached overlay of the grid type.  Make a new cached overlay when
+    /// the interface style of the map changes.
+    init(gridOverlay: MKTileOverlay, gridType: String, version: String, userInterfaceStyle: UIUserInterfaceStyle) {
+        self.gridOverlay = gridOverlay
+        self.gridType = gridType
+        self.version = version
+        self.theme = userInterfaceStyle == .dark ? "dark" : "light"
+        super.init(urlTemplate: nil)
+        tileSize = gridOverlay.tileSize
+        minimumZ = gridOverlay.minimumZ
+        maximumZ = gridOverlay.maximumZ
+        canReplaceMapContent = false
+    }
+
+    /// Tiles drawn at the content scale factor of a tile path
+    func tileCache(scale: CGFloat) -> FeatureTileCache {
+        let key = Int(scale.rounded())
+        tileCachesLock.lock()
+        defer { tileCachesLock.unlock() }
+        if let tileCache = tileCaches[key] {
+            return tileCache
+        }
+        let tileCache = FeatureTileCache(gridType: gridType, style: "\(key)x", theme: theme, version: version)
+        tileCaches[key] = tileCache
+        return tileCache
+    }
+
+    static func removeAll() {
+        memoryCache.removeAllObjects()
+    }
+
+    override func loadTile(at path: MKTileOverlayPath, result: @escaping (Data?, Error?) -> Void) {
+        let tileCache = self.tileCache(scale: path.contentScaleFactor)
+        let key = "\(tileCache.directory.path)/\(path.z)/\(path.x)/\(path.y)" as NSString
+        if let data = CachedGridTileOverlay.memoryCache.object(forKey: key) {
+            result(data as Data, nil)
+            return
+        }
+        if let data = tileCache.tile(x: path.x, y: path.y, zoom: path.z), !data.isEmpty {
+            CachedGridTileOverlay.memoryCache.setObject(data as NSData, forKey: key, cost: data.count)
+            result(data, nil)
+            return
+        }
+        gridOverlay.loadTile(at: path) { data, error in
+            if let data = data, !data.isEmpty, error == nil {
+                CachedGridTileOverlay.memoryCache.setObject(data as NSData, forKey: key, cost: data.count)
+                tileCache.setTile(data, x: path.x, y: path.y, zoom: path.z)
+            }
+            result(data, error)
+        }
+    }
+}
@@ -53,6 +53,15 @@ import CoreData
         
     }
     
+    @objc static var dirtyPredicate: NSPredicate {
+        return NSPredicate(format: "observationRemoteId != nil && dirty == YES");
+    }
+
+    /// Attachments of pushed observations which have not been uploaded, most recently modified first
+    @objc static func dirtyAttachments(context: NSManagedObjectContext) -> [Attachment]? {
+        return Attachment.mr_findAllSorted(by: AttachmentKey.lastModified.key, ascending: false, with: dirtyPredicate, in: context) as? [Attachment]
+    }
+    
     @objc public func sourceURL(size: NSInteger) -> URL? {
         if let localPath = self.localPath, FileManager.default.fileExists(atPath: localPath) {
             return URL(fileURLWithPath: localPath);
@@ -37,13 +37,13 @@ import MapKit
     @objc public var simpleFeature: SFGeometry? {
         get {
             if let geometry = self.geometry {
-                return SFGeometryUtils.decodeGeometry(geometry);
+                return GeometryDataTransformer.decode(geometry);
             }
             return nil;
         }
         set {
             if let newValue = newValue {
-                self.geometry = SFGeometryUtils.encode(newValue);
+                self.geometry = GeometryDataTransformer.encode(newValue);
             }
         }
     }
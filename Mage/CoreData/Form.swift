@@ -182,6 +182,13 @@ import CoreData
                     return;
                 }
                 let unzipped = SSZipArchive.unzipFile(atPath: fileString, toDestination: folderToUnzipTo)
+                ObservationIconResolver.shared.rebuild(eventId: eventId)
+                AnnotationImageCache.shared.removeAll()
+                // the cached rows show the icon paths of the old icons
+                ObservationDisplayModelCache.shared.removeAll()
+                if eventId == Server.currentEventId() {
+                    AnnotationImageCache.shared.warm(eventId: eventId)
+                }
                 if FileManager.default.isDeletableFile(atPath: fileString) {
                     do {
                         try FileManager.default.removeItem(atPath: fileString)
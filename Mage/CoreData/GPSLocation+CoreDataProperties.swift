@@ -19,6 +19,10 @@ extension GPSLocation {
     
     @NSManaged var eventId: NSNumber?;
     @NSManaged var geometryData: Data?;
+    @NSManaged var maxLatitude: NSNumber?;
+    @NSManaged var maxLongitude: NSNumber?;
+    @NSManaged var minLatitude: NSNumber?;
+    @NSManaged var minLongitude: NSNumber?;
     @NSManaged var properties: [AnyHashable : Any]?;
     @NSManaged var timestamp: Date?;
 }
@@ -17,33 +17,29 @@ import SimpleFeatures
     
     var cllocation: CLLocation? {
         get {
-            let centroid: SFPoint = SFGeometryUtils.centroid(of: geometry)
+            let centroid = GeometryCache.shared.centroid(for: self) ?? CLLocationCoordinate2D(latitude: 0, longitude: 0)
             if let dictionary = properties as? [String : Any] {
                 let cllocation = CLLocation(
-                    coordinate: CLLocationCoordinate2D(
-                        latitude: centroid.y as? CLLocationDegrees ?? 0.0,
-                        longitude: centroid.x as? CLLocationDegrees ?? 0.0),
+                    coordinate: centroid,
                     altitude: dictionary["altitude"] as? CLLocationDistance ?? 0.0,
                     horizontalAccuracy: dictionary["accuracy"] as? CLLocationAccuracy ?? 0.0,
                     verticalAccuracy: dictionary["accuracy"] as? CLLocationAccuracy ?? 0.0,
                     timestamp: timestamp ?? Date())
                 return cllocation
             } else {
-                return CLLocation(latitude: centroid.y.doubleValue, longitude: centroid.x.doubleValue)
+                return CLLocation(latitude: centroid.latitude, longitude: centroid.longitude)
             }
         }
     }
     
     @objc public var geometry: SFGeometry? {
         get {
-            if let geometryData = self.geometryData {
-                return SFGeometryUtils.decodeGeometry(geometryData);
-            }
-            return nil;
+            return GeometryCache.shared.geometry(for: self)
         }
         set {
             if let newValue = newValue {
-                self.geometryData = SFGeometryUtils.encode(newValue);
+                self.geometryData = GeometryDataTransformer.encode(newValue);
+                updateEnvelope(geometry: newValue)
             }
         }
     }
@@ -20,6 +20,10 @@ extension Location {
     
     @NSManaged var eventId: NSNumber?
     @NSManaged var geometryData: Data?
+    @NSManaged var maxLatitude: NSNumber?
+    @NSManaged var maxLongitude: NSNumber?
+    @NSManaged var minLatitude: NSNumber?
+    @NSManaged var minLongitude: NSNumber?
     @NSManaged var properties: [AnyHashable : Any]?
     @NSManaged var remoteId: String?
     @NSManaged var timestamp: Date?
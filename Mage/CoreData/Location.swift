@@ -38,25 +38,23 @@ import MagicalRecord
     
     @objc public var geometry: SFGeometry? {
         get {
-            if let geometryData = self.geometryData {
-                return SFGeometryUtils.decodeGeometry(geometryData);
-            }
-            return nil
+            return GeometryCache.shared.geometry(for: self)
         }
         set {
             if let newValue = newValue {
-                self.geometryData = SFGeometryUtils.encode(newValue);
+                self.geometryData = GeometryDataTransformer.encode(newValue);
+                updateEnvelope(geometry: newValue)
             }
         }
     }
     
     @objc public var location: CLLocation? {
         get {
-            if let geometry = geometry, let centroid = SFGeometryUtils.centroid(of: geometry) {
+            if let centroid = GeometryCache.shared.centroid(for: self) {
                 
                 let dictionary: [String : Any] = self.properties as? [String : Any] ?? [:]
                 return CLLocation(
-                    coordinate: CLLocationCoordinate2D(latitude: centroid.y.doubleValue, longitude: centroid.x.doubleValue),
+                    coordinate: centroid,
                     altitude: dictionary["altitude"] as? CLLocationDistance ?? 0.0,
                     horizontalAccuracy: dictionary["accuracy"] as? CLLocationAccuracy ?? 0.0,
                     verticalAccuracy: dictionary["accuracy"] as? CLLocationAccuracy ?? 0.0,
@@ -14,12 +14,18 @@ extension Observation {
         return NSFetchRequest<Observation>(entityName: "Observation")
     }
     
+    @NSManaged var currentUserFavorite: Bool
+    @NSManaged var daySection: String?
     @NSManaged var deviceId: String?
     @NSManaged var dirty: Bool
     @NSManaged var eventId: NSNumber?
     @NSManaged var error: [AnyHashable : Any]?
     @NSManaged var geometryData: Data?
     @NSManaged var lastModified: Date?
+    @NSManaged var maxLatitude: NSNumber?
+    @NSManaged var maxLongitude: NSNumber?
+    @NSManaged var minLatitude: NSNumber?
+    @NSManaged var minLongitude: NSNumber?
     @NSManaged var properties: [AnyHashable : Any]?
     @NSManaged var remoteId: String?
     @NSManaged var state: NSNumber?
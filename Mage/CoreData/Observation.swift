@@ -28,6 +28,18 @@ enum State: Int, CustomStringConvertible {
 
 @objc public class Observation: NSManagedObject, Navigable {
     
+    public override func willSave() {
+        super.willSave()
+        // the day the observation is listed under, kept in the store so lists can section without faulting every row
+        if !isDeleted {
+            let daySection = ObservationDaySection.key(date: timestamp)
+            if self.daySection != daySection {
+                self.daySection = daySection
+            }
+            updateCurrentUserFavorite(userId: UserDefaults.standard.currentUserId)
+        }
+    }
+    
     var orderedAttachments: [Attachment]? {
         get {
             var observationForms: [[String: Any]] = []
@@ -91,7 +103,7 @@ enum State: Int, CustomStringConvertible {
                     longitudeMeters = accuracy * 2.5
                 }
             } else {
-                let envelope = SFGeometryEnvelopeBuilder.buildEnvelope(with: geometry)
+                let envelope = GeometryCache.shared.envelope(for: self) ?? SFGeometryEnvelopeBuilder.buildEnvelope(with: geometry)
                 let boundingBox = GPKGBoundingBox(envelope: envelope)
                 if let size = boundingBox?.sizeInMeters() {
                     latitudeMeters = size.height + (2 * (size.height * 0.1))
@@ -99,8 +111,8 @@ enum State: Int, CustomStringConvertible {
                     
                 }
             }
-            if let centroid = geometry.centroid() {
-                return MKCoordinateRegion(center: CLLocationCoordinate2D(latitude: centroid.y.doubleValue, longitude: centroid.x.doubleValue), latitudinalMeters: latitudeMeters, longitudinalMeters: longitudeMeters)
+            if let centroid = GeometryCache.shared.centroid(for: self) {
+                return MKCoordinateRegion(center: centroid, latitudinalMeters: latitudeMeters, longitudinalMeters: longitudeMeters)
             }
         }
         
@@ -885,24 +897,22 @@ enum State: Int, CustomStringConvertible {
     
     @objc public var geometry: SFGeometry? {
         get {
-            if let geometryData = self.geometryData {
-                return SFGeometryUtils.decodeGeometry(geometryData);
-            }
-            return nil
+            return GeometryCache.shared.geometry(for: self)
         }
         set {
             if let newValue = newValue {
-                self.geometryData = SFGeometryUtils.encode(newValue);
+                self.geometryData = GeometryDataTransformer.encode(newValue);
             } else {
                 self.geometryData = nil
             }
+            updateEnvelope(geometry: newValue)
         }
     }
     
     @objc public var location: CLLocation? {
         get {
-            if let geometry = geometry, let centroid = SFGeometryUtils.centroid(of: geometry) {
-                return CLLocation(latitude: centroid.y.doubleValue, longitude: centroid.x.doubleValue);
+            if let centroid = GeometryCache.shared.centroid(for: self) {
+                return CLLocation(latitude: centroid.latitude, longitude: centroid.longitude);
             }
             return CLLocation(latitude: 0, longitude: 0);
         }
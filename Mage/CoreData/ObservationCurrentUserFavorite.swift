@@ -0,0 +1,89 @@
+//
+//  ObservationCurrentUserFavorite.swift
+//  MAGE
+//
+//  Copyright © 2026 National Geospatial Intelligence Agency. All rights reserved.
+//
+
+import Foundation
+import CoreData
+import MagicalRecord
+
+extension Observation {
+
+    /// Set the indexed currentUserFavorite flag from the favorites of the observation
+    func updateCurrentUserFavorite(userId: String?) {
+        let favorite = userId != nil && (favorites?.contains { !$0.isDeleted && $0.favorite && $0.userId == userId } ?? false)
+        if currentUserFavorite != favorite {
+            currentUserFavorite = favorite
+        }
+    }
+}
+
+/// Observations keep whether the current user favorited them in the indexed currentUserFavorite
+/// attribute so the favorites filter does not have to search the favorites of every observation.
+/// The flag is kept up to date when observations and favorites are saved and is recomputed in the
+/// background when a different user logs in, until then the filter searches the favorites.
+@objc public class ObservationCurrentUserFavorite: NSObject {
+    static let userIdKey = "observationCurrentUserFavoriteUserId"
+    static let batchSize = 500
+
+    private static let updateQueue = DispatchQueue(label: "mil.nga.giat.mage.observationCurrentUserFavorite", qos: .utility)
+
+    /// Whether the flags were computed for the current user
+    @objc public static var isCurrent: Bool {
+        guard let currentUserId = UserDefaults.standard.currentUserId else {
+            return false
+        }
+        return UserDefaults.standard.string(forKey: userIdKey) == currentUserId
+    }
+
+    /// Observations favorited by the current user
+    @objc public static func predicate() -> NSPredicate {
+        if isCurrent {
+            return NSPredicate(format: "currentUserFavorite == YES")
+        }
+        return NSPredicate(format: "SUBQUERY(favorites, $favorite, $favorite.favorite == YES AND $favorite.userId == %@).@count > 0", UserDefaults.standard.currentUserId ?? "")
+    }
+
+    @objc public static func updateInBackground() {
+        updateQueue.async {
+            updateIfNeeded()
+        }
+    }
+
+    /// Saves in batches and blocks until done, call this off of the main thread
+    @objc public static func updateIfNeeded() {
+        guard let userId = UserDefaults.standard.currentUserId, !isCurrent else {
+            return
+        }
+        let start = Date()
+        var objectIds: [NSManagedObjectID] = []
+        MagicalRecord.save(blockAndWait: { localContext in
+            // only the observations favorited by the previous user or the new user change
+            let fetchRequest = NSFetchRequest<NSManagedObjectID>(entityName: "Observation")
+            fetchRequest.resultType = .managedObjectIDResultType
+            fetchRequest.predicate = NSPredicate(format: "currentUserFavorite == YES OR ANY favorites.userId == %@", userId)
+            objectIds = (try? localContext.fetch(fetchRequest)) ?? []
+        })
+        for batchStart in stride(from: 0, to: objectIds.count, by: batchSize) {
+            // another user logged in, the next update starts over
+            if UserDefaults.standard.currentUserId != userId {
+                return
+            }
+            autoreleasepool {
+                let batch = objectIds[batchStart..<min(batchStart + batchSize, objectIds.count)]
+                MagicalRecord.save(blockAndWait: { localContext in
+                    let fetchRequest = NSFetchRequest<Observation>(entityName: "Observation")
+                    fetchRequest.predicate = NSPredicate(format: "self IN %@", Array(batch))
+                    fetchRequest.relationshipKeyPathsForPrefetching = ["favorites"]
+                    for observation in (try? localContext.fetch(fetchRequest)) ?? [] {
+                        observation.updateCurrentUserFavorite(userId: userId)
+                    }
+                })
+            }
+        }
+        UserDefaults.standard.set(userId, forKey: userIdKey)
+        NSLog("TIMING Updated the current user favorite of \(objectIds.count) observations. Elapsed: \(start.timeIntervalSinceNow) seconds")
+    }
+}
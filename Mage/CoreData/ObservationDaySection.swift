@@ -0,0 +1,126 @@
+//
+//  ObservationDaySection.swift
+//  MAGE
+//
+//  Copyright © 2026 National Geospatial Intelligence Agency. All rights reserved.
+//
+
+import Foundation
+import CoreData
+import MagicalRecord
+
+/// Observation lists are sectioned by the day the observation happened.  The day is kept in the
+/// indexed daySection attribute as yyyy-MM-dd in the display time zone so the sections come from
+/// the store rather than from formatting the timestamp of every observation.  The keys are
+/// rewritten in the background whenever the display time zone changes, until then lists fall back
+/// to the computed dateSection.
+@objc public class ObservationDaySection: NSObject {
+    static let timeZoneKey = "observationDaySectionTimeZone"
+    static let batchSize = 500
+
+    private static let updateQueue = DispatchQueue(label: "mil.nga.giat.mage.observationDaySection", qos: .utility)
+    private static var titles: [String: String] = [:]
+    private static var titleFormatter: DateFormatter?
+    private static let lock = NSLock()
+
+    static var timeZone: TimeZone {
+        return NSDate.isDisplayGMT() ? TimeZone(secondsFromGMT: 0)! : TimeZone.current
+    }
+
+    /// The section key path for lists sorted by timestamp
+    @objc public static var sectionNameKeyPath: String {
+        return isCurrent ? "daySection" : "dateSection"
+    }
+
+    /// Whether every daySection was written in the current display time zone
+    @objc public static var isCurrent: Bool {
+        return UserDefaults.standard.string(forKey: timeZoneKey) == timeZone.identifier
+    }
+
+    @objc public static func key(date: Date?) -> String? {
+        return key(date: date, timeZone: timeZone)
+    }
+
+    static func key(date: Date?, timeZone: TimeZone) -> String? {
+        guard let date = date else {
+            return nil
+        }
+        var calendar = Calendar(identifier: .gregorian)
+        calendar.timeZone = timeZone
+        let components = calendar.dateComponents([.year, .month, .day], from: date)
+        return String(format: "%04d-%02d-%02d", components.year ?? 0, components.month ?? 0, components.day ?? 0)
+    }
+
+    /// The header for a section name, the long style date for a daySection key
+    @objc public static func title(sectionName: String) -> String {
+        let timeZone = self.timeZone
+        lock.lock()
+        defer { lock.unlock() }
+        if titleFormatter?.timeZone != timeZone {
+            // the same format as the computed dateSection
+            let formatter = DateFormatter()
+            formatter.dateStyle = .long
+            formatter.timeStyle = .none
+            formatter.timeZone = timeZone
+            titleFormatter = formatter
+            titles = [:]
+        }
+        if let title = titles[sectionName] {
+            return title
+        }
+        let parts = sectionName.split(separator: "-").compactMap { Int($0) }
+        var calendar = Calendar(identifier: .gregorian)
+        calendar.timeZone = timeZone
+        guard parts.count == 3, let date = calendar.date(from: DateComponents(year: parts[0], month: parts[1], day: parts[2])) else {
+            // already a title, the computed dateSection
+            return sectionName
+        }
+        let title = titleFormatter?.string(from: date) ?? sectionName
+        titles[sectionName] = title
+        return title
+    }
+
+    /// Write the daySection of observations saved before it existed or written in another time zone
+    @objc public static func updateInBackground() {
+        updateQueue.async {
+            updateIfNeeded()
+        }
+    }
+
+    /// Saves in batches and blocks until done, call this off of the main thread
+    @objc public static func updateIfNeeded() {
+        let start = Date()
+        let timeZone = self.timeZone
+        let predicate = isCurrent ? NSPredicate(format: "daySection == nil AND timestamp != nil") : nil
+        var objectIds: [NSManagedObjectID] = []
+        MagicalRecord.save(blockAndWait: { localContext in
+            let fetchRequest = NSFetchRequest<NSManagedObjectID>(entityName: "Observation")
+            fetchRequest.resultType = .managedObjectIDResultType
+            fetchRequest.predicate = predicate
+            objectIds = (try? localContext.fetch(fetchRequest)) ?? []
+        })
+        for batchStart in stride(from: 0, to: objectIds.count, by: batchSize) {
+            // the display time zone changed again, the next update starts over
+            if timeZone != self.timeZone {
+                return
+            }
+            autoreleasepool {
+                let batch = objectIds[batchStart..<min(batchStart + batchSize, objectIds.count)]
+                MagicalRecord.save(blockAndWait: { localContext in
+                    let fetchRequest = NSFetchRequest<Observation>(entityName: "Observation")
+                    fetchRequest.predicate = NSPredicate(format: "self IN %@", Array(batch))
+                    for observation in (try? localContext.fetch(fetchRequest)) ?? [] {
+                        let daySection = key(date: observation.timestamp, timeZone: timeZone)
+                        if observation.daySection != daySection {
+                            observation.daySection = daySection
+                        }
+                    }
+                })
+            }
+        }
+        UserDefaults.standard.set(timeZone.identifier, forKey: timeZoneKey)
+        if !objectIds.isEmpty {
+            NSLog("TIMING Updated the day section of \(objectIds.count) observations. Elapsed: \(start.timeIntervalSinceNow) seconds")
+        }
+    }
+}
@@ -10,6 +10,14 @@ import Foundation
 import CoreData
 
 @objc public class ObservationFavorite: NSManagedObject {
+    public override func willSave() {
+        super.willSave()
+        // changing a favorite does not change the observation, keep its current user flag in step
+        if !isDeleted {
+            observation?.updateCurrentUserFavorite(userId: UserDefaults.standard.currentUserId)
+        }
+    }
+    
     @objc public static func favorite(userId: String, context: NSManagedObjectContext) -> ObservationFavorite? {
         let favorite = ObservationFavorite.mr_createEntity(in: context);
         favorite?.dirty = false
@@ -0,0 +1,434 @@
+//
+//  ObservationSearchIndex.swift
+//  MAGE
+//
+//  Copyright © 2026 National Geospatial Intelligence Agency. All rights reserved.
+//
+
+import Foundation
+import CoreData
+import SQLite3
+
+/// Full text index of what was entered into observation forms, kept in an SQLite FTS5 database in
+/// the caches directory so searching does not decode the properties of every observation.  Each
+/// observation is a row of its primary field, secondary field, user name and the rest of its text
+/// form values, ranked with the primary field weighted highest.  The index follows the store
+/// through the persistent history and is rebuilt in the background when it does not match the
+/// store.  Password, attachment and geometry fields are never indexed.
+@objc public class ObservationSearchIndex: NSObject {
+
+    @objc public static let shared = ObservationSearchIndex()
+
+    static let indexVersion = 1
+    static let batchSize = 500
+    static let indexedFieldTypes: Set<String> = [
+        FieldType.textfield.key,
+        FieldType.textarea.key,
+        FieldType.email.key,
+        FieldType.radio.key,
+        FieldType.dropdown.key,
+        FieldType.multiselectdropdown.key,
+        FieldType.numberfield.key
+    ]
+
+    struct Row {
+        let uri: String
+        let eventId: Int64
+        let primaryText: String
+        let secondaryText: String
+        let userName: String
+        let formText: String
+    }
+
+    private let indexQueue = DispatchQueue(label: "mil.nga.giat.mage.observationSearchIndex", qos: .utility)
+    private let readLock = NSLock()
+    private var writer: OpaquePointer?
+    private var reader: OpaquePointer?
+    private var context: NSManagedObjectContext?
+    private var subscription: PersistentHistorySubscription?
+
+    static var databasePath: String {
+        let caches = FileManager.default.urls(for: .cachesDirectory, in: .userDomainMask)[0]
+        return caches.appendingPathComponent("observationSearch.sqlite").path
+    }
+
+    /// The database and its write ahead log and shared memory files
+    static var databaseFiles: [String] {
+        return [databasePath, "\(databasePath)-wal", "\(databasePath)-shm"]
+    }
+
+    /// Open the index and follow changes to observations from where the index left off, rebuilding the index in the
+    /// background if it does not match the store.  The subscription is made before this returns so no save is missed.
+    @objc public func start() {
+        guard let coordinator = NSManagedObjectContext.mr_default().persistentStoreCoordinator else {
+            return
+        }
+        stop()
+        indexQueue.sync {
+            let context = NSManagedObjectContext(concurrencyType: .privateQueueConcurrencyType)
+            context.persistentStoreCoordinator = coordinator
+            self.context = context
+            // the index holds form values, protect it like the store it is built from
+            writer = ObservationSearchIndex.open(path: ObservationSearchIndex.databasePath, flags: SQLITE_OPEN_READWRITE | SQLITE_OPEN_CREATE | SQLITE_OPEN_FILEPROTECTION_COMPLETEUNLESSOPEN)
+            createSchema()
+            ObservationSearchIndex.protectFiles()
+            readLock.lock()
+            reader = ObservationSearchIndex.open(path: ObservationSearchIndex.databasePath, flags: SQLITE_OPEN_READONLY)
+            readLock.unlock()
+
+            // kept in the index itself so the index is rebuilt if the system purges the caches
+            let version = "\(ObservationSearchIndex.indexVersion)-\(coordinator.persistentStores.first?.identifier ?? "")"
+            var token = indexInfo(key: "version") == version ? indexedToken() : nil
+            if token == nil {
+                // the rebuild reads the store after this point, changes from here on queue up behind it
+                token = coordinator.currentPersistentHistoryToken(fromStores: nil)
+                indexQueue.async { [weak self] in
+                    self?.rebuild(version: version, token: token)
+                }
+            }
+            subscription = PersistentHistoryChangeProcessor.shared.subscribe(entityNames: ["Observation", "User"], keys: ["properties", "eventId", "user", "name"], after: token, queue: indexQueue, expired: { [weak self] in
+                // the history since the index was last updated is gone
+                self?.rebuild(version: version, token: coordinator.currentPersistentHistoryToken(fromStores: nil))
+            }) { [weak self] changeSets, token in
+                self?.apply(changeSets: changeSets, token: token)
+            }
+        }
+    }
+
+    @objc public func stop() {
+        indexQueue.sync {
+            subscription?.cancel()
+            subscription = nil
+            context = nil
+            sqlite3_close(writer)
+            writer = nil
+            readLock.lock()
+            sqlite3_close(reader)
+            reader = nil
+            readLock.unlock()
+        }
+    }
+
+    /// Stop the index and remove its files, for when the store is deleted or its data is cleared.  The index
+    /// is rebuilt the next time it is started.
+    @objc public func delete() {
+        stop()
+        for path in ObservationSearchIndex.databaseFiles where FileManager.default.fileExists(atPath: path) {
+            do {
+                try FileManager.default.removeItem(atPath: path)
+            } catch {
+                NSLog("Could not delete the observation search index file \(path): \(error)")
+            }
+        }
+    }
+
+    /// Files created before the index was opened with a protection class keep the default protection
+    static func protectFiles() {
+        for path in databaseFiles where FileManager.default.fileExists(atPath: path) {
+            do {
+                try FileManager.default.setAttributes([.protectionKey: FileProtectionType.completeUnlessOpen], ofItemAtPath: path)
+            } catch {
+                NSLog("Could not protect the observation search index file \(path): \(error)")
+            }
+        }
+    }
+
+    /// Block until the index has caught up with the changes delivered so far
+    @objc public func waitUntilIndexed() {
+        indexQueue.sync { }
+    }
+
+    /// The ids of the observations matching every word of the text, each word matching as a prefix, best match first
+    @objc public func search(text: String, eventId: NSNumber?, limit: Int = 100) -> [NSManagedObjectID] {
+        guard let match = ObservationSearchIndex.matchExpression(text: text), let coordinator = NSManagedObjectContext.mr_default().persistentStoreCoordinator else {
+            return []
+        }
+        readLock.lock()
+        defer { readLock.unlock() }
+        guard let reader = reader else {
+            return []
+        }
+        var sql = """
+            SELECT k.uri FROM observation_search JOIN observation_keys k ON k.id = observation_search.rowid
+            WHERE observation_search MATCH ?
+            """
+        if eventId != nil {
+            sql += " AND k.event_id = ?"
+        }
+        sql += " ORDER BY bm25(observation_search, 10.0, 5.0, 2.0, 1.0) LIMIT ?"
+
+        var statement: OpaquePointer?
+        guard sqlite3_prepare_v2(reader, sql, -1, &statement, nil) == SQLITE_OK else {
+            NSLog("Observation search failed \(String(cString: sqlite3_errmsg(reader)))")
+            return []
+        }
+        defer { sqlite3_finalize(statement) }
+        var index: Int32 = 1
+        ObservationSearchIndex.bind(statement, index, match)
+        if let eventId = eventId {
+            index += 1
+            sqlite3_bind_int64(statement, index, eventId.int64Value)
+        }
+        sqlite3_bind_int64(statement, index + 1, Int64(limit))
+
+        var objectIds: [NSManagedObjectID] = []
+        while sqlite3_step(statement) == SQLITE_ROW {
+            if let uri = sqlite3_column_text(statement, 0), let url = URL(string: String(cString: uri)), let objectId = coordinator.managedObjectID(forURIRepresentation: url) {
+                objectIds.append(objectId)
+            }
+        }
+        return objectIds
+    }
+
+    /// Predicate for the observations matching the text, for filtering a fetch
+    @objc public func predicate(text: String, eventId: NSNumber?, limit: Int) -> NSPredicate {
+        return NSPredicate(format: "self IN %@", search(text: text, eventId: eventId, limit: limit))
+    }
+
+    /// Every word becomes a quoted prefix query so nothing typed is read as FTS5 syntax
+    static func matchExpression(text: String) -> String? {
+        let words = text.lowercased().components(separatedBy: CharacterSet.alphanumerics.inverted).filter { !$0.isEmpty }
+        guard !words.isEmpty else {
+            return nil
+        }
+        return words.map { "\"\($0)\"*" }.joined(separator: " ")
+    }
+
+    /// The row of an observation, call on the queue of its context.  Forms are looked up once per batch.
+    static func row(observation: Observation, forms: inout [NSNumber: Form]) -> Row? {
+        guard !observation.objectID.isTemporaryID else {
+            return nil
+        }
+        var primaryText = ""
+        var secondaryText = ""
+        var formText: [String] = []
+        let observationForms = observation.properties?[ObservationKey.forms.key] as? [[AnyHashable: Any]] ?? []
+        for (index, observationForm) in observationForms.enumerated() {
+            guard let formId = observationForm[EventKey.formId.key] as? NSNumber else {
+                continue
+            }
+            if forms[formId] == nil, let context = observation.managedObjectContext {
+                forms[formId] = Form.mr_findFirst(byAttribute: "formId", withValue: formId, in: context)
+            }
+            guard let form = forms[formId] else {
+                continue
+            }
+            let primaryFieldName = index == 0 ? form.primaryMapField?[FieldKey.name.key] as? String : nil
+            let secondaryFieldName = index == 0 ? form.secondaryMapField?[FieldKey.name.key] as? String : nil
+            for field in form.fields ?? [] {
+                guard let name = field[FieldKey.name.key] as? String, let type = field[FieldKey.type.key] as? String, indexedFieldTypes.contains(type), let value = observationForm[name] else {
+                    continue
+                }
+                let text = Observation.fieldValueText(value: value, field: field as [AnyHashable: Any])
+                if text.isEmpty {
+                    continue
+                }
+                if name == primaryFieldName {
+                    primaryText = text
+                } else if name == secondaryFieldName {
+                    secondaryText = text
+                } else {
+                    formText.append(text)
+                }
+            }
+        }
+        return Row(uri: observation.objectID.uriRepresentation().absoluteString,
+                   eventId: observation.eventId?.int64Value ?? -1,
+                   primaryText: primaryText,
+                   secondaryText: secondaryText,
+                   userName: observation.user?.name ?? "",
+                   formText: formText.joined(separator: "\n"))
+    }
+
+    // the rest is only called on the index queue
+
+    private func createSchema() {
+        execute("PRAGMA journal_mode = WAL")
+        execute("CREATE TABLE IF NOT EXISTS index_info (key TEXT PRIMARY KEY, value TEXT)")
+        execute("CREATE TABLE IF NOT EXISTS observation_keys (id INTEGER PRIMARY KEY, uri TEXT NOT NULL UNIQUE, event_id INTEGER)")
+        execute("CREATE VIRTUAL TABLE IF NOT EXISTS observation_search USING fts5(primary_text, secondary_text, user_name, form_text, tokenize = 'unicode61 remove_diacritics 2', prefix = '2 3')")
+    }
+
+    private func rebuild(version: String, token: NSPersistentHistoryToken?) {
+        let start = Date()
+        var objectIds: [NSManagedObjectID] = []
+        context?.performAndWait {
+            let fetchRequest = NSFetchRequest<NSManagedObjectID>(entityName: "Observation")
+            fetchRequest.resultType = .managedObjectIDResultType
+            objectIds = (try? context?.fetch(fetchRequest)) ?? []
+        }
+        transaction {
+            execute("DELETE FROM observation_search")
+            execute("DELETE FROM observation_keys")
+            index(objectIds: objectIds)
+            setIndexInfo(key: "version", value: version)
+            setIndexedToken(token)
+        }
+        NSLog("TIMING Indexed \(objectIds.count) observations for search. Elapsed: \(start.timeIntervalSinceNow) seconds")
+    }
+
+    /// The history token of the last changes applied to the index
+    private func indexedToken() -> NSPersistentHistoryToken? {
+        guard let value = indexInfo(key: "token"), let data = Data(base64Encoded: value) else {
+            return nil
+        }
+        return try? NSKeyedUnarchiver.unarchivedObject(ofClass: NSPersistentHistoryToken.self, from: data)
+    }
+
+    private func setIndexedToken(_ token: NSPersistentHistoryToken?) {
+        guard let token = token, let data = try? NSKeyedArchiver.archivedData(withRootObject: token, requiringSecureCoding: true) else {
+            run("DELETE FROM index_info WHERE key = 'token'") { _ in }
+            return
+        }
+        setIndexInfo(key: "token", value: data.base64EncodedString())
+    }
+
+    private func setIndexInfo(key: String, value: String) {
+        run("INSERT OR REPLACE INTO index_info (key, value) VALUES (?, ?)") { statement in
+            ObservationSearchIndex.bind(statement, 1, key)
+            ObservationSearchIndex.bind(statement, 2, value)
+        }
+    }
+
+    private func indexInfo(key: String) -> String? {
+        var statement: OpaquePointer?
+        guard let writer = writer, sqlite3_prepare_v2(writer, "SELECT value FROM index_info WHERE key = ?", -1, &statement, nil) == SQLITE_OK else {
+            return nil
+        }
+        defer { sqlite3_finalize(statement) }
+        ObservationSearchIndex.bind(statement, 1, key)
+        guard sqlite3_step(statement) == SQLITE_ROW, let value = sqlite3_column_text(statement, 0) else {
+            return nil
+        }
+        return String(cString: value)
+    }
+
+    /// Apply the changes and keep the token of the transaction they came from with them
+    private func apply(changeSets: [EntityChangeSet], token: NSPersistentHistoryToken) {
+        var changed: Set<NSManagedObjectID> = []
+        var deleted: Set<NSManagedObjectID> = []
+        for changeSet in changeSets {
+            if changeSet.entityName == "User" {
+                // the user name is in the row of each of their observations
+                let userIds = Array(changeSet.updated)
+                context?.performAndWait {
+                    let fetchRequest = NSFetchRequest<NSManagedObjectID>(entityName: "Observation")
+                    fetchRequest.resultType = .managedObjectIDResultType
+                    fetchRequest.predicate = NSPredicate(format: "user IN %@", userIds)
+                    changed.formUnion((try? context?.fetch(fetchRequest)) ?? [])
+                }
+            } else {
+                changed.formUnion(changeSet.insertedOrUpdated)
+                deleted.formUnion(changeSet.deleted)
+            }
+        }
+        transaction {
+            for objectId in deleted {
+                remove(uri: objectId.uriRepresentation().absoluteString)
+            }
+            index(objectIds: Array(changed))
+            setIndexedToken(token)
+        }
+    }
+
+    // call within a transaction
+    private func index(objectIds: [NSManagedObjectID]) {
+        guard let context = context else {
+            return
+        }
+        for batchStart in stride(from: 0, to: objectIds.count, by: ObservationSearchIndex.batchSize) {
+            autoreleasepool {
+                let batch = objectIds[batchStart..<min(batchStart + ObservationSearchIndex.batchSize, objectIds.count)]
+                var rows: [Row] = []
+                context.performAndWait {
+                    let fetchRequest = NSFetchRequest<Observation>(entityName: "Observation")
+                    fetchRequest.predicate = NSPredicate(format: "self IN %@", Array(batch))
+                    fetchRequest.relationshipKeyPathsForPrefetching = ["user"]
+                    var forms: [NSNumber: Form] = [:]
+                    for observation in (try? context.fetch(fetchRequest)) ?? [] {
+                        if let row = ObservationSearchIndex.row(observation: observation, forms: &forms) {
+                            rows.append(row)
+                        }
+                    }
+                    context.reset()
+                }
+                for row in rows {
+                    upsert(row: row)
+                }
+            }
+        }
+    }
+
+    private func upsert(row: Row) {
+        remove(uri: row.uri)
+        run("INSERT INTO observation_keys (uri, event_id) VALUES (?, ?)") { statement in
+            ObservationSearchIndex.bind(statement, 1, row.uri)
+            sqlite3_bind_int64(statement, 2, row.eventId)
+        }
+        let rowId = sqlite3_last_insert_rowid(writer)
+        run("INSERT INTO observation_search (rowid, primary_text, secondary_text, user_name, form_text) VALUES (?, ?, ?, ?, ?)") { statement in
+            sqlite3_bind_int64(statement, 1, rowId)
+            ObservationSearchIndex.bind(statement, 2, row.primaryText)
+            ObservationSearchIndex.bind(statement, 3, row.secondaryText)
+            ObservationSearchIndex.bind(statement, 4, row.userName)
+            ObservationSearchIndex.bind(statement, 5, row.formText)
+        }
+    }
+
+    private func remove(uri: String) {
+        run("DELETE FROM observation_search WHERE rowid = (SELECT id FROM observation_keys WHERE uri = ?)") { statement in
+            ObservationSearchIndex.bind(statement, 1, uri)
+        }
+        run("DELETE FROM observation_keys WHERE uri = ?") { statement in
+            ObservationSearchIndex.bind(statement, 1, uri)
+        }
+    }
+
+    private func transaction(_ block: () -> Void) {
+        execute("BEGIN")
+        block()
+        execute("COMMIT")
+    }
+
+    private func execute(_ sql: String) {
+        guard let writer = writer else {
+            return
+        }
+        if sqlite3_exec(writer, sql, nil, nil, nil) != SQLITE_OK {
+            NSLog("Observation search index failed \(sql): \(String(cString: sqlite3_errmsg(writer)))")
+        }
+    }
+
+    private func run(_ sql: String, bind: (OpaquePointer?) -> Void) {
+        guard let writer = writer else {
+            return
+        }
+        var statement: OpaquePointer?
+        guard sqlite3_prepare_v2(writer, sql, -1, &statement, nil) == SQLITE_OK else {
+            NSLog("Observation search index failed \(sql): \(String(cString: sqlite3_errmsg(writer)))")
+            return
+        }
+        defer { sqlite3_finalize(statement) }
+        bind(statement)
+        if sqlite3_step(statement) != SQLITE_DONE {
+            NSLog("Observation search index failed \(sql): \(String(cString: sqlite3_errmsg(writer)))")
+        }
+    }
+
+    private static func open(path: String, flags: Int32) -> OpaquePointer? {
+        var db: OpaquePointer?
+        if sqlite3_open_v2(path, &db, flags | SQLITE_OPEN_NOMUTEX, nil) != SQLITE_OK {
+            NSLog("Could not open the observation search index at \(path)")
+            sqlite3_close(db)
+            return nil
+        }
+        return db
+    }
+
+    // SQLite copies the text
+    private static let transient = unsafeBitCast(-1, to: sqlite3_destructor_type.self)
+
+    private static func bind(_ statement: OpaquePointer?, _ index: Int32, _ text: String) {
+        sqlite3_bind_text(statement, index, text, -1, transient)
+    }
+}
@@ -28,6 +28,7 @@ import MagicalRecord
         DispatchQueue.global(qos: .userInitiated).async {
             self.raiseEventTaskPriorities(eventId: eventId);
         }
+        AnnotationImageCache.shared.warm(eventId: eventId)
         
         UserDefaults.standard.currentEventId = eventId;
     }
@@ -15,4 +15,5 @@ extension StaticLayer {
     }
     
     @NSManaged var data: [AnyHashable:Any]?
+    @NSManaged var staticFeatures: Set<StaticLayerFeature>?
 }
@@ -13,7 +13,44 @@ import CoreData
     
     public var features: [[AnyHashable: Any]]? {
         get {
-            return data?["features"] as? [[AnyHashable: Any]]
+            guard let featureSequence = featureSequence() else {
+                return nil
+            }
+            return Array(featureSequence.features)
+        }
+    }
+    
+    /// The features read one row at a time, each row is turned back into a fault once it has been read.
+    /// Layers which have not been migrated yet still hold their features in data.
+    /// drawingOnly leaves out the properties which are not needed to draw the features
+    func featureSequence(drawingOnly: Bool = false) -> (count: Int, features: AnySequence<[AnyHashable: Any]>)? {
+        if let legacyFeatures = data?[LayerKey.features.key] as? [[AnyHashable: Any]] {
+            return (count: legacyFeatures.count, features: AnySequence(legacyFeatures))
+        }
+        guard let remoteId = remoteId, let eventId = eventId, let context = managedObjectContext else {
+            return nil
+        }
+        let featureRows = (try? context.fetch(StaticLayerFeature.fetchRequest(layerId: remoteId, eventId: eventId))) ?? []
+        let features = featureRows.lazy.compactMap { featureRow -> [AnyHashable: Any]? in
+            defer {
+                context.refresh(featureRow, mergeChanges: false)
+            }
+            return drawingOnly ? featureRow.drawingFeature : featureRow.feature
+        }
+        return (count: featureRows.count, features: AnySequence(features))
+    }
+    
+    /// Replaces the stored feature rows with the features, the features are removed from data
+    func setFeatures(_ features: [[AnyHashable : Any]], context: NSManagedObjectContext) {
+        for staticFeature in staticFeatures ?? [] {
+            staticFeature.mr_deleteEntity(in: context)
+        }
+        for (index, feature) in features.enumerated() {
+            StaticLayerFeature.create(feature: feature, index: index, staticLayer: self, context: context)
+        }
+        if var data = data, data[LayerKey.features.key] != nil {
+            data.removeValue(forKey: LayerKey.features.key)
+            self.data = data
         }
     }
     
@@ -52,7 +89,7 @@ import CoreData
         return (feature as NSDictionary).value(forKeyPath: "properties.style.polyStyle.color.rgb") as? String ?? "#000000"
     }
     
-    func featureLineOpacity(feature: [AnyHashable : Any]) -> Double {
+    static func featureLineOpacity(feature: [AnyHashable : Any]) -> Double {
         return (feature as NSDictionary).value(forKeyPath: "properties.style.lineStyle.color.opacity") as? Double ?? 255.0
     }
     
@@ -71,6 +108,7 @@ import CoreData
     }
     
     @objc public static let StaticLayerLoaded = "mil.nga.giat.mage.static.layer.loaded";
+    @objc public static let StaticLayerLoadProgress = "mil.nga.giat.mage.static.layer.load.progress";
     
     @objc public static func operationToFetchStaticLayerData(layer: StaticLayer, success: ((URLSessionDataTask,Any?) -> Void)?, failure: ((URLSessionDataTask?, Error) -> Void)?) -> URLSessionDataTask? {
         guard let manager = MageSessionManager.shared(), let layerId = layer.remoteId, let eventId = layer.eventId, let baseURL = MageServer.baseURL() else {
@@ -121,9 +159,12 @@ import CoreData
                         }
                     }
                     
-                    dictionaryResponse[LayerKey.features.key] = features;
+                    dictionaryResponse.removeValue(forKey: LayerKey.features.key)
+                    localLayer.data = dictionaryResponse;
+                    localLayer.setFeatures(features, context: context)
+                } else {
+                    localLayer.data = dictionaryResponse;
                 }
-                localLayer.data = dictionaryResponse;
                 localLayer.loaded = NSNumber(floatLiteral: OFFLINE_LAYER_LOADED)
                 localLayer.downloading = false;
                 
@@ -184,6 +225,7 @@ import CoreData
             }
             localLayer.loaded = NSNumber(floatLiteral: Layer.OFFLINE_LAYER_NOT_DOWNLOADED);
             localLayer.data = nil
+            localLayer.setFeatures([], context: context)
         } completion: { contextDidSave, error in
         }
     }
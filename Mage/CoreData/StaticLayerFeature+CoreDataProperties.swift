@@ -0,0 +1,32 @@
+//
+//  StaticLayerFeature+CoreDataProperties.swift
+//  MAGE
+//
+//  Copyright © 2026 National Geospatial Intelligence Agency. All rights reserved.
+//
+
+import Foundation
+import CoreData
+
+extension StaticLayerFeature {
+    @nonobjc public class func fetchRequest() -> NSFetchRequest<StaticLayerFeature> {
+        return NSFetchRequest<StaticLayerFeature>(entityName: "StaticLayerFeature")
+    }
+    
+    @NSManaged var eventId: NSNumber?
+    @NSManaged var featureDescription: String?
+    @NSManaged var featureIndex: NSNumber?
+    @NSManaged var featureType: String?
+    @NSManaged var geometryData: Data?
+    @NSManaged var layerId: NSNumber?
+    @NSManaged var maxLatitude: NSNumber?
+    @NSManaged var maxLongitude: NSNumber?
+    @NSManaged var minLatitude: NSNumber?
+    @NSManaged var minLongitude: NSNumber?
+    @NSManaged var name: String?
+    @NSManaged var propertiesData: Data?
+    @NSManaged var remoteId: String?
+    @NSManaged var styleData: Data?
+    @NSManaged var timestamp: String?
+    @NSManaged var staticLayer: StaticLayer?
+}
@@ -0,0 +1,161 @@
+//
+//  StaticLayerFeature.swift
+//  MAGE
+//
+//  Copyright © 2026 National Geospatial Intelligence Agency. All rights reserved.
+//
+
+import Foundation
+import CoreData
+import MapKit
+import MagicalRecord
+
+/// One GeoJSON feature of a static layer.  The geometry is stored as well known binary with a
+/// bounding box so features can be fetched for an area, and the name, description and style
+/// needed to draw the feature are stored separately from the full feature properties, which
+/// are only decoded when the whole feature is asked for.
+@objc public class StaticLayerFeature: NSManagedObject {
+
+    @discardableResult
+    static func create(feature: [AnyHashable : Any], index: Int, staticLayer: StaticLayer, context: NSManagedObjectContext) -> StaticLayerFeature? {
+        guard let staticLayerFeature = StaticLayerFeature.mr_createEntity(in: context) else {
+            return nil
+        }
+        staticLayerFeature.staticLayer = staticLayer
+        staticLayerFeature.layerId = staticLayer.remoteId
+        staticLayerFeature.eventId = staticLayer.eventId
+        staticLayerFeature.featureIndex = NSNumber(value: index)
+        staticLayerFeature.populate(feature: feature)
+        return staticLayerFeature
+    }
+
+    func populate(feature: [AnyHashable : Any]) {
+        if let featureId = feature[StaticLayerKey.id.key] {
+            remoteId = "\(featureId)"
+        }
+        featureType = StaticLayer.featureType(feature: feature)
+        name = StaticLayer.featureName(feature: feature)
+        featureDescription = StaticLayer.featureDescription(feature: feature)
+
+        let properties = feature[StaticLayerKey.properties.key] as? [AnyHashable : Any]
+        timestamp = properties?["timestamp"] as? String
+        if let style = properties?[StaticLayerKey.style.key] as? [AnyHashable : Any] {
+            styleData = try? JSONSerialization.data(withJSONObject: style)
+        }
+        if let properties = properties {
+            propertiesData = MagePropertiesCodec.encode(properties) ?? (try? JSONSerialization.data(withJSONObject: properties))
+        }
+
+        let geometry = GeometryDeserializer.parseGeometry(json: feature["geometry"] as? [AnyHashable : Any])
+        geometryData = geometry.flatMap { GeometryDataTransformer.encode($0) }
+        updateEnvelope(geometry: geometry)
+    }
+
+    var style: [AnyHashable : Any]? {
+        guard let styleData = styleData else {
+            return nil
+        }
+        return (try? JSONSerialization.jsonObject(with: styleData)) as? [AnyHashable : Any]
+    }
+
+    /// Every property of the feature as it was downloaded
+    var properties: [AnyHashable : Any]? {
+        guard let propertiesData = propertiesData else {
+            return nil
+        }
+        if MagePropertiesCodec.isEncoded(propertiesData) {
+            return MagePropertiesCodec.decode(propertiesData)
+        }
+        // rows written before the properties were encoded with the codec
+        return (try? JSONSerialization.jsonObject(with: propertiesData)) as? [AnyHashable : Any]
+    }
+
+    /// The feature as GeoJSON with every property as it was downloaded
+    var feature: [AnyHashable : Any]? {
+        return feature(properties: properties ?? drawingProperties)
+    }
+
+    /// The feature as GeoJSON with only the properties used to draw and describe it
+    var drawingFeature: [AnyHashable : Any]? {
+        return feature(properties: drawingProperties)
+    }
+
+    private var drawingProperties: [AnyHashable : Any] {
+        var properties: [AnyHashable : Any] = [:]
+        properties["name"] = name
+        properties["description"] = featureDescription
+        properties["timestamp"] = timestamp
+        properties[StaticLayerKey.style.key] = style
+        return properties
+    }
+
+    private func feature(properties: [AnyHashable : Any]) -> [AnyHashable : Any]? {
+        guard let geometryData = geometryData, let geometry = GeometryDataTransformer.decode(geometryData), let geometryJson = GeometrySerializer.serializeGeometry(geometry) else {
+            return nil
+        }
+        var feature: [AnyHashable : Any] = [
+            "type": "Feature",
+            "geometry": geometryJson,
+            StaticLayerKey.properties.key: properties
+        ]
+        feature[StaticLayerKey.id.key] = remoteId
+        return feature
+    }
+
+    /// Features of the layer in the order they were downloaded, faulted in batches
+    static func fetchRequest(layerId: NSNumber, eventId: NSNumber) -> NSFetchRequest<StaticLayerFeature> {
+        let fetchRequest = StaticLayerFeature.fetchRequest()
+        fetchRequest.predicate = NSPredicate(format: "layerId == %@ AND eventId == %@", layerId, eventId)
+        fetchRequest.sortDescriptors = [NSSortDescriptor(key: "featureIndex", ascending: true)]
+        fetchRequest.fetchBatchSize = 500
+        return fetchRequest
+    }
+
+    /// Features of the layers whose geometry intersects the map rect
+    static func fetchFeatures(intersecting mapRect: MKMapRect, layerIds: [NSNumber], eventId: NSNumber, context: NSManagedObjectContext) -> [StaticLayerFeature] {
+        return fetch(intersecting: mapRect, predicate: NSPredicate(format: "layerId IN %@ AND eventId == %@", layerIds, eventId), sortDescriptors: [NSSortDescriptor(key: "featureIndex", ascending: true)], context: context)
+    }
+
+    /// Features of the layers whose name contains the text.  No index can serve a contains match, the layer index narrows
+    /// the rows to the selected layers and their names are scanned.
+    static func searchFeatures(text: String, layerIds: [NSNumber], eventId: NSNumber, context: NSManagedObjectContext) -> [StaticLayerFeature] {
+        let fetchRequest = StaticLayerFeature.fetchRequest()
+        fetchRequest.predicate = NSPredicate(format: "layerId IN %@ AND eventId == %@ AND name CONTAINS[cd] %@", layerIds, eventId, text)
+        fetchRequest.sortDescriptors = [NSSortDescriptor(key: "name", ascending: true)]
+        return (try? context.fetch(fetchRequest)) ?? []
+    }
+}
+
+extension StaticLayerFeature: GeometryEnvelopeStoring {}
+
+/// Moves the features of layers downloaded before features were stored as rows out of the layer data
+@objc public class StaticLayerFeatureMigration: NSObject {
+
+    /// Saves one layer at a time and blocks until done, call this off of the main thread
+    @objc public static func migrateIfNeeded() {
+        let start = Date()
+        var layerObjectIds: [NSManagedObjectID] = []
+        MagicalRecord.save(blockAndWait: { localContext in
+            let fetchRequest = NSFetchRequest<NSManagedObjectID>(entityName: "StaticLayer")
+            fetchRequest.resultType = .managedObjectIDResultType
+            fetchRequest.predicate = NSPredicate(format: "data != nil")
+            layerObjectIds = (try? localContext.fetch(fetchRequest)) ?? []
+        })
+        var count = 0
+        for objectId in layerObjectIds {
+            autoreleasepool {
+                MagicalRecord.save(blockAndWait: { localContext in
+                    guard let staticLayer = try? localContext.existingObject(with: objectId) as? StaticLayer,
+                          let features = staticLayer.data?[LayerKey.features.key] as? [[AnyHashable : Any]] else {
+                        return
+                    }
+                    staticLayer.setFeatures(features, context: localContext)
+                    count += features.count
+                })
+            }
+        }
+        if count > 0 {
+            NSLog("TIMING Migrated \(count) static layer features to rows. Elapsed: \(start.timeIntervalSinceNow) seconds")
+        }
+    }
+}
@@ -92,18 +92,24 @@ import Kingfisher
             
             let saveStart = Date()
             NSLog("TIMING Saving Myself @ \(saveStart)")
+            var prefetchJob: UserImagePrefetchJob?;
             MagicalRecord.save { localContext in
                 guard let myself = responseObject as? [AnyHashable : Any], let userId = myself["id"] as? String else {
                     return;
                 }
+                var saved: User?;
                 if let user = User.fetchUser(userId: userId, context: localContext) {
                     user.update(json: myself, context: localContext)
+                    saved = user;
                 } else {
-                    User.insert(json: myself, context: localContext)
+                    saved = User.insert(json: myself, context: localContext)
                 }
-                
+                prefetchJob = UserImagePrefetchJob(users: [saved].compactMap { $0 });
             } completion: { contextDidSave, error in
                 NSLog("TIMING Saved Myself. Elapsed: \(saveStart.timeIntervalSinceNow) seconds")
+                if error == nil {
+                    prefetchJob?.start();
+                }
 
                 if let error = error {
                     if let failure = failure {
@@ -148,21 +154,27 @@ import Kingfisher
                 return;
             }
             
+            var prefetchJob: UserImagePrefetchJob?;
             MagicalRecord.save { localContext in
                 if let userId = userJson[UserKey.id.key] as? String {
-                    
+                    var saved: User?;
                     if let user = User.mr_findFirst(byAttribute: UserKey.remoteId.key, withValue: userId, in: localContext) {
                         // already exists in core data, lets update the object we have
                         print("Updating user in the database \(user.name ?? "")");
                         user.update(json: userJson, context: localContext);
+                        saved = user;
                     } else {
                         // not in core data yet need to create a new managed object
                         print("Inserting new user into database");
-                        User.insert(json: userJson, context: localContext)
+                        saved = User.insert(json: userJson, context: localContext)
                     }
+                    prefetchJob = UserImagePrefetchJob(users: [saved].compactMap { $0 });
                 }
             } completion: { contextDidSave, error in
                 NSLog("TIMING Saved User /api/users/\(userId). Elapsed: \(saveStart.timeIntervalSinceNow) seconds")
+                if error == nil {
+                    prefetchJob?.start();
+                }
 
                 if let error = error {
                     if let failure = failure {
@@ -210,6 +222,7 @@ import Kingfisher
                 return;
             }
             
+            var prefetchJob: UserImagePrefetchJob?;
             MagicalRecord.save { localContext in
                 // Get the user ids to query
                 var userIds: [String] = [];
@@ -227,6 +240,7 @@ import Kingfisher
                     }
                 }
                 
+                var saved: [User] = [];
                 for userJson in users {
                     // pull from query map
                     guard let userId = userJson[UserKey.id.key] as? String else {
@@ -236,15 +250,22 @@ import Kingfisher
                         // already exists in core data, lets update the object we have
                         print("Updating user in the database \(user.name ?? "")");
                         user.update(json: userJson, context: localContext);
-                        
+                        saved.append(user);
                     } else {
                         // not in core data yet need to create a new managed object
                         print("Inserting new user into database");
-                        User.insert(json: userJson, context: localContext)
+                        if let user = User.insert(json: userJson, context: localContext) {
+                            saved.append(user);
+                        }
                     }
                 }
+                // one job for the icons and avatars of every user in the sync
+                prefetchJob = UserImagePrefetchJob(users: saved);
             } completion: { contextDidSave, error in
                 NSLog("TIMING Saved Users. Elapsed: \(saveStart.timeIntervalSinceNow) seconds")
+                if error == nil {
+                    prefetchJob?.start();
+                }
 
                 if let error = error {
                     if let failure = failure {
@@ -291,9 +312,6 @@ import Kingfisher
         if let lastUpdatedString = json[UserKey.lastUpdated.key] as? String {
             self.lastUpdated = dateFormat.date(from: lastUpdatedString)
         }
-        // go pull their icon and avatar if they got one using the image cache which will decide if we need to pull
-        self.prefetchIconAndAvatar();
-        
         if let userRole = json[UserKey.role.key] as? [AnyHashable : Any] {
             if let roleId = userRole[RoleKey.id.key] as? String, let role = Role.mr_findFirst(byAttribute: RoleKey.remoteId.key, withValue: roleId, in: context) {
                 self.role = role;
@@ -317,25 +335,4 @@ import Kingfisher
         }
     }
     
-    func prefetchIconAndAvatar() {
-        if let cacheIconUrl = cacheIconUrl, let url = URL(string: cacheIconUrl) {
-            let prefetcher = ImagePrefetcher(urls: [url], options: [
-                .requestModifier(ImageCacheProvider.shared.accessTokenModifier),
-                .diskCacheExpiration(.never)
-            ]) {
-                skippedResources, failedResources, completedResources in
-            }
-            prefetcher.start()
-        }
-        if let cacheAvatarUrl = self.cacheAvatarUrl, let url = URL(string: cacheAvatarUrl) {
-            print("caching avatar \(url)")
-            let prefetcher = ImagePrefetcher(urls: [url], options: [
-                .requestModifier(ImageCacheProvider.shared.accessTokenModifier)
-            ]) {
-                skippedResources, failedResources, completedResources in
-            }
-            prefetcher.start()
-        }
-    }
-    
 }
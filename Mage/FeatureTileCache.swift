@@ -0,0 +1,94 @@
+//
+//  FeatureTileCache.swift
+//  MAGE
+//
+//  Copyright © 2026 National Geospatial Intelligence Agency. All rights reserved.
+//
+
+import Foundation
+
+/// Rendered feature tiles of one GeoPackage table saved in the caches directory, keyed by the
+/// style and theme they were drawn with and z/x/y.  The tiles are stored under a signature of the
+/// GeoPackage file so they are thrown away when the GeoPackage changes, for instance when it is
+/// indexed or imported again.  Grid tiles use the same layout with a style version as the signature.
+/// The system may purge the caches directory at any time.
+@objc class FeatureTileCache: NSObject {
+
+    static let rootDirectory: URL = FileManager.default.urls(for: .cachesDirectory, in: .userDomainMask)[0].appendingPathComponent("featureTiles", isDirectory: true)
+
+    let directory: URL
+
+    @objc convenience init?(geoPackagePath: String?, geoPackageName: String, table: String, style: String, theme: String?) {
+        guard let geoPackagePath = geoPackagePath, let signature = FeatureTileCache.signature(path: geoPackagePath) else {
+            return nil
+        }
+        self.init(sourceDirectory: FeatureTileCache.directory(geoPackageName: geoPackageName), table: table, style: style, theme: theme, signature: signature)
+    }
+
+    /// Tiles of a grid type, the version is changed whenever the way the grid is drawn changes
+    convenience init(gridType: String, style: String, theme: String?, version: String) {
+        let sourceDirectory = FeatureTileCache.rootDirectory.deletingLastPathComponent().appendingPathComponent("gridTiles", isDirectory: true)
+        self.init(sourceDirectory: sourceDirectory, table: gridType, style: style, theme: theme, signature: version)
+    }
+
+    init(sourceDirectory: URL, table: String, style: String, theme: String?, signature: String) {
+        let keyDirectory = sourceDirectory
+            .appendingPathComponent(FeatureTileCache.pathComponent(table), isDirectory: true)
+            .appendingPathComponent(FeatureTileCache.pathComponent(style), isDirectory: true)
+            .appendingPathComponent(FeatureTileCache.pathComponent(theme ?? "default"), isDirectory: true)
+        directory = keyDirectory.appendingPathComponent(FeatureTileCache.pathComponent(signature), isDirectory: true)
+        super.init()
+
+        // tiles drawn from an earlier version of the source
+        let currentDirectory = directory
+        DispatchQueue.global(qos: .utility).async {
+            let staleDirectories = (try? FileManager.default.contentsOfDirectory(at: keyDirectory, includingPropertiesForKeys: nil)) ?? []
+            for staleDirectory in staleDirectories where staleDirectory.lastPathComponent != currentDirectory.lastPathComponent {
+                try? FileManager.default.removeItem(at: staleDirectory)
+            }
+        }
+    }
+
+    /// The modification date and size of the GeoPackage file
+    static func signature(path: String) -> String? {
+        guard let attributes = try? FileManager.default.attributesOfItem(atPath: path),
+              let modified = attributes[.modificationDate] as? Date,
+              let size = attributes[.size] as? NSNumber else {
+            return nil
+        }
+        return "\(Int64(modified.timeIntervalSince1970 * 1000))-\(size.int64Value)"
+    }
+
+    static func directory(geoPackageName: String) -> URL {
+        return rootDirectory.appendingPathComponent(pathComponent(geoPackageName), isDirectory: true)
+    }
+
+    static func pathComponent(_ name: String) -> String {
+        return name.addingPercentEncoding(withAllowedCharacters: .alphanumerics) ?? name
+    }
+
+    /// Remove every tile drawn from the GeoPackage
+    @objc static func removeTiles(geoPackageName: String) {
+        try? FileManager.default.removeItem(at: directory(geoPackageName: geoPackageName))
+    }
+
+    func url(x: Int, y: Int, zoom: Int) -> URL {
+        return directory.appendingPathComponent("\(zoom)/\(x)/\(y).png")
+    }
+
+    /// The tile if it was drawn before, empty data when the tile has no features
+    @objc func tile(x: Int, y: Int, zoom: Int) -> Data? {
+        return try? Data(contentsOf: url(x: x, y: y, zoom: zoom))
+    }
+
+    /// Save the tile, nil or empty data marks a tile the feature index confirmed has no features
+    @objc func setTile(_ data: Data?, x: Int, y: Int, zoom: Int) {
+        let tileURL = url(x: x, y: y, zoom: zoom)
+        do {
+            try FileManager.default.createDirectory(at: tileURL.deletingLastPathComponent(), withIntermediateDirectories: true, attributes: nil)
+            try (data ?? Data()).write(to: tileURL, options: .atomic)
+        } catch {
+            NSLog("Failed to cache feature tile \(zoom)/\(x)/\(y): \(error)")
+        }
+    }
+}
@@ -32,6 +32,12 @@ extension UIImage {
     @objc public static func setAnnotationImage(feedItem: FeedItem, annotationView: MKAnnotationView) {
         if let url: URL = feedItem.iconURL {
             let size = 35;
+            let cacheKey = AnnotationImageCache.key(source: url.absoluteString, width: CGFloat(size))
+            if let image = AnnotationImageCache.shared.image(forKey: cacheKey) {
+                annotationView.image = image;
+                annotationView.centerOffset = CGPoint(x: 0, y: -(image.size.height/2.0))
+                return
+            }
             
             KingfisherManager.shared.retrieveImage(with: url, options: [
                 .requestModifier(ImageCacheProvider.shared.accessTokenModifier),
@@ -43,20 +49,29 @@ extension UIImage {
                 case .success(let value):
                     
                     let image = value.image.aspectResize(to: CGSize(width: size, height: size))
+                    AnnotationImageCache.shared.setImage(image, forKey: cacheKey)
                     annotationView.image = image;
                     annotationView.centerOffset = CGPoint(x: 0, y: -((annotationView.image?.size.height ?? 0.0)/2.0))
                     
                 case .failure(_):
-                    annotationView.image = UIImage.init(named: "observations")?.withRenderingMode(.alwaysTemplate).colorized(color: globalContainerScheme().colorScheme.primaryColor);
+                    annotationView.image = defaultAnnotationImage()
                     annotationView.centerOffset = CGPoint(x: 0, y: -((annotationView.image?.size.height ?? 0.0)/2.0))
                 }
             }
         } else {
-            annotationView.image = UIImage.init(named: "observations")?.withRenderingMode(.alwaysTemplate).colorized(color: globalContainerScheme().colorScheme.primaryColor);
+            annotationView.image = defaultAnnotationImage()
             annotationView.centerOffset = CGPoint(x: 0, y: -((annotationView.image?.size.height ?? 0.0)/2.0))
         }
     }
     
+    // the same colorized image is shared by every feed item without an icon
+    static func defaultAnnotationImage() -> UIImage? {
+        guard let image = UIImage.init(named: "observations") else {
+            return nil
+        }
+        return AnnotationImageCache.shared.image(named: "observations", image: image, width: image.size.width, tint: globalContainerScheme().colorScheme.primaryColor)
+    }
+    
     public static func createFeedItemRetrievers(delegate: FeedItemDelegate) -> [FeedItemRetriever] {
         var feedRetrievers: [FeedItemRetriever] = [];
         if let feeds: [Feed] = Feed.mr_findAll() as? [Feed] {
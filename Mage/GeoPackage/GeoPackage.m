@@ -11,6 +11,7 @@
 #import "GeoPackageCacheOverlay.h"
 #import "GeoPackageTileTableCacheOverlay.h"
 #import "GeoPackageFeatureTableCacheOverlay.h"
+#import "GeoPackageFeatureTableRelations.h"
 #import "CacheOverlayUpdate.h"
 @import Projections;
 #import "XYZDirectoryCacheOverlay.h"
@@ -25,7 +26,9 @@
 @property (nonatomic, strong) GPKGGeoPackageCache *geoPackageCache;
 @property (nonatomic, strong) GPKGGeoPackageManager * geoPackageManager;
 @property (nonatomic, strong) NSMutableDictionary<NSString *, CacheOverlay *> *mapCacheOverlays;
+@property (nonatomic, strong) NSMutableDictionary<NSString *, GeoPackageFeatureTableRelations *> *featureTableRelations;
 @property (nonatomic, strong) GPKGBoundingBox * addedCacheBoundingBox;
+@property (nonatomic, strong) NSArray<NSString *> *orderedCacheNames;
 
 @end
 
@@ -37,6 +40,7 @@
     self.geoPackageManager = [GPKGGeoPackageFactory manager];
     self.geoPackageCache = [[GPKGGeoPackageCache alloc]initWithManager:self.geoPackageManager];
     self.cacheOverlayUpdateLock = [[NSObject alloc] init];
+    self.featureTableRelations = [[NSMutableDictionary alloc] init];
 
     if (!self.mapCacheOverlays) {
         self.mapCacheOverlays = [[NSMutableDictionary alloc] init];
@@ -51,7 +55,8 @@
             if ([cacheOverlay isKindOfClass:[GeoPackageFeatureTableCacheOverlay class]]) {
                 GeoPackageFeatureTableCacheOverlay *featureOverlay = (GeoPackageFeatureTableCacheOverlay *)cacheOverlay;
                 
-                NSArray <GeoPackageFeatureItem *> *items = [featureOverlay getFeaturesNearTap:tapCoord andMap:self.mapView];
+                GeoPackageFeatureTableRelations *relations = [self relationsForCacheName:[featureOverlay getCacheName]];
+                NSArray <GeoPackageFeatureItem *> *items = [featureOverlay getFeaturesNearTap:tapCoord andMap:self.mapView andRelations:relations];
                 [array addObjectsFromArray:items];
             }
         }
@@ -59,6 +64,45 @@
     return array;
 }
 
+-(GeoPackageFeatureTableRelations *) relationsForCacheName: (NSString *) cacheName{
+    @synchronized(self.featureTableRelations){
+        return [self.featureTableRelations objectForKey:cacheName];
+    }
+}
+
+/**
+ *  Look up the related tables of an enabled feature table once, using the GeoPackage kept open while it is enabled
+ *
+ *  @param featureTableCacheOverlay feature table cache overlay
+ *  @param geoPackage               open GeoPackage
+ */
+-(void) openRelationsForFeatureCacheOverlay: (GeoPackageFeatureTableCacheOverlay *) featureTableCacheOverlay andGeoPackage: (GPKGGeoPackage *) geoPackage{
+    NSString * cacheName = [featureTableCacheOverlay getCacheName];
+    GeoPackageFeatureTableRelations *relations = [self relationsForCacheName:cacheName];
+    if(relations != nil && relations.geoPackage == geoPackage){
+        return;
+    }
+    relations = [[GeoPackageFeatureTableRelations alloc] initWithGeoPackage:geoPackage andTableName:[featureTableCacheOverlay getName]];
+    @synchronized(self.featureTableRelations){
+        [self.featureTableRelations setObject:relations forKey:cacheName];
+    }
+}
+
+/**
+ *  Drop the related tables of feature tables that are no longer enabled
+ *
+ *  @param enabledCacheOverlays enabled cache overlays
+ */
+-(void) closeRelationsRetain: (NSDictionary<NSString *, CacheOverlay *> *) enabledCacheOverlays{
+    @synchronized(self.featureTableRelations){
+        for(NSString * cacheName in [self.featureTableRelations allKeys]){
+            if([enabledCacheOverlays objectForKey:cacheName] == nil){
+                [self.featureTableRelations removeObjectForKey:cacheName];
+            }
+        }
+    }
+}
+
 /**
  *  Synchronously update the cache overlays, including overlays and features
  *
@@ -91,7 +135,7 @@
                 CacheOverlayUpdate * overlaysToUpdate = [self getNextCacheOverlaysToUpdate];
                 while(overlaysToUpdate != nil){
                     // Update the cache overlays
-                    [self updateCacheOverlays:cacheOverlays];
+                    [self updateCacheOverlays:overlaysToUpdate.updateCacheOverlays];
                     overlaysToUpdate = [self getNextCacheOverlaysToUpdate];
                 }
                 
@@ -124,11 +168,95 @@
 }
 
 /**
- *  Update all cache overlays by adding and removing overlays and features
+ *  Cache names of the enabled overlays in the order they are layered on the map, linked tile tables follow their feature table
+ *
+ *  @param cacheOverlays cache overlays
+ *
+ *  @return cache names
+ */
+-(NSArray<NSString *> *) orderedCacheNames: (NSArray<CacheOverlay *> *) cacheOverlays{
+    NSMutableArray<NSString *> *cacheNames = [[NSMutableArray alloc] init];
+    for (CacheOverlay *cacheOverlay in cacheOverlays) {
+        if(!cacheOverlay.enabled){
+            continue;
+        }
+        if([cacheOverlay getType] != GEOPACKAGE){
+            [cacheNames addObject:[cacheOverlay getCacheName]];
+            continue;
+        }
+        for(CacheOverlay * tableCacheOverlay in [cacheOverlay getChildren]){
+            if(!tableCacheOverlay.enabled){
+                continue;
+            }
+            [cacheNames addObject:[tableCacheOverlay getCacheName]];
+            if([tableCacheOverlay getType] == GEOPACKAGE_FEATURE_TABLE){
+                for(GeoPackageTileTableCacheOverlay * linkedTileTable in [(GeoPackageFeatureTableCacheOverlay *)tableCacheOverlay getLinkedTileTables]){
+                    [cacheNames addObject:[linkedTileTable getCacheName]];
+                }
+            }
+        }
+    }
+    return cacheNames;
+}
+
+-(MKTileOverlay *) tileOverlayForCacheName: (NSString *) cacheName inEnabledCacheOverlays: (NSDictionary<NSString *, CacheOverlay *> *) enabledCacheOverlays{
+    CacheOverlay * cacheOverlay = [enabledCacheOverlays objectForKey:cacheName];
+    if(cacheOverlay == nil){
+        cacheOverlay = [self.mapCacheOverlays objectForKey:cacheName];
+    }
+    if([cacheOverlay isKindOfClass:[GeoPackageTableCacheOverlay class]]){
+        return ((GeoPackageTableCacheOverlay *)cacheOverlay).tileOverlay;
+    } else if([cacheOverlay isKindOfClass:[XYZDirectoryCacheOverlay class]]){
+        return ((XYZDirectoryCacheOverlay *)cacheOverlay).tileOverlay;
+    }
+    return nil;
+}
+
+/**
+ *  Add a tile overlay for a newly enabled cache overlay below the overlays that follow it, so the
+ *  overlays already on the map keep their place and do not need to be removed and added again
+ *
+ *  @param tileOverlay          tile overlay
+ *  @param level                overlay level
+ *  @param cacheName            cache name of the overlay being added
+ *  @param enabledCacheOverlays enabled cache overlays
+ */
+-(void) addTileOverlay: (MKTileOverlay *) tileOverlay level: (MKOverlayLevel) level forCacheName: (NSString *) cacheName andEnabledCacheOverlays: (NSDictionary<NSString *, CacheOverlay *> *) enabledCacheOverlays{
+    NSMutableArray<MKTileOverlay *> *followingOverlays = [[NSMutableArray alloc] init];
+    NSUInteger index = [self.orderedCacheNames indexOfObject:cacheName];
+    if(index != NSNotFound){
+        for(NSUInteger i = index + 1; i < self.orderedCacheNames.count; i++){
+            MKTileOverlay *followingOverlay = [self tileOverlayForCacheName:[self.orderedCacheNames objectAtIndex:i] inEnabledCacheOverlays:enabledCacheOverlays];
+            if(followingOverlay != nil){
+                [followingOverlays addObject:followingOverlay];
+            }
+        }
+    }
+    dispatch_sync(dispatch_get_main_queue(), ^{
+        if (self.mapView == nil) {
+            return;
+        }
+        NSArray<id<MKOverlay>> *levelOverlays = [self.mapView overlaysInLevel:level];
+        for(MKTileOverlay *followingOverlay in followingOverlays){
+            if([levelOverlays containsObject:followingOverlay]){
+                [self.mapView insertOverlay:tileOverlay belowOverlay:followingOverlay];
+                return;
+            }
+        }
+        [self.mapView addOverlay:tileOverlay level:level];
+    });
+}
+
+/**
+ *  Update all cache overlays by adding and removing overlays and features.  Overlays already on the map
+ *  which are still enabled are left alone, only newly enabled overlays are added and disabled ones removed.
  *
  *  @param cacheOverlays cache overlays
  */
 - (void) updateCacheOverlays:(NSArray<CacheOverlay *> *) cacheOverlays {
+    NSDate *start = [NSDate date];
+    NSUInteger existingCount = self.mapCacheOverlays.count;
+    self.orderedCacheNames = [self orderedCacheNames:cacheOverlays];
     
     // Track enabled cache overlays
     NSMutableDictionary<NSString *, CacheOverlay *> *enabledCacheOverlays = [[NSMutableDictionary alloc] init];
@@ -176,14 +304,20 @@
     }
     
     // Remove any overlays that are on the map but no longer selected
-    for(CacheOverlay * cacheOverlay in [self.mapCacheOverlays allValues]){
+    NSArray<CacheOverlay *> *removedCacheOverlays = [self.mapCacheOverlays allValues];
+    if(removedCacheOverlays.count > 0){
         dispatch_sync(dispatch_get_main_queue(), ^{
-            [cacheOverlay removeFromMap:self.mapView];
+            for(CacheOverlay * cacheOverlay in removedCacheOverlays){
+                [cacheOverlay removeFromMap:self.mapView];
+            }
         });
     }
+    NSInteger keptCount = existingCount - removedCacheOverlays.count;
     self.mapCacheOverlays = enabledCacheOverlays;
+    NSLog(@"TIMING Updated cache overlays, kept %ld, added %ld, removed %lu. Elapsed: %f seconds", (long)keptCount, (long)MAX((NSInteger)enabledCacheOverlays.count - keptCount, 0), (unsigned long)removedCacheOverlays.count, -[start timeIntervalSinceNow]);
     
     // Close GeoPackages no longer enabled
+    [self closeRelationsRetain:enabledCacheOverlays];
     [self.geoPackageCache closeRetain:[enabledGeoPackages allObjects]];
     
     // If a new cache was added, zoom to the bounding box area
@@ -270,16 +404,9 @@
     @try {
         if(cacheOverlay != nil){
             [self.mapCacheOverlays removeObjectForKey:cacheName];
-            // If the existing cache overlay is being replaced, create a new cache overlay
+            // If the existing cache overlay is being replaced, create a new cache overlay, otherwise it stays on the map as is
             if(tileTableCacheOverlay.parent.replacedCacheOverlay != nil){
                 cacheOverlay = nil;
-            } else {
-                // remove the old one and it will be re-added to preserve layer order
-                if ([tileTableCacheOverlay.tileOverlay isKindOfClass:[GPKGBoundedOverlay class]]){
-                    [((GPKGBoundedOverlay *)tileTableCacheOverlay.tileOverlay) close];
-                }
-                [self.mapView removeOverlay:tileTableCacheOverlay.tileOverlay];
-                cacheOverlay = nil;
             }
         }
         if(cacheOverlay == nil){
@@ -309,15 +436,8 @@
                 GPKGFeatureOverlayQuery * featureOverlayQuery = [[GPKGFeatureOverlayQuery alloc] initWithBoundedOverlay:geoPackageTileOverlay andFeatureTiles:featureTiles];
                 [tileTableCacheOverlay.featureOverlayQueries addObject:featureOverlayQuery];
             }
-        
-                    dispatch_sync(dispatch_get_main_queue(), ^{
-                        if (self.mapView != nil) {
-                            [self.mapView addOverlay:geoPackageTileOverlay level:(linkedToFeatures ? MKOverlayLevelAboveLabels: MKOverlayLevelAboveRoads)];
-                        }
-                    });
-        
             
-
+            [self addTileOverlay:geoPackageTileOverlay level:(linkedToFeatures ? MKOverlayLevelAboveLabels: MKOverlayLevelAboveRoads) forCacheName:cacheName andEnabledCacheOverlays:enabledCacheOverlays];
             
             cacheOverlay = tileTableCacheOverlay;
         }
@@ -370,10 +490,6 @@
                     }
                     [self.mapCacheOverlays removeObjectForKey:[linkedTileTable getCacheName]];
                 }
-            } else if ([featureTableCacheOverlay tileOverlay] != nil) {
-                dispatch_sync(dispatch_get_main_queue(), ^{
-                    [self.mapView addOverlay:[featureTableCacheOverlay tileOverlay] level:MKOverlayLevelAboveLabels];
-                });
             }
         }
         if(cacheOverlay == nil){
@@ -399,7 +515,9 @@
                 [featureTiles setIndexManager:[[GPKGFeatureIndexManager alloc] initWithGeoPackage:geoPackage andFeatureDao:featureDao]];
                 // Adjust the feature tiles draw paint attributes here as needed to change how
                 // features are drawn on tiles
-                featureOverlay = [[GPKGFeatureOverlay alloc] initWithFeatureTiles:featureTiles];
+                CachedFeatureOverlay * cachedFeatureOverlay = [[CachedFeatureOverlay alloc] initWithFeatureTiles:featureTiles];
+                cachedFeatureOverlay.tileCache = [[FeatureTileCache alloc] initWithGeoPackagePath:geoPackage.path geoPackageName:geoPackage.name table:featureDao.tableName style:[NSString stringWithFormat:@"max%ld", (long)maxFeaturesPerTile] theme:nil];
+                featureOverlay = cachedFeatureOverlay;
                 [featureOverlay setMinZoom:[NSNumber numberWithInt:[featureTableCacheOverlay getMinZoom]]];
 
                 GPKGFeatureTileTableLinker * linker = [[GPKGFeatureTileTableLinker alloc] initWithGeoPackage:geoPackage];
@@ -413,9 +531,7 @@
                 [featureOverlay setMinZoom:[NSNumber numberWithInt:0]];
                 [featureOverlay setMaxZoom:[NSNumber numberWithInt:21]];
                 
-                dispatch_sync(dispatch_get_main_queue(), ^{
-                    [self.mapView addOverlay:featureOverlay level:MKOverlayLevelAboveLabels];
-                });
+                [self addTileOverlay:featureOverlay level:MKOverlayLevelAboveLabels forCacheName:cacheName andEnabledCacheOverlays:enabledCacheOverlays];
                 cacheOverlay = featureTableCacheOverlay;
             }
             // Not indexed, add the features to the map
@@ -485,6 +601,7 @@
         if(addAsEnabled){
             // Add the cache overlay to the enabled cache overlays
             [enabledCacheOverlays setObject:cacheOverlay forKey:cacheName];
+            [self openRelationsForFeatureCacheOverlay:featureTableCacheOverlay andGeoPackage:geoPackage];
         }
     }
     @catch (NSException *e) {
@@ -533,10 +650,8 @@
         tileOverlay.minimumZ = xyzDirectoryCacheOverlay.minZoom;
         tileOverlay.maximumZ = xyzDirectoryCacheOverlay.maxZoom;
         [xyzDirectoryCacheOverlay setTileOverlay:tileOverlay];
-        dispatch_sync(dispatch_get_main_queue(), ^{
-            NSLog(@"Adding xyz cache");
-            [self.mapView addOverlay:tileOverlay level:MKOverlayLevelAboveRoads];
-        });
+        NSLog(@"Adding xyz cache");
+        [self addTileOverlay:tileOverlay level:MKOverlayLevelAboveRoads forCacheName:cacheName andEnabledCacheOverlays:enabledCacheOverlays];
         
         cacheOverlay = xyzDirectoryCacheOverlay;
     }else{
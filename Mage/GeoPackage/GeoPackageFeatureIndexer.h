@@ -0,0 +1,52 @@
+//
+//  GeoPackageFeatureIndexer.h
+//  MAGE
+//
+//  Copyright © 2026 National Geospatial Intelligence Agency. All rights reserved.
+//
+
+#import <Foundation/Foundation.h>
+
+NS_ASSUME_NONNULL_BEGIN
+
+/**
+ * Indexes the feature tables of imported GeoPackages one GeoPackage at a time on a background queue.
+ * An RTree index is created when possible, otherwise a GeoPackage feature table index.  The index is
+ * stored in the GeoPackage itself so a table is only ever indexed once and is drawn as feature tiles
+ * from then on.  GeoPackageIndexingProgress is posted on the main queue as tables are indexed.
+ */
+@interface GeoPackageFeatureIndexer : NSObject
+
++(GeoPackageFeatureIndexer *) sharedIndexer;
+
+/**
+ *  Index the feature tables of the GeoPackage which are not indexed yet.  Nothing is done if the
+ *  GeoPackage is already waiting to be indexed or failed to index.
+ *
+ *  @param name         GeoPackage name
+ *  @param completion   called on the main queue when at least one table was indexed
+ */
+-(void) indexGeoPackage: (NSString *) name completion: (nullable void (^)(NSString *name)) completion;
+
+/**
+ *  Stop indexing the GeoPackage, the partial index of the table being indexed is removed.  Indexing
+ *  stops between batches of features, wait for the completion before deleting or replacing the file.
+ *
+ *  @param name         GeoPackage name
+ *  @param completion   called on the main queue once the GeoPackage is no longer open for indexing
+ */
+-(void) cancelIndexingGeoPackage: (NSString *) name completion: (nullable void (^)(void)) completion;
+
+/**
+ *  Get the indexing progress of a feature table
+ *
+ *  @param name     GeoPackage name
+ *  @param table    feature table name
+ *
+ *  @return progress from 0 to 1, nil if the table is not being indexed
+ */
+-(nullable NSNumber *) progressForGeoPackage: (NSString *) name andTable: (NSString *) table;
+
+@end
+
+NS_ASSUME_NONNULL_END
@@ -0,0 +1,246 @@
+//
+//  GeoPackageFeatureIndexer.m
+//  MAGE
+//
+//  Copyright © 2026 National Geospatial Intelligence Agency. All rights reserved.
+//
+
+#import "GeoPackageFeatureIndexer.h"
+#import "MageConstants.h"
+#import "CacheOverlay.h"
+@import GeoPackage;
+
+@interface GeoPackageFeatureIndexer ()
+
+@property (nonatomic, strong) NSOperationQueue *queue;
+@property (nonatomic, strong) NSMutableDictionary<NSString *, NSOperation *> *operations;
+@property (nonatomic, strong) NSMutableDictionary<NSString *, NSNumber *> *tableProgress;
+@property (nonatomic, strong) NSMutableSet<NSString *> *failed;
+
+-(void) setProgress: (nullable NSNumber *) progress forGeoPackage: (NSString *) name andTable: (NSString *) table;
+-(void) finishedOperation: (NSOperation *) operation forGeoPackage: (NSString *) name;
+-(void) failedGeoPackage: (NSString *) name;
+
+@end
+
+/**
+ * Indexes the unindexed feature tables of one GeoPackage
+ */
+@interface GeoPackageFeatureIndexOperation : NSOperation <GPKGProgress>
+
+@property (nonatomic, strong) NSString *name;
+@property (nonatomic, weak) GeoPackageFeatureIndexer *indexer;
+@property (nonatomic, copy) void (^indexedCompletion)(NSString *name);
+@property (nonatomic, strong) NSString *table;
+@property (nonatomic) int max;
+@property (nonatomic) int indexedCount;
+@property (nonatomic) int reportedPercent;
+
+@end
+
+@implementation GeoPackageFeatureIndexOperation
+
+-(void) main{
+    NSDate *start = [NSDate date];
+    int indexedTables = 0;
+    BOOL failed = NO;
+    GPKGGeoPackageManager * manager = [GPKGGeoPackageFactory manager];
+    GPKGGeoPackage * geoPackage = nil;
+    @try {
+        geoPackage = [manager open:self.name];
+        for(NSString * featureTable in [geoPackage featureTables]){
+            if(self.isCancelled){
+                break;
+            }
+            GPKGFeatureDao * featureDao = [geoPackage featureDaoWithTableName:featureTable];
+            GPKGFeatureIndexManager * indexer = [[GPKGFeatureIndexManager alloc] initWithGeoPackage:geoPackage andFeatureDao:featureDao];
+            @try {
+                if([indexer isIndexed]){
+                    continue;
+                }
+                self.table = featureTable;
+                self.max = 0;
+                self.indexedCount = 0;
+                self.reportedPercent = -1;
+                [self.indexer setProgress:[NSNumber numberWithDouble:0] forGeoPackage:self.name andTable:featureTable];
+                [indexer setProgress:self];
+                
+                // RTree indexes are built by SQLite and are the fastest to query, fall back to the GeoPackage index extension
+                int count = 0;
+                @try {
+                    count = [indexer indexWithFeatureIndexType:GPKG_FIT_RTREE];
+                }
+                @catch (NSException *e) {
+                    NSLog(@"Failed to create RTree index for %@ %@, using a feature table index. %@", self.name, featureTable, e);
+                    if(!self.isCancelled){
+                        count = [indexer indexWithFeatureIndexType:GPKG_FIT_GEOPACKAGE];
+                    }
+                }
+                if(!self.isCancelled && [indexer isIndexed]){
+                    indexedTables++;
+                    NSLog(@"Indexed %d features of %@ %@", count, self.name, featureTable);
+                } else if(!self.isCancelled){
+                    failed = YES;
+                }
+            }
+            @finally {
+                [indexer close];
+                [self.indexer setProgress:nil forGeoPackage:self.name andTable:featureTable];
+            }
+        }
+    }
+    @catch (NSException *e) {
+        NSLog(@"Failed to index GeoPackage %@ %@", self.name, e);
+        failed = YES;
+    }
+    @finally {
+        [geoPackage close];
+        [manager close];
+    }
+    NSLog(@"TIMING Indexed %d feature tables of %@. Elapsed: %f seconds", indexedTables, self.name, -[start timeIntervalSinceNow]);
+    
+    // do not try again every time the cache overlays are loaded
+    if(failed && !self.isCancelled){
+        [self.indexer failedGeoPackage:self.name];
+    }
+    [self.indexer finishedOperation:self forGeoPackage:self.name];
+    if(indexedTables > 0 && !self.isCancelled && self.indexedCompletion != nil){
+        NSString *name = self.name;
+        void (^indexedCompletion)(NSString *name) = self.indexedCompletion;
+        dispatch_async(dispatch_get_main_queue(), ^{
+            indexedCompletion(name);
+        });
+    }
+}
+
+#pragma mark - GPKGProgress
+
+-(void) setMax: (int) max{
+    _max = max;
+}
+
+-(void) addProgress: (int) progress{
+    self.indexedCount += progress;
+    if(self.max <= 0){
+        return;
+    }
+    // only report whole percent changes
+    int percent = MIN(100, (int)(100.0 * self.indexedCount / self.max));
+    if(percent != self.reportedPercent){
+        self.reportedPercent = percent;
+        [self.indexer setProgress:[NSNumber numberWithDouble:percent / 100.0] forGeoPackage:self.name andTable:self.table];
+    }
+}
+
+-(BOOL) isActive{
+    return !self.isCancelled;
+}
+
+-(BOOL) cleanupOnCancel{
+    return YES;
+}
+
+-(void) completed{
+}
+
+-(void) failureWithError: (NSString *) error{
+    NSLog(@"Failed to index %@ %@ %@", self.name, self.table, error);
+}
+
+@end
+
+@implementation GeoPackageFeatureIndexer
+
++(GeoPackageFeatureIndexer *) sharedIndexer{
+    static GeoPackageFeatureIndexer *sharedIndexer = nil;
+    static dispatch_once_t onceToken;
+    dispatch_once(&onceToken, ^{
+        sharedIndexer = [[GeoPackageFeatureIndexer alloc] init];
+    });
+    return sharedIndexer;
+}
+
+-(instancetype) init{
+    self = [super init];
+    if(self){
+        self.queue = [[NSOperationQueue alloc] init];
+        self.queue.name = @"GeoPackage feature indexing";
+        self.queue.maxConcurrentOperationCount = 1;
+        self.queue.qualityOfService = NSQualityOfServiceUtility;
+        self.operations = [[NSMutableDictionary alloc] init];
+        self.tableProgress = [[NSMutableDictionary alloc] init];
+        self.failed = [[NSMutableSet alloc] init];
+    }
+    return self;
+}
+
+-(void) indexGeoPackage: (NSString *) name completion: (void (^)(NSString *name)) completion{
+    GeoPackageFeatureIndexOperation *operation = [[GeoPackageFeatureIndexOperation alloc] init];
+    operation.name = name;
+    operation.indexer = self;
+    operation.indexedCompletion = completion;
+    @synchronized (self) {
+        if([self.operations objectForKey:name] != nil || [self.failed containsObject:name]){
+            return;
+        }
+        [self.operations setObject:operation forKey:name];
+    }
+    [self.queue addOperation:operation];
+}
+
+-(void) cancelIndexingGeoPackage: (NSString *) name completion: (void (^)(void)) completion{
+    NSOperation *operation = nil;
+    @synchronized (self) {
+        operation = [self.operations objectForKey:name];
+        [self.operations removeObjectForKey:name];
+    }
+    [operation cancel];
+    
+    // a cancelled operation which has not started never opens the GeoPackage, one which is running still has it open
+    NSBlockOperation *cancelled = [NSBlockOperation blockOperationWithBlock:^{
+        if(completion != nil){
+            completion();
+        }
+    }];
+    if(operation != nil && operation.isExecuting){
+        [cancelled addDependency:operation];
+    }
+    [[NSOperationQueue mainQueue] addOperation:cancelled];
+}
+
+-(NSNumber *) progressForGeoPackage: (NSString *) name andTable: (NSString *) table{
+    @synchronized (self) {
+        return [self.tableProgress objectForKey:[CacheOverlay buildChildCacheNameWithName:name andChildName:table]];
+    }
+}
+
+-(void) setProgress: (NSNumber *) progress forGeoPackage: (NSString *) name andTable: (NSString *) table{
+    @synchronized (self) {
+        NSString *key = [CacheOverlay buildChildCacheNameWithName:name andChildName:table];
+        if(progress == nil){
+            [self.tableProgress removeObjectForKey:key];
+        } else {
+            [self.tableProgress setObject:progress forKey:key];
+        }
+    }
+    dispatch_async(dispatch_get_main_queue(), ^{
+        [[NSNotificationCenter defaultCenter] postNotificationName:GeoPackageIndexingProgress object:nil userInfo:@{@"geoPackage": name, @"table": table}];
+    });
+}
+
+-(void) finishedOperation: (NSOperation *) operation forGeoPackage: (NSString *) name{
+    @synchronized (self) {
+        // the GeoPackage may have been cancelled and queued again
+        if([self.operations objectForKey:name] == operation){
+            [self.operations removeObjectForKey:name];
+        }
+    }
+}
+
+-(void) failedGeoPackage: (NSString *) name{
+    @synchronized (self) {
+        [self.failed addObject:name];
+    }
+}
+
+@end
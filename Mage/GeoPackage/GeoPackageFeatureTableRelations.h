@@ -0,0 +1,93 @@
+//
+//  GeoPackageFeatureTableRelations.h
+//  MAGE
+//
+//  Copyright © 2026 National Geospatial Intelligence Agency. All rights reserved.
+//
+
+#import <Foundation/Foundation.h>
+@import GeoPackage;
+
+NS_ASSUME_NONNULL_BEGIN
+
+/**
+ * The related tables of a GeoPackage feature table and the DAOs used to read them, looked up once
+ * when the feature table is enabled on the map rather than on every map tap
+ */
+@interface GeoPackageFeatureTableRelations : NSObject
+
+/**
+ *  Open GeoPackage the feature table is in
+ */
+@property (nonatomic, strong, readonly) GPKGGeoPackage *geoPackage;
+
+/**
+ *  Feature table name
+ */
+@property (nonatomic, strong, readonly) NSString *tableName;
+
+/**
+ *  Media tables related to the feature table
+ */
+@property (nonatomic, strong, readonly) NSArray<GPKGExtendedRelation *> *mediaRelations;
+
+/**
+ *  Attributes and simple attributes tables related to the feature table
+ */
+@property (nonatomic, strong, readonly) NSArray<GPKGExtendedRelation *> *attributesRelations;
+
+/**
+ *  Data columns DAO, nil when the GeoPackage has no data columns table
+ */
+@property (nonatomic, strong, readonly, nullable) GPKGDataColumnsDao *dataColumnsDao;
+
+/**
+ *  Initializer
+ *
+ *  @param geoPackage   open GeoPackage
+ *  @param tableName    feature table name
+ *
+ *  @return new instance
+ */
+-(instancetype) initWithGeoPackage: (GPKGGeoPackage *) geoPackage andTableName: (NSString *) tableName;
+
+/**
+ *  Get the ids of the rows related to a base row
+ *
+ *  @param relation relation
+ *  @param baseId   base row id
+ *
+ *  @return related ids
+ */
+-(NSArray<NSNumber *> *) relatedIdsForRelation: (GPKGExtendedRelation *) relation withBaseId: (int) baseId;
+
+/**
+ *  Get the media DAO of a media relation
+ *
+ *  @param relation media relation
+ *
+ *  @return media DAO
+ */
+-(GPKGMediaDao *) mediaDaoForRelation: (GPKGExtendedRelation *) relation;
+
+/**
+ *  Get the attributes DAO of an attributes relation
+ *
+ *  @param relation attributes relation
+ *
+ *  @return attributes DAO
+ */
+-(GPKGAttributesDao *) attributesDaoForRelation: (GPKGExtendedRelation *) relation;
+
+/**
+ *  Get the media tables related to an attributes table
+ *
+ *  @param tableName attributes table name
+ *
+ *  @return media relations
+ */
+-(NSArray<GPKGExtendedRelation *> *) mediaRelationsForAttributesTable: (NSString *) tableName;
+
+@end
+
+NS_ASSUME_NONNULL_END
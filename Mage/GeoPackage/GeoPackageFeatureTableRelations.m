@@ -0,0 +1,115 @@
+//
+//  GeoPackageFeatureTableRelations.m
+//  MAGE
+//
+//  Copyright © 2026 National Geospatial Intelligence Agency. All rights reserved.
+//
+
+#import "GeoPackageFeatureTableRelations.h"
+
+@interface GeoPackageFeatureTableRelations ()
+
+@property (nonatomic, strong) GPKGExtendedRelationsDao *relationsDao;
+@property (nonatomic, strong) GPKGRelatedTablesExtension *relatedTablesExtension;
+@property (nonatomic, strong) NSMutableDictionary<NSString *, GPKGMediaDao *> *mediaDaos;
+@property (nonatomic, strong) NSMutableDictionary<NSString *, GPKGAttributesDao *> *attributesDaos;
+@property (nonatomic, strong) NSMutableDictionary<NSString *, NSArray<GPKGExtendedRelation *> *> *attributesMediaRelations;
+
+@end
+
+@implementation GeoPackageFeatureTableRelations
+
+-(instancetype) initWithGeoPackage: (GPKGGeoPackage *) geoPackage andTableName: (NSString *) tableName{
+    self = [super init];
+    if(self){
+        _geoPackage = geoPackage;
+        _tableName = tableName;
+        self.relationsDao = [GPKGExtendedRelationsDao createWithDatabase:geoPackage.database];
+        self.relatedTablesExtension = [[GPKGRelatedTablesExtension alloc] initWithGeoPackage:geoPackage];
+        self.mediaDaos = [[NSMutableDictionary alloc] init];
+        self.attributesDaos = [[NSMutableDictionary alloc] init];
+        self.attributesMediaRelations = [[NSMutableDictionary alloc] init];
+        
+        GPKGDataColumnsDao * dataColumnsDao = [[GPKGDataColumnsDao alloc] initWithDatabase:geoPackage.database];
+        _dataColumnsDao = [dataColumnsDao tableExists] ? dataColumnsDao : nil;
+        
+        NSMutableArray<GPKGExtendedRelation *> *mediaRelations = [[NSMutableArray alloc] init];
+        NSMutableArray<GPKGExtendedRelation *> *attributesRelations = [[NSMutableArray alloc] init];
+        for(GPKGExtendedRelation *extendedRelation in [self relationsToBaseTable:tableName]){
+            if ([extendedRelation relationType] == [GPKGRelationTypes fromName:GPKG_RT_MEDIA_NAME]){
+                [mediaRelations addObject:extendedRelation];
+            } else if ([extendedRelation relationType] == [GPKGRelationTypes fromName:GPKG_RT_ATTRIBUTES_NAME]) {
+                [attributesRelations addObject:extendedRelation];
+            } else if ([extendedRelation relationType] == [GPKGRelationTypes fromName:GPKG_RT_SIMPLE_ATTRIBUTES_NAME]) {
+                [attributesRelations addObject:extendedRelation];
+            }
+        }
+        _mediaRelations = mediaRelations;
+        _attributesRelations = attributesRelations;
+    }
+    return self;
+}
+
+-(NSArray<GPKGExtendedRelation *> *) relationsToBaseTable: (NSString *) baseTable{
+    NSMutableArray<GPKGExtendedRelation *> *extendedRelations = [[NSMutableArray alloc] init];
+    if ([self.relationsDao tableExists]){
+        GPKGResultSet *relations = [self.relationsDao relationsToBaseTable:baseTable];
+        @try {
+            while([relations moveToNext]){
+                [extendedRelations addObject:[self.relationsDao relation:relations]];
+            }
+        } @finally {
+            [relations close];
+        }
+    }
+    return extendedRelations;
+}
+
+-(NSArray<NSNumber *> *) relatedIdsForRelation: (GPKGExtendedRelation *) relation withBaseId: (int) baseId{
+    return [self.relatedTablesExtension mappingsForTableName:relation.mappingTableName withBaseId:baseId];
+}
+
+-(GPKGMediaDao *) mediaDaoForRelation: (GPKGExtendedRelation *) relation{
+    @synchronized (self) {
+        GPKGMediaDao *mediaDao = [self.mediaDaos objectForKey:relation.relatedTableName];
+        if(mediaDao == nil){
+            mediaDao = [self.relatedTablesExtension mediaDaoForTableName:relation.relatedTableName];
+            if(mediaDao != nil && relation.relatedTableName != nil){
+                [self.mediaDaos setObject:mediaDao forKey:relation.relatedTableName];
+            }
+        }
+        return mediaDao;
+    }
+}
+
+-(GPKGAttributesDao *) attributesDaoForRelation: (GPKGExtendedRelation *) relation{
+    @synchronized (self) {
+        GPKGAttributesDao *attributesDao = [self.attributesDaos objectForKey:relation.relatedTableName];
+        if(attributesDao == nil){
+            attributesDao = [self.geoPackage attributesDaoWithTableName:relation.relatedTableName];
+            if(attributesDao != nil && relation.relatedTableName != nil){
+                [self.attributesDaos setObject:attributesDao forKey:relation.relatedTableName];
+            }
+        }
+        return attributesDao;
+    }
+}
+
+-(NSArray<GPKGExtendedRelation *> *) mediaRelationsForAttributesTable: (NSString *) tableName{
+    @synchronized (self) {
+        NSArray<GPKGExtendedRelation *> *mediaRelations = [self.attributesMediaRelations objectForKey:tableName];
+        if(mediaRelations == nil){
+            NSMutableArray<GPKGExtendedRelation *> *relations = [[NSMutableArray alloc] init];
+            for(GPKGExtendedRelation *extendedRelation in [self relationsToBaseTable:tableName]){
+                if ([extendedRelation relationType] == [GPKGRelationTypes fromName:GPKG_RT_MEDIA_NAME]){
+                    [relations addObject:extendedRelation];
+                }
+            }
+            mediaRelations = relations;
+            [self.attributesMediaRelations setObject:mediaRelations forKey:tableName];
+        }
+        return mediaRelations;
+    }
+}
+
+@end
@@ -8,6 +8,9 @@
 
 #import <Foundation/Foundation.h>
 
+@class GeoPackageCacheOverlay;
+@class GPKGGeoPackageManager;
+
 NS_ASSUME_NONNULL_BEGIN
 
 @interface GeoPackageImporter : NSObject
@@ -16,6 +19,23 @@ NS_ASSUME_NONNULL_BEGIN
 - (void) processOfflineMapArchives;
 -(BOOL) importGeoPackageFileAsLink: (NSString *) path andMove: (BOOL) moveFile withLayerId: (NSString *) remoteId;
 
+/**
+ *  Build the cache overlay of an imported GeoPackage, feature tables which are not indexed are queued for indexing
+ *
+ *  @param manager  GeoPackage manager
+ *  @param name     GeoPackage name
+ *
+ *  @return cache overlay, nil if the GeoPackage has no tables
+ */
+-(nullable GeoPackageCacheOverlay *) getGeoPackageCacheOverlayWithManager: (GPKGGeoPackageManager *) manager andName: (NSString *) name;
+
+/**
+ *  Replace the cache overlay of a GeoPackage after its feature tables were indexed, keeping the enabled tables
+ *
+ *  @param name GeoPackage name
+ */
+-(void) replaceGeoPackageCacheOverlay: (NSString *) name;
+
 @end
 
 NS_ASSUME_NONNULL_END
@@ -14,6 +14,7 @@
 #import "GeoPackageTableCacheOverlay.h"
 #import "GeoPackageTileTableCacheOverlay.h"
 #import "GeoPackageFeatureTableCacheOverlay.h"
+#import "GeoPackageFeatureIndexer.h"
 #import "MageConstants.h"
 #import "XYZDirectoryCacheOverlay.h"
 #import <SSZipArchive/SSZipArchive.h>
@@ -81,20 +82,7 @@
         imported = [manager importGeoPackageFromPath:path withName:name andOverride:overwrite andMove:true];
         NSLog(@"Imported local Geopackage %d", imported);
         if (imported && !alreadyImported) {
-            // index any feature tables that were not indexed already
-            GPKGGeoPackage *geoPackage = [manager open:name];
-            NSArray * featureTables = [geoPackage featureTables];
-            for(NSString * featureTable in featureTables){
-                
-                GPKGFeatureDao * featureDao = [geoPackage featureDaoWithTableName:featureTable];
-                GPKGFeatureTableIndex * featureTableIndex = [[GPKGFeatureTableIndex alloc] initWithGeoPackage:geoPackage andFeatureDao:featureDao];
-                if(![featureTableIndex isIndexed]){
-                    NSLog(@"Indexing the feature table %@", featureTable);
-                    [featureTableIndex index];
-                    NSLog(@"done indexing the feature table %@", featureTable);
-                }
-            }
-            
+            // feature tables that are not indexed are indexed in the background when the cache overlay is created
             [MagicalRecord saveWithBlock:^(NSManagedObjectContext *localContext) {
                 Layer *l = [Layer MR_createEntityInContext:localContext];
                 l.name = name;
@@ -182,6 +170,7 @@
     
     // Add the GeoPackage overlay
     GPKGGeoPackage * geoPackage = [manager open:name];
+    BOOL needsIndexing = NO;
     @try {
         NSMutableArray<GeoPackageTableCacheOverlay *> * tables = [[NSMutableArray alloc] init];
         
@@ -213,6 +202,10 @@
             enum SFGeometryType geometryType = [featureDao geometryType];
             GPKGFeatureIndexManager * indexer = [[GPKGFeatureIndexManager alloc] initWithGeoPackage:geoPackage andFeatureDao:featureDao];
             BOOL indexed = [indexer isIndexed];
+            [indexer close];
+            if(!indexed){
+                needsIndexing = YES;
+            }
             int minZoom = 0;
             if(indexed){
                 minZoom = [featureDao zoomLevel] + (int)[defaults integerForKey:@"geopackage_feature_tiles_min_zoom_offset"];
@@ -262,9 +255,51 @@
         [geoPackage close];
     }
     
+    // Unindexed feature tables are drawn one shape at a time until they are indexed
+    if(needsIndexing && cacheOverlay != nil){
+        __weak typeof(self) weakSelf = self;
+        [[GeoPackageFeatureIndexer sharedIndexer] indexGeoPackage:name completion:^(NSString *name) {
+            [weakSelf replaceGeoPackageCacheOverlay:name];
+        }];
+    }
+    
     return cacheOverlay;
 }
 
+-(void) replaceGeoPackageCacheOverlay: (NSString *) name{
+    CacheOverlays * cacheOverlays = [CacheOverlays getInstance];
+    CacheOverlay * existingOverlay = [cacheOverlays getByCacheName:name];
+    if(existingOverlay == nil){
+        // the GeoPackage was deleted
+        return;
+    }
+    
+    GPKGGeoPackageManager * manager = [GPKGGeoPackageFactory manager];
+    GeoPackageCacheOverlay * cacheOverlay = nil;
+    @try {
+        cacheOverlay = [self getGeoPackageCacheOverlayWithManager:manager andName:name];
+    }
+    @finally {
+        [manager close];
+    }
+    if(cacheOverlay == nil){
+        return;
+    }
+    
+    // Keep the tables that were enabled
+    NSMutableSet<NSString *> * enabledTables = [[NSMutableSet alloc] init];
+    for(CacheOverlay * childCache in [existingOverlay getChildren]){
+        if(childCache.enabled){
+            [enabledTables addObject:[childCache getCacheName]];
+        }
+    }
+    for(CacheOverlay * childCache in [cacheOverlay getChildren]){
+        [childCache setEnabled:[enabledTables containsObject:[childCache getCacheName]]];
+    }
+    [cacheOverlay setReplacedCacheOverlay:existingOverlay.replacedCacheOverlay != nil ? existingOverlay.replacedCacheOverlay : existingOverlay];
+    [cacheOverlays addCacheOverlay:cacheOverlay];
+}
+
 - (void) removeOutdatedOfflineMapArchives {
     [MagicalRecord saveWithBlock:^(NSManagedObjectContext * _Nonnull localContext) {
         NSArray * layers = [Layer MR_findAllWithPredicate:[NSPredicate predicateWithFormat:@"eventId == -1 AND (type == %@ OR type == %@)", [Server currentEventId], @"GeoPackage", @"Local_XYZ"] inContext:localContext];
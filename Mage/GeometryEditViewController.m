@@ -120,6 +120,16 @@ static NSString *garsTitle = @"GARS";
 - (void)traitCollectionDidChange:(UITraitCollection *)previousTraitCollection {
     // this will force the offline map to update
     [self setupMapType:[NSUserDefaults standardUserDefaults]];
+    
+    // grid tiles are drawn for the interface style
+    if (self.tileOverlay != nil && [self.traitCollection hasDifferentColorAppearanceComparedToTraitCollection:previousTraitCollection]) {
+        MKTileOverlay *tileOverlay = [self coordinateTileOverlay:self.currentCoordinateSystem];
+        [self.map removeOverlay:self.tileOverlay];
+        self.tileOverlay = tileOverlay;
+        if (tileOverlay != nil) {
+            [self.map addOverlay:tileOverlay];
+        }
+    }
 }
 
 - (void) addLeadingIconConstraints: (UIImageView *) leadingIcon {
@@ -556,9 +566,9 @@ static NSString *garsTitle = @"GARS";
 -(MKTileOverlay *) coordinateTileOverlay: (NSString *) coordinateSystem {
     MKTileOverlay *tileOverlay = nil;
     if ([coordinateSystem isEqualToString:mgrsTitle]) {
-        tileOverlay = (MKTileOverlay *) [GridSystems mgrsTileOverlay];
+        tileOverlay = [GridSystems mgrsTileOverlayWithUserInterfaceStyle:self.traitCollection.userInterfaceStyle];
     } else if ([coordinateSystem isEqualToString:garsTitle]) {
-        tileOverlay = (MKTileOverlay *) [GridSystems garsTileOverlay];
+        tileOverlay = [GridSystems garsTileOverlayWithUserInterfaceStyle:self.traitCollection.userInterfaceStyle];
     }
     return tileOverlay;
 }
@@ -7,6 +7,7 @@
 //
 
 import Foundation
+import MapKit
 
 import GARS
 import MGRS
@@ -16,16 +17,28 @@ import MGRS
  */
 @objc public class GridSystems : NSObject {
 
-    @objc public static func garsTileOverlay() -> GARSTileOverlay {
+    /// Change when the grids are customized so tiles cached on disk are drawn again
+    static let gridStyleVersion = "1"
+
+    // one grid overlay of each type so the grid lines and labels are shared by every map showing the grid
+    private static let garsGridOverlay: GARSTileOverlay = {
         let tileOverlay = GARSTileOverlay()
         // Customize GARS grid as needed here
         return tileOverlay
-    }
+    }()
 
-    @objc public static func mgrsTileOverlay() -> MGRSTileOverlay {
+    private static let mgrsGridOverlay: MGRSTileOverlay = {
         let tileOverlay = MGRSTileOverlay()
         // Customize MGRS grid as needed here
         return tileOverlay
+    }()
+
+    @objc public static func garsTileOverlay(userInterfaceStyle: UIUserInterfaceStyle) -> MKTileOverlay {
+        return CachedGridTileOverlay(gridOverlay: garsGridOverlay, gridType: "gars", version: gridStyleVersion, userInterfaceStyle: userInterfaceStyle)
+    }
+
+    @objc public static func mgrsTileOverlay(userInterfaceStyle: UIUserInterfaceStyle) -> MKTileOverlay {
+        return CachedGridTileOverlay(gridOverlay: mgrsGridOverlay, gridType: "mgrs", version: gridStyleVersion, userInterfaceStyle: userInterfaceStyle)
     }
 
     @objc public static func gars(_ coordinate: CLLocationCoordinate2D) -> String {
@@ -13,14 +13,40 @@ import Kingfisher
     @objc public static let shared = ImageCacheProvider()
     public var accessTokenModifier: AnyModifier!
     
+    private let tokenLock = NSLock()
+    private var token: String?
+    // a missing token is remembered too until it changes
+    private var tokenLoaded = false
+    
     private override init() {
         super.init()
         
-        self.accessTokenModifier = AnyModifier { request in
+        self.accessTokenModifier = AnyModifier { [weak self] request in
             var r = request
-            r.setValue("Bearer \(StoredPassword.retrieveStoredToken() ?? "")", forHTTPHeaderField: "Authorization")
+            r.setValue("Bearer \(self?.accessToken ?? "")", forHTTPHeaderField: "Authorization")
             return r
         }
+        NotificationCenter.default.addObserver(forName: .StoredPasswordTokenChanged, object: nil, queue: nil) { [weak self] _ in
+            self?.clearAccessToken()
+        }
+    }
+    
+    /// The stored token, read from the keychain once rather than for every image request
+    var accessToken: String? {
+        tokenLock.lock()
+        defer { tokenLock.unlock() }
+        if !tokenLoaded {
+            token = StoredPassword.retrieveStoredToken()
+            tokenLoaded = true
+        }
+        return token
+    }
+    
+    func clearAccessToken() {
+        tokenLock.lock()
+        token = nil
+        tokenLoaded = false
+        tokenLock.unlock()
     }
     
     @objc public func isCached(url: URL) -> Bool {
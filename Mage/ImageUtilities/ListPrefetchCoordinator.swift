@@ -0,0 +1,150 @@
+//
+//  ListPrefetchCoordinator.swift
+//  MAGE
+//
+//  Copyright © 2026 National Geospatial Intelligence Agency. All rights reserved.
+//
+
+import Foundation
+import CoreData
+import Kingfisher
+
+/// Prefetches the images of the rows a table view is about to show, keyed by the object of each row
+/// so rows moving around do not cancel the wrong work.  Data stores request the rows from their
+/// prefetch data source, hand over the images once they know them and cancel rows which are no
+/// longer coming up or have scrolled past.  When the network policy does not allow downloads only
+/// images already on disk are loaded into memory.  Each row loads one image at a time and at most
+/// maxConcurrentDownloads rows load at once, the others wait for a slot in the order they were
+/// handed over.  Call everything on the main thread.
+class ListPrefetchCoordinator {
+
+    static let maxConcurrentDownloads = 4
+
+    private var requested: Set<NSManagedObjectID> = []
+    private var prefetchers: [NSManagedObjectID: (token: Int, prefetcher: ImagePrefetcher)] = [:]
+    // rows handed over while every slot was taken, oldest first
+    private var waiting: [NSManagedObjectID] = []
+    // tokens of the prefetchers holding a slot
+    private var running: Set<Int> = []
+    private var nextToken = 0
+
+    /// The key attachment thumbnails are cached under by AttachmentUIImageView, nil when any size of the image is already cached
+    static func thumbnailResource(attachmentUrl: String, size: Int) -> Resource? {
+        let cache = ImageCache.default
+        let thumbnailKey = "\(attachmentUrl)_thumbnail"
+        if cache.isCached(forKey: thumbnailKey) || cache.isCached(forKey: "\(attachmentUrl)_large") || cache.isCached(forKey: attachmentUrl) {
+            return nil
+        }
+        guard let downloadURL = URL(string: "\(attachmentUrl)?size=\(size)") else {
+            return nil
+        }
+        return KF.ImageResource(downloadURL: downloadURL, cacheKey: thumbnailKey)
+    }
+
+    /// Avatars are cached under their url by UserAvatarUIImageView
+    static func avatarResource(user: User?) -> Resource? {
+        guard let cacheAvatarUrl = user?.cacheAvatarUrl, let url = URL(string: cacheAvatarUrl) else {
+            return nil
+        }
+        return KF.ImageResource(downloadURL: url)
+    }
+
+    /// The rows are coming up, their images are prefetched once they are handed to prefetch
+    func request(objectIDs: [NSManagedObjectID]) {
+        requested.formUnion(objectIDs)
+    }
+
+    func isRequested(_ objectID: NSManagedObjectID) -> Bool {
+        return requested.contains(objectID)
+    }
+
+    func isPrefetching(_ objectID: NSManagedObjectID) -> Bool {
+        return prefetchers[objectID] != nil
+    }
+
+    /// The row is prefetching but waits for one of the shared download slots
+    func isWaiting(_ objectID: NSManagedObjectID) -> Bool {
+        return waiting.contains(objectID)
+    }
+
+    /// Start loading the images of a requested row which are not in memory yet
+    func prefetch(objectID: NSManagedObjectID, resources: [Resource], allowDownloads: Bool) {
+        guard requested.contains(objectID), prefetchers[objectID] == nil else {
+            return
+        }
+        let cache = ImageCache.default
+        let needed = resources.filter { resource in
+            let cacheType = cache.imageCachedType(forKey: resource.cacheKey)
+            return allowDownloads ? cacheType != .memory : cacheType == .disk
+        }
+        guard !needed.isEmpty else {
+            return
+        }
+        var options: KingfisherOptionsInfo = [
+            .requestModifier(ImageCacheProvider.shared.accessTokenModifier),
+            .scaleFactor(UIScreen.main.scale),
+            .cacheOriginalImage,
+            .backgroundDecode
+        ]
+        if !allowDownloads {
+            options.append(.onlyFromCache)
+        }
+        nextToken += 1
+        let token = nextToken
+        let prefetcher = ImagePrefetcher(resources: needed, options: options) { [weak self] _, _, _ in
+            self?.finished(objectID: objectID, token: token)
+        }
+        prefetcher.maxConcurrentDownloads = 1
+        prefetchers[objectID] = (token: token, prefetcher: prefetcher)
+        waiting.append(objectID)
+        startWaiting()
+    }
+
+    func cancel(objectIDs: [NSManagedObjectID]) {
+        for objectID in objectIDs {
+            requested.remove(objectID)
+            stop(objectID: objectID)
+        }
+        startWaiting()
+    }
+
+    func cancelAll() {
+        requested.removeAll()
+        waiting.removeAll()
+        running.removeAll()
+        for entry in prefetchers.values {
+            entry.prefetcher.stop()
+        }
+        prefetchers.removeAll()
+    }
+
+    private func stop(objectID: NSManagedObjectID) {
+        guard let entry = prefetchers.removeValue(forKey: objectID) else {
+            return
+        }
+        waiting.removeAll { $0 == objectID }
+        // the slot is free right away, a stopped prefetcher may still report it finished later
+        running.remove(entry.token)
+        entry.prefetcher.stop()
+    }
+
+    private func finished(objectID: NSManagedObjectID, token: Int) {
+        running.remove(token)
+        // a cancelled prefetcher can finish after the row was requested again
+        if prefetchers[objectID]?.token == token {
+            prefetchers.removeValue(forKey: objectID)
+        }
+        startWaiting()
+    }
+
+    private func startWaiting() {
+        while running.count < ListPrefetchCoordinator.maxConcurrentDownloads, !waiting.isEmpty {
+            let objectID = waiting.removeFirst()
+            guard let entry = prefetchers[objectID] else {
+                continue
+            }
+            running.insert(entry.token)
+            entry.prefetcher.start()
+        }
+    }
+}
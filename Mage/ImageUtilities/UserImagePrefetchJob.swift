@@ -0,0 +1,144 @@
+//
+//  UserImagePrefetchJob.swift
+//  MAGE
+//
+//  Copyright © 2026 National Geospatial Intelligence Agency. All rights reserved.
+//
+
+import Foundation
+import Kingfisher
+
+/// Downloads the icons and avatars of the users saved by one user sync as a single job.  Images already in
+/// the image cache are skipped, at most maxConcurrentDownloads run at once and the job stops once it has
+/// downloaded byteBudget bytes, anything left is loaded when it is shown.  Make the job in the context the
+/// users were saved in and start it on the main thread.
+class UserImagePrefetchJob {
+
+    static let maxConcurrentDownloads = 4
+    static let byteBudget = 20 * 1024 * 1024
+
+    // jobs are kept until they finish
+    private static var running: [ObjectIdentifier: UserImagePrefetchJob] = [:]
+
+    /// Counts the bytes downloaded by every task of the job, called on the download session's queue
+    final class ByteBudget: DataReceivingSideEffect {
+        var onShouldApply: () -> Bool = { true }
+        let limit: Int
+        var onExceeded: (() -> Void)?
+        private let lock = NSLock()
+        private var received = 0
+        private var exceeded = false
+
+        init(limit: Int) {
+            self.limit = limit
+        }
+
+        var receivedBytes: Int {
+            lock.lock()
+            defer { lock.unlock() }
+            return received
+        }
+
+        func onDataReceived(_ session: URLSession, task: SessionDataTask, data: Data) {
+            add(data.count)
+        }
+
+        func add(_ count: Int) {
+            lock.lock()
+            received += count
+            let justExceeded = !exceeded && received >= limit
+            if justExceeded {
+                exceeded = true
+            }
+            lock.unlock()
+            if justExceeded, let onExceeded = onExceeded {
+                DispatchQueue.main.async(execute: onExceeded)
+            }
+        }
+    }
+
+    let icons: [Resource]
+    let avatars: [Resource]
+    let budget: ByteBudget
+    private var prefetcher: ImagePrefetcher?
+    private var finished = false
+    private var completion: (() -> Void)?
+
+    init(users: [User], byteBudget: Int = UserImagePrefetchJob.byteBudget, cache: ImageCache = ImageCache.default) {
+        var keys: Set<String> = []
+        func resource(_ urlString: String?) -> Resource? {
+            guard let urlString = urlString, let url = URL(string: urlString), !keys.contains(urlString), !cache.isCached(forKey: urlString) else {
+                return nil
+            }
+            keys.insert(urlString)
+            return KF.ImageResource(downloadURL: url)
+        }
+        icons = users.compactMap { resource($0.cacheIconUrl) }
+        avatars = users.compactMap { resource($0.cacheAvatarUrl) }
+        budget = ByteBudget(limit: byteBudget)
+    }
+
+    var isEmpty: Bool {
+        return icons.isEmpty && avatars.isEmpty
+    }
+
+    static var runningCount: Int {
+        return running.count
+    }
+
+    func start(completion: (() -> Void)? = nil) {
+        guard !isEmpty else {
+            completion?()
+            return
+        }
+        NSLog("Prefetching \(icons.count) user icons and \(avatars.count) avatars")
+        self.completion = completion
+        UserImagePrefetchJob.running[ObjectIdentifier(self)] = self
+        budget.onExceeded = { [weak self] in
+            NSLog("Stopped prefetching user icons and avatars after \(self?.budget.receivedBytes ?? 0) bytes")
+            self?.finish()
+        }
+        // icons are kept on disk until the user is updated, avatars expire with the rest of the cache
+        run(stages: [(icons, [.diskCacheExpiration(.never)]), (avatars, [])])
+    }
+
+    func stop() {
+        finish()
+    }
+
+    private func run(stages: ArraySlice<(resources: [Resource], options: KingfisherOptionsInfo)>) {
+        guard !finished else {
+            return
+        }
+        guard let stage = stages.first else {
+            finish()
+            return
+        }
+        guard !stage.resources.isEmpty else {
+            run(stages: stages.dropFirst())
+            return
+        }
+        let options: KingfisherOptionsInfo = [
+            .requestModifier(ImageCacheProvider.shared.accessTokenModifier),
+            .onDataReceived([budget])
+        ] + stage.options
+        let prefetcher = ImagePrefetcher(resources: stage.resources, options: options) { [weak self] _, _, _ in
+            self?.run(stages: stages.dropFirst())
+        }
+        prefetcher.maxConcurrentDownloads = UserImagePrefetchJob.maxConcurrentDownloads
+        self.prefetcher = prefetcher
+        prefetcher.start()
+    }
+
+    private func finish() {
+        guard !finished else {
+            return
+        }
+        finished = true
+        prefetcher?.stop()
+        prefetcher = nil
+        UserImagePrefetchJob.running.removeValue(forKey: ObjectIdentifier(self))
+        completion?()
+        completion = nil
+    }
+}
@@ -15,6 +15,10 @@ class LocationDataStore: NSObject {
     var locations: Locations?;
     weak var actionsDelegate: UserActionsDelegate?;
     var emptyView: UIView?
+    let timeWindow = TimeWindowedList(field: "timestamp")
+    var timeFiltered = false
+    var refetchOnChange = false
+    let prefetchCoordinator = ListPrefetchCoordinator()
 
     public init(tableView: UITableView, actionsDelegate: UserActionsDelegate?, emptyView: UIView? = nil, scheme: MDCContainerScheming?) {
         self.scheme = scheme;
@@ -24,6 +28,7 @@ class LocationDataStore: NSObject {
         super.init();
         self.tableView.dataSource = self;
         self.tableView.delegate = self;
+        self.tableView.prefetchDataSource = self;
     }
     
     func applyTheme(withContainerScheme containerScheme: MDCContainerScheming?) {
@@ -36,9 +41,12 @@ class LocationDataStore: NSObject {
         } else {
             self.locations = locations;
         }
+        self.prefetchCoordinator.cancelAll();
+        self.timeFiltered = locations == nil;
         self.locations?.delegate = self;
         do {
             try self.locations?.fetchedResultsController.performFetch()
+            self.timeWindow.reset(windowStart: timeFiltered ? TimeFilter.getLocationTimeFilterStartDate() : nil);
         } catch {
             print("Error fetching locations \(error) \(error.localizedDescription)")
         }
@@ -46,21 +54,37 @@ class LocationDataStore: NSObject {
     }
     
     func updatePredicates() {
+        self.prefetchCoordinator.cancelAll();
         self.locations?.fetchedResultsController.fetchRequest.predicate = NSCompoundPredicate(andPredicateWithSubpredicates: Locations.getPredicatesForLocations() as! [NSPredicate]);
         do {
             try self.locations?.fetchedResultsController.performFetch()
+            self.timeWindow.reset(windowStart: timeFiltered ? TimeFilter.getLocationTimeFilterStartDate() : nil);
         } catch {
             print("Error fetching users \(error) \(error.localizedDescription)")
         }
         self.tableView.reloadData();
     }
+    
+    /// Remove the locations which have aged out of a relative time filter since the last advance without fetching them all again
+    func advanceTimeWindow() {
+        guard timeFiltered, !refetchOnChange else {
+            return;
+        }
+        let changes = timeWindow.advance(to: TimeFilter.getLocationTimeFilterStartDate(), controller: self.locations?.fetchedResultsController);
+        if changes.sections.isEmpty && changes.rows.isEmpty {
+            return;
+        }
+        self.tableView.performBatchUpdates {
+            self.tableView.deleteSections(changes.sections, with: .fade);
+            self.tableView.deleteRows(at: changes.rows, with: .fade);
+        }
+    }
 }
 
 extension LocationDataStore: UITableViewDataSource {
     
     func tableView(_ tableView: UITableView, numberOfRowsInSection section: Int) -> Int {
-        let sectionInfo: NSFetchedResultsSectionInfo? = self.locations?.fetchedResultsController.sections?[section];
-        let number = sectionInfo?.numberOfObjects ?? 0;
+        let number = timeWindow.numberOfRows(inSection: section, controller: self.locations?.fetchedResultsController);
         if number == 0 {
             tableView.backgroundView = emptyView
         } else {
@@ -70,7 +94,7 @@ extension LocationDataStore: UITableViewDataSource {
     }
     
     func numberOfSections(in tableView: UITableView) -> Int {
-        return self.locations?.fetchedResultsController.sections?.count ?? 0;
+        return timeWindow.numberOfSections(controller: self.locations?.fetchedResultsController);
     }
     
     func tableView(_ tableView: UITableView, cellForRowAt indexPath: IndexPath) -> UITableViewCell {
@@ -87,8 +111,45 @@ extension LocationDataStore: UITableViewDataSource {
     }
 }
 
+extension LocationDataStore: UITableViewDataSourcePrefetching {
+    
+    /// The locations of the rows which are still in the list
+    func locations(at indexPaths: [IndexPath]) -> [Location] {
+        guard let controller = self.locations?.fetchedResultsController else {
+            return [];
+        }
+        let numberOfSections = timeWindow.numberOfSections(controller: controller);
+        return indexPaths.compactMap { indexPath in
+            guard indexPath.section < numberOfSections, indexPath.row < timeWindow.numberOfRows(inSection: indexPath.section, controller: controller) else {
+                return nil;
+            }
+            return controller.object(at: indexPath) as? Location;
+        }
+    }
+    
+    func tableView(_ tableView: UITableView, prefetchRowsAt indexPaths: [IndexPath]) {
+        let allowDownloads = DataConnectionUtilities.shouldFetchAvatars();
+        for location in locations(at: indexPaths) {
+            prefetchCoordinator.request(objectIDs: [location.objectID]);
+            if let resource = ListPrefetchCoordinator.avatarResource(user: location.user) {
+                prefetchCoordinator.prefetch(objectID: location.objectID, resources: [resource], allowDownloads: allowDownloads);
+            }
+        }
+    }
+    
+    func tableView(_ tableView: UITableView, cancelPrefetchingForRowsAt indexPaths: [IndexPath]) {
+        prefetchCoordinator.cancel(objectIDs: locations(at: indexPaths).map { $0.objectID });
+    }
+}
+
 extension LocationDataStore: UITableViewDelegate {
     
+    func tableView(_ tableView: UITableView, didEndDisplaying cell: UITableViewCell, forRowAt indexPath: IndexPath) {
+        if let objectID = (cell as? PersonTableViewCell)?.rowObjectID {
+            prefetchCoordinator.cancel(objectIDs: [objectID]);
+        }
+    }
+    
     func tableView(_ tableView: UITableView, heightForFooterInSection section: Int) -> CGFloat {
         return CGFloat.leastNormalMagnitude;
     }
@@ -109,6 +170,9 @@ extension LocationDataStore: UITableViewDelegate {
 extension LocationDataStore: NSFetchedResultsControllerDelegate {
     
     func controller(_ controller: NSFetchedResultsController<NSFetchRequestResult>, didChange anObject: Any, at indexPath: IndexPath?, for type: NSFetchedResultsChangeType, newIndexPath: IndexPath?) {
+        if refetchOnChange {
+            return;
+        }
         switch type {
         case .insert:
             if let insertIndexPath = newIndexPath {
@@ -139,6 +203,9 @@ extension LocationDataStore: NSFetchedResultsControllerDelegate {
     }
     
     func controller(_ controller: NSFetchedResultsController<NSFetchRequestResult>, didChange sectionInfo: NSFetchedResultsSectionInfo, atSectionIndex sectionIndex: Int, for type: NSFetchedResultsChangeType) {
+        if refetchOnChange {
+            return;
+        }
         switch type {
         case .insert:
             self.tableView.insertSections(IndexSet(integer: sectionIndex), with: .fade);
@@ -152,10 +219,25 @@ extension LocationDataStore: NSFetchedResultsControllerDelegate {
     }
     
     func controllerDidChangeContent(_ controller: NSFetchedResultsController<NSFetchRequestResult>) {
+        self.timeWindow.invalidate();
+        if refetchOnChange {
+            // the index paths of the change include rows hidden by the time window, fetch again instead
+            DispatchQueue.main.async { [weak self] in
+                self?.refetchOnChange = false;
+                self?.updatePredicates();
+            }
+            return;
+        }
         self.tableView.endUpdates();
     }
     
     func controllerWillChangeContent(_ controller: NSFetchedResultsController<NSFetchRequestResult>) {
+        if timeWindow.hiddenCount > 0 {
+            refetchOnChange = true;
+        }
+        if refetchOnChange {
+            return;
+        }
         self.tableView.beginUpdates();
     }
 }
@@ -156,7 +156,7 @@ class LocationsTableViewController: UITableViewController {
         }
         self.updateTimer = Timer(timeInterval: 60, target: self, selector: #selector(onUpdateTimerFire), userInfo: nil, repeats: true);
         RunLoop.main.add(self.updateTimer!, forMode: .default);
-        self.locationDataStore.updatePredicates();
+        self.locationDataStore.advanceTimeWindow();
     }
     
     func stopUpdateTimer() {
@@ -166,7 +166,7 @@ class LocationsTableViewController: UITableViewController {
     }
     
     @objc func onUpdateTimerFire() {
-        self.locationDataStore.updatePredicates();
+        self.locationDataStore.advanceTimeWindow();
     }
     
     func setNavBarTitle() {
@@ -86,6 +86,8 @@
 
 - (void) authenticationSuccessful {
     [_childCoordinators removeLastObject];
+    // a different user may have logged in
+    [ObservationCurrentUserFavorite updateInBackground];
     [self startEventChooser];
 }
 
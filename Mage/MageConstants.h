@@ -15,6 +15,7 @@ extern NSString * const MAGE_CACHE_DIRECTORY;
 extern NSString * const MAGE_SELECTED_CACHES;
 extern NSInteger const MAGE_FEATURES_MAX_ZOOM;
 extern NSString * const GeoPackageImported;
+extern NSString * const GeoPackageIndexingProgress;
 
 @interface MageConstants : NSObject
 
@@ -28,11 +28,46 @@ import Foundation
     @objc public static func setupCoreData() {
         MagicalRecord.setupMageCoreDataStack();
         MagicalRecord.setLoggingLevel(.verbose);
+        if PropertiesStorageMigration.isNeeded, let coordinator = NSManagedObjectContext.mr_default().persistentStoreCoordinator {
+            // the properties are rewritten before the history is read, what is saved meanwhile is read once the consumers start
+            let position = PersistentHistoryChangeProcessor.lastTransaction(coordinator: coordinator);
+            DispatchQueue.global(qos: .userInitiated).async {
+                PropertiesStorageMigration.migrateIfNeeded();
+                DispatchQueue.main.async {
+                    startPersistentHistoryConsumers(coordinator: coordinator, after: position);
+                }
+            }
+        } else {
+            startPersistentHistoryConsumers();
+        }
+        DispatchQueue.global(qos: .utility).async {
+            GeometryEnvelopeBackfill.backfillIfNeeded();
+            GeometryStorageMigration.migrateIfNeeded();
+            StaticLayerFeatureMigration.migrateIfNeeded();
+        }
+        ObservationDaySection.updateInBackground();
+        ObservationCurrentUserFavorite.updateInBackground();
+        NotificationCenter.default.addObserver(forName: NSNotification.Name.NSSystemTimeZoneDidChange, object: nil, queue: nil) { _ in
+            ObservationDaySection.updateInBackground();
+        }
     }
 
     @objc public static func clearAndSetupCoreData() {
+        ObservationSearchIndex.shared.delete();
         MagicalRecord.deleteAndSetupMageCoreDataStack();
         MagicalRecord.setLoggingLevel(.verbose);
+        startPersistentHistoryConsumers();
+    }
+    
+    private static func startPersistentHistoryConsumers() {
+        if let coordinator = NSManagedObjectContext.mr_default().persistentStoreCoordinator {
+            startPersistentHistoryConsumers(coordinator: coordinator, after: PersistentHistoryChangeProcessor.lastTransaction(coordinator: coordinator));
+        }
+    }
+
+    private static func startPersistentHistoryConsumers(coordinator: NSPersistentStoreCoordinator, after position: PersistentHistoryPosition?) {
+        PersistentHistoryChangeProcessor.shared.start(coordinator: coordinator, after: position);
+        ObservationSearchIndex.shared.start();
     }
     
     @discardableResult
@@ -71,6 +106,10 @@ import Foundation
         
         localContext.mr_saveToPersistentStoreAndWait();
         
+        // the index of the cleared observations is rebuilt from what is left in the store
+        ObservationSearchIndex.shared.delete();
+        ObservationSearchIndex.shared.start();
+        
         return cleared;
     }
 
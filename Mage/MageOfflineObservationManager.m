@@ -9,9 +9,9 @@
 #import "MageOfflineObservationManager.h"
 #import "MAGE-Swift.h"
 
-@interface MageOfflineObservationManager()<NSFetchedResultsControllerDelegate>
+@interface MageOfflineObservationManager()
 @property (assign, nonatomic) NSInteger offlineObservationCount;
-@property (strong, nonatomic) NSFetchedResultsController *observationFetchedResultsController;
+@property (strong, nonatomic) PersistentHistorySubscription *subscription;
 @end
 
 @implementation MageOfflineObservationManager
@@ -20,13 +20,6 @@
    	if ((self = [super init])) {
         _offlineObservationCount = -1;
         _delegate = delegate;
-        
-        _observationFetchedResultsController = [Observation MR_fetchAllSortedBy:@"timestamp"
-                                                                      ascending:NO
-                                                                  withPredicate:[NSPredicate predicateWithFormat:@"eventId == %@ AND error != nil", [Server currentEventId]]
-                                                                        groupBy:nil
-                                                                       delegate:self
-                                                                      inContext:[NSManagedObjectContext MR_defaultContext]];
     }
     
     return self;
@@ -38,12 +31,13 @@
 }
 
 - (void) start {
-    NSError *error = nil;
-    if (![self.observationFetchedResultsController performFetch:&error]) {
-        NSLog(@"Error starting offline observations FRC %@", error);
-    }
+    [self updateOfflineCount:[Observation MR_countOfEntitiesWithPredicate:[MageOfflineObservationManager currentEventPredicate] inContext:[NSManagedObjectContext MR_defaultContext]]];
     
-    [self updateOfflineCount:[[self.observationFetchedResultsController fetchedObjects] count]];
+    // only a change to the error or the event of an observation can change the count, it is recounted off of the main thread
+    __weak typeof(self) weakSelf = self;
+    self.subscription = [[PersistentHistoryChangeProcessor shared] subscribeWithEntityNames:@[@"Observation"] keys:@[@"error", @"eventId"] queue:dispatch_get_global_queue(QOS_CLASS_UTILITY, 0) handler:^(NSArray<EntityChangeSet *> *changeSets) {
+        [weakSelf recount];
+    }];
     
     [[NSUserDefaults standardUserDefaults] addObserver:self
                                             forKeyPath:@"currentEventId" options:NSKeyValueObservingOptionNew
@@ -52,22 +46,25 @@
 
 - (void) stop {
     self.delegate = nil;
+    [self.subscription cancel];
+    self.subscription = nil;
     [[NSUserDefaults standardUserDefaults] removeObserver:self forKeyPath:@"currentEventId"];
 }
 
-- (void)controller:(NSFetchedResultsController *)controller
-   didChangeObject:(id) anObject
-       atIndexPath:(NSIndexPath *) indexPath
-     forChangeType:(NSFetchedResultsChangeType)type
-      newIndexPath:(NSIndexPath *) newIndexPath {
-    
-    [self updateOfflineCount:[[self.observationFetchedResultsController fetchedObjects] count]];
++ (NSPredicate *) currentEventPredicate {
+    return [NSPredicate predicateWithFormat:@"eventId == %@ AND error != nil", [Server currentEventId]];
+}
+
+- (void) recount {
+    NSInteger count = [[PersistentHistoryChangeProcessor shared] countWithEntityName:@"Observation" matching:[MageOfflineObservationManager currentEventPredicate]];
+    __weak typeof(self) weakSelf = self;
+    dispatch_async(dispatch_get_main_queue(), ^{
+        [weakSelf updateOfflineCount:count];
+    });
 }
 
 -(void) observeValueForKeyPath:(NSString *)keyPath ofObject:(id)object change:(NSDictionary<NSKeyValueChangeKey,id> *)change context:(void *)context {
-    [self.observationFetchedResultsController.fetchRequest setPredicate:[NSPredicate predicateWithFormat:@"eventId == %@ AND error != nil", [Server currentEventId]]];
-    [self.observationFetchedResultsController performFetch:nil];
-    [self updateOfflineCount:[[self.observationFetchedResultsController fetchedObjects] count]];
+    [self updateOfflineCount:[Observation MR_countOfEntitiesWithPredicate:[MageOfflineObservationManager currentEventPredicate] inContext:[NSManagedObjectContext MR_defaultContext]]];
 }
 
 - (void) updateOfflineCount:(NSInteger) count {
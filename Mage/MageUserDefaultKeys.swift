@@ -14,7 +14,9 @@ extension Notification.Name {
     public static let MAGEFormFetched = Notification.Name(Form.MAGEFormFetched)
     public static let GeoPackageDownloaded = Notification.Name(Layer.GeoPackageDownloaded)
     public static let StaticLayerLoaded = Notification.Name(StaticLayer.StaticLayerLoaded)
+    public static let StaticLayerLoadProgress = Notification.Name(StaticLayer.StaticLayerLoadProgress)
     public static let MAGETokenExpiredNotification = Notification.Name("mil.nga.giat.mage.token.expired");
+    public static let StoredPasswordTokenChanged = Notification.Name(StoredPasswordTokenChangedNotification)
     public static let MapItemsTapped = Notification.Name("MapItemsTapped")
     public static let MapAnnotationFocused = Notification.Name("MapAnnotationFocused")
     public static let MapViewDisappearing = Notification.Name("MapViewDisappearing")
@@ -23,6 +25,7 @@ extension Notification.Name {
     public static let DismissBottomSheet = Notification.Name("DismissBottomSheet")
     public static let BottomSheetDismissed = Notification.Name("BottomSheetDismissed")
     public static let GeoPackageImported = Notification.Name("mil.nga.giat.mage.geopackage.imported")
+    public static let GeoPackageIndexingProgress = Notification.Name("mil.nga.giat.mage.geopackage.indexing.progress")
     public static let ObservationFiltersChanged = Notification.Name("ObservationFiltersChanged")
     public static let LocationFiltersChanged = Notification.Name("LocationFiltersChanged")
     public static let ViewObservation = Notification.Name("ViewObservation")
@@ -36,6 +36,10 @@ class MainMageMapView: MageMapView, FilteredObservationsMap, FilteredUsersMap, B
     var viewFeedItemNotificationObserver: Any?
     var startStraightLineNavigationNotificationObserver: Any?
     
+    private lazy var staticLayerLoadProgressView: StaticLayerLoadProgressView = {
+        return StaticLayerLoadProgressView(mapView: mapView, scheme: scheme)
+    }()
+    
     private lazy var buttonStack: UIStackView = {
         let buttonStack = UIStackView.newAutoLayout()
         buttonStack.alignment = .fill
@@ -118,6 +122,7 @@ class MainMageMapView: MageMapView, FilteredObservationsMap, FilteredUsersMap, B
             hasMapSearchMixin = HasMapSearchMixin(hasMapSearch: self, rootView: buttonStack, indexInView: 0, navigationController: self.navigationController, scheme: self.scheme)
             userHeadingDisplayMixin = UserHeadingDisplayMixin(userHeadingDisplay: self, mapStack: mapStack, scheme: scheme)
             staticLayerMapMixin = StaticLayerMapMixin(staticLayerMap: self)
+            mapStack.addArrangedSubview(staticLayerLoadProgressView)
             geoPackageLayerMapMixin = GeoPackageLayerMapMixin(geoPackageLayerMap: self)
             feedsMapMixin = FeedsMapMixin(feedsMap: self)
             onlineLayerMapMixin = OnlineLayerMapMixin(onlineLayerMap: self)
@@ -9,6 +9,7 @@
 #import "GeoPackageTableCacheOverlay.h"
 @import GeoPackage;
 #import "GeoPackageTileTableCacheOverlay.h"
+#import "GeoPackageFeatureTableRelations.h"
 #import "MAGE-Swift.h"
 
 
@@ -94,4 +95,15 @@ extern NSInteger const GEO_PACKAGE_FEATURE_TABLE_MAX_ZOOM;
 -(GPKGFeatureTableData *) getFeatureTableDataWithLocationCoordinate: (CLLocationCoordinate2D) locationCoordinate andMap: (MKMapView *) mapView;
 - (NSArray<GeoPackageFeatureItem *> *) getFeaturesNearTap: (CLLocationCoordinate2D) tapLocation andMap: (MKMapView *) mapView;
 
+/**
+ *  Get the features near a map tap
+ *
+ *  @param tapLocation tap location
+ *  @param mapView     map view
+ *  @param relations   related tables of the open feature table, the GeoPackage is opened for the tap when nil
+ *
+ *  @return feature items
+ */
+- (NSArray<GeoPackageFeatureItem *> *) getFeaturesNearTap: (CLLocationCoordinate2D) tapLocation andMap: (MKMapView *) mapView andRelations: (GeoPackageFeatureTableRelations *) relations;
+
 @end
@@ -7,6 +7,7 @@
 //
 
 #import "GeoPackageFeatureTableCacheOverlay.h"
+#import "GeoPackageFeatureIndexer.h"
 @import GeoPackage;
 
 NSInteger const GEO_PACKAGE_FEATURE_TABLE_MAX_ZOOM = 21;
@@ -55,6 +56,10 @@ NSInteger const GEO_PACKAGE_FEATURE_TABLE_MAX_ZOOM = 21;
         minZoom = MIN(minZoom, [linkedTileTable getMinZoom]);
         maxZoom = MAX(maxZoom, [linkedTileTable getMaxZoom]);
     }
+    NSNumber * indexingProgress = [[GeoPackageFeatureIndexer sharedIndexer] progressForGeoPackage:[self getGeoPackage] andTable:[self getName]];
+    if(indexingProgress != nil){
+        return [NSString stringWithFormat:@"%d feature%@, indexing %d%%", [self getCount], [self getCount] == 1 ? @"" : @"s", (int)([indexingProgress doubleValue] * 100)];
+    }
     return [NSString stringWithFormat:@"%d feature%@, zoom: %d - %d", [self getCount], [self getCount] == 1 ? @"" : @"s", minZoom, maxZoom];
 }
 
@@ -79,6 +84,10 @@ NSInteger const GEO_PACKAGE_FEATURE_TABLE_MAX_ZOOM = 21;
 }
 
 - (NSArray<GeoPackageFeatureItem *> *) getFeaturesNearTap: (CLLocationCoordinate2D) tapLocation andMap: (MKMapView *) mapView {
+    return [self getFeaturesNearTap:tapLocation andMap:mapView andRelations:nil];
+}
+
+- (NSArray<GeoPackageFeatureItem *> *) getFeaturesNearTap: (CLLocationCoordinate2D) tapLocation andMap: (MKMapView *) mapView andRelations: (GeoPackageFeatureTableRelations *) tableRelations {
     NSMutableArray<GeoPackageFeatureItem *> *featureItems = [[NSMutableArray alloc] init];
     // Get the zoom level
     double zoom = [GPKGMapUtils currentZoomWithMapView:mapView];
@@ -109,152 +118,127 @@ NSInteger const GEO_PACKAGE_FEATURE_TABLE_MAX_ZOOM = 21;
                 }
                 // Else, query for the features near the click
                 else if(self.featureOverlayQuery.featuresInfo){
-                    GPKGGeoPackage *geoPackage = [[GPKGGeoPackageFactory manager] open:[self getGeoPackage]];
-                    GPKGExtendedRelationsDao *relationsDao = [GPKGExtendedRelationsDao createWithDatabase:geoPackage.database];
-                    GPKGRelatedTablesExtension *rte = [[GPKGRelatedTablesExtension alloc] initWithGeoPackage:geoPackage];
-                    NSMutableArray<GPKGExtendedRelation *> *mediaTables = [[NSMutableArray alloc] init];
-                    NSMutableArray<GPKGExtendedRelation *> *attributeTables = [[NSMutableArray alloc] init];
-                    
-                    if ([relationsDao tableExists]){
-                        GPKGResultSet *relations = [relationsDao relationsToBaseTable:[self getName]];
-                        @try {
-                            while([relations moveToNext]){
-                                GPKGExtendedRelation *extendedRelation = [relationsDao relation:relations];
-                                if ([extendedRelation relationType] == [GPKGRelationTypes fromName:GPKG_RT_MEDIA_NAME]){
-                                    [mediaTables addObject:extendedRelation];
-                                } else if ([extendedRelation relationType] == [GPKGRelationTypes fromName:GPKG_RT_ATTRIBUTES_NAME]) {
-                                    [attributeTables addObject:extendedRelation];
-                                } else if ([extendedRelation relationType] == [GPKGRelationTypes fromName:GPKG_RT_SIMPLE_ATTRIBUTES_NAME]) {
-                                    [attributeTables addObject:extendedRelation];
-                                }
-                            }
-                        } @finally {
-                            [relations close];
-                        }
+                    // Without relations from the GeoPackage manager open the GeoPackage just for this tap
+                    GPKGGeoPackage *openedGeoPackage = nil;
+                    GeoPackageFeatureTableRelations *relations = tableRelations;
+                    if(relations == nil){
+                        openedGeoPackage = [[GPKGGeoPackageFactory manager] open:[self getGeoPackage]];
+                        relations = [[GeoPackageFeatureTableRelations alloc] initWithGeoPackage:openedGeoPackage andTableName:[self getName]];
                     }
                     
-                    // Query for results and build the message
-                    GPKGFeatureIndexResults * results = [self.featureOverlayQuery queryFeaturesWithBoundingBox:boundingBox inProjection:nil];
+                    @try {
+                        // Query for results and build the message
+                        GPKGFeatureIndexResults * results = [self.featureOverlayQuery queryFeaturesWithBoundingBox:boundingBox inProjection:nil];
                 
-                    for (GPKGFeatureRow *featureRow in results) {
-                        NSMutableArray<GPKGMediaRow *> * medias = [[NSMutableArray alloc] init];
-                        NSMutableArray<GPKGAttributesRow *> *attributes = [NSMutableArray array];
+                        for (GPKGFeatureRow *featureRow in results) {
+                            NSMutableArray<GPKGMediaRow *> * medias = [[NSMutableArray alloc] init];
+                            NSMutableArray<GPKGAttributesRow *> *attributes = [NSMutableArray array];
                         
-                        int featureId = featureRow.idValue;
-                        for (GPKGExtendedRelation *relation in mediaTables) {
-                            NSArray<NSNumber *> *relatedMedia = [rte mappingsForTableName:relation.mappingTableName withBaseId:featureId];
-                            GPKGMediaDao *mediaDao = [rte mediaDaoForTableName:relation.relatedTableName];
-                            [medias addObjectsFromArray: [mediaDao rowsWithIds:relatedMedia]];
-                        }
+                            int featureId = featureRow.idValue;
+                            for (GPKGExtendedRelation *relation in relations.mediaRelations) {
+                                NSArray<NSNumber *> *relatedMedia = [relations relatedIdsForRelation:relation withBaseId:featureId];
+                                GPKGMediaDao *mediaDao = [relations mediaDaoForRelation:relation];
+                                [medias addObjectsFromArray: [mediaDao rowsWithIds:relatedMedia]];
+                            }
                         
-                        for (GPKGExtendedRelation *relation in attributeTables) {
-                            NSArray<NSNumber *> *relatedAttributes = [rte mappingsForTableName:relation.mappingTableName withBaseId:featureId];
+                            for (GPKGExtendedRelation *relation in relations.attributesRelations) {
+                                NSArray<NSNumber *> *relatedAttributes = [relations relatedIdsForRelation:relation withBaseId:featureId];
                             
-                            GPKGAttributesDao *attributesDao = [geoPackage attributesDaoWithTableName:relation.relatedTableName];
+                                GPKGAttributesDao *attributesDao = [relations attributesDaoForRelation:relation];
                             
-                            for(NSNumber *relatedAttribute in relatedAttributes){
-                                GPKGAttributesRow *row = (GPKGAttributesRow *)[attributesDao queryForIdObject:relatedAttribute];
-                                if(row != nil){
-                                    [attributes addObject:row];
+                                for(NSNumber *relatedAttribute in relatedAttributes){
+                                    GPKGAttributesRow *row = (GPKGAttributesRow *)[attributesDao queryForIdObject:relatedAttribute];
+                                    if(row != nil){
+                                        [attributes addObject:row];
+                                    }
                                 }
                             }
-                        }
                         
-                        GPKGDataColumnsDao *dataColumnsDao = [self dataColumnsDao:self.featureOverlayQuery.featureTiles.featureDao.database];
+                            GPKGDataColumnsDao *dataColumnsDao = relations.dataColumnsDao;
                         
-                        NSMutableDictionary * values = [NSMutableDictionary dictionary];
-                        NSMutableDictionary *featureDataTypes = [NSMutableDictionary dictionary];
-                        NSString * geometryColumnName = nil;
+                            NSMutableDictionary * values = [NSMutableDictionary dictionary];
+                            NSMutableDictionary *featureDataTypes = [NSMutableDictionary dictionary];
+                            NSString * geometryColumnName = nil;
                         
-                        CLLocationCoordinate2D coordinate = tapLocation;
+                            CLLocationCoordinate2D coordinate = tapLocation;
                         
-                        int geometryColumn = [featureRow geometryColumnIndex];
-                        for(int i = 0; i < [featureRow columnCount]; i++){
+                            int geometryColumn = [featureRow geometryColumnIndex];
+                            for(int i = 0; i < [featureRow columnCount]; i++){
                             
-                            NSObject * value = [featureRow valueWithIndex:i];
+                                NSObject * value = [featureRow valueWithIndex:i];
                             
-                            NSString * columnName = [featureRow columnNameWithIndex:i];
+                                NSString * columnName = [featureRow columnNameWithIndex:i];
                             
-                            columnName = [self columnNameWithDataColumnsDao:dataColumnsDao andFeatureRow:featureRow andColumnName:columnName];
+                                columnName = [self columnNameWithDataColumnsDao:dataColumnsDao andFeatureRow:featureRow andColumnName:columnName];
                             
-                            if(i == geometryColumn){
-                                geometryColumnName = columnName;
-                                GPKGGeometryData *geometry = (GPKGGeometryData *)value;
-                                SFPoint *centroid = [geometry.geometry centroid];
-                                SFPGeometryTransform *transform = [[SFPGeometryTransform alloc] initWithFromProjection:self.featureOverlayQuery.featureTiles.featureDao.projection andToEpsg:4326];
+                                if(i == geometryColumn){
+                                    geometryColumnName = columnName;
+                                    GPKGGeometryData *geometry = (GPKGGeometryData *)value;
+                                    SFPoint *centroid = [geometry.geometry centroid];
+                                    SFPGeometryTransform *transform = [[SFPGeometryTransform alloc] initWithFromProjection:self.featureOverlayQuery.featureTiles.featureDao.projection andToEpsg:4326];
                                 
-                                centroid = [transform transformPoint:centroid];
-                                [transform destroy];
-                                coordinate = CLLocationCoordinate2DMake([centroid.y doubleValue], [centroid.x doubleValue]);
-                            }
-                            [featureDataTypes setValue:[GPKGDataTypes name:featureRow.featureColumns.columns[i].dataType] forKey:columnName];
-                            if(value != nil){
-                                [values setObject:value forKey:columnName];
+                                    centroid = [transform transformPoint:centroid];
+                                    [transform destroy];
+                                    coordinate = CLLocationCoordinate2DMake([centroid.y doubleValue], [centroid.x doubleValue]);
+                                }
+                                [featureDataTypes setValue:[GPKGDataTypes name:featureRow.featureColumns.columns[i].dataType] forKey:columnName];
+                                if(value != nil){
+                                    [values setObject:value forKey:columnName];
+                                }
                             }
-                        }
                         
-                        GPKGFeatureRowData * featureRowData = [[GPKGFeatureRowData alloc] initWithValues:values andGeometryColumnName:geometryColumnName];
+                            GPKGFeatureRowData * featureRowData = [[GPKGFeatureRowData alloc] initWithValues:values andGeometryColumnName:geometryColumnName];
                         
-                        NSMutableArray<GeoPackageFeatureItem *> *attributeFeatureRowData = [NSMutableArray array];
+                            NSMutableArray<GeoPackageFeatureItem *> *attributeFeatureRowData = [NSMutableArray array];
                         
-                        for (GPKGAttributesRow *row in attributes) {
-                            NSMutableArray<GPKGExtendedRelation *> *attributeMediaTables = [[NSMutableArray alloc] init];
-                            NSArray<GPKGMediaRow *> * attributeMedias = nil;
-
-
-                            if ([relationsDao tableExists]){
-                                GPKGResultSet *relations = [relationsDao relationsToBaseTable: row.attributesTable.tableName ];
-                                @try {
-                                    while([relations moveToNext]){
-                                        GPKGExtendedRelation *extendedRelation = [relationsDao relation:relations];
-                                        if ([extendedRelation relationType] == [GPKGRelationTypes fromName:GPKG_RT_MEDIA_NAME]){
-                                            [attributeMediaTables addObject:extendedRelation];
-                                        }
-                                    }
-                                } @finally {
-                                    [relations close];
-                                }
-                            }
+                            for (GPKGAttributesRow *row in attributes) {
+                                NSArray<GPKGExtendedRelation *> *attributeMediaTables = [relations mediaRelationsForAttributesTable:row.attributesTable.tableName];
+                                NSArray<GPKGMediaRow *> * attributeMedias = nil;
                             
-                            int attributeId = row.idValue;
-                            for (GPKGExtendedRelation *relation in attributeMediaTables) {
-                                NSArray<NSNumber *> *relatedMedia = [rte mappingsForTableName:relation.mappingTableName withBaseId:attributeId];
-                                GPKGMediaDao *mediaDao = [rte mediaDaoForTableName:relation.relatedTableName];
-                                attributeMedias = [mediaDao rowsWithIds:relatedMedia];
-                            }
-                            NSMutableDictionary * values = [NSMutableDictionary dictionary];
-                            NSMutableDictionary *attributeDataTypes = [NSMutableDictionary dictionary];
-                            NSString * geometryColumnName = nil;
+                                int attributeId = row.idValue;
+                                for (GPKGExtendedRelation *relation in attributeMediaTables) {
+                                    NSArray<NSNumber *> *relatedMedia = [relations relatedIdsForRelation:relation withBaseId:attributeId];
+                                    GPKGMediaDao *mediaDao = [relations mediaDaoForRelation:relation];
+                                    attributeMedias = [mediaDao rowsWithIds:relatedMedia];
+                                }
+                                NSMutableDictionary * values = [NSMutableDictionary dictionary];
+                                NSMutableDictionary *attributeDataTypes = [NSMutableDictionary dictionary];
+                                NSString * geometryColumnName = nil;
                             
-                            for(int i = 0; i < [row columnCount]; i++){
+                                for(int i = 0; i < [row columnCount]; i++){
                                 
-                                NSObject * value = [row valueWithIndex:i];
+                                    NSObject * value = [row valueWithIndex:i];
                                 
-                                NSString * columnName = [row columnNameWithIndex:i];
+                                    NSString * columnName = [row columnNameWithIndex:i];
                                 
-                                columnName = [self columnNameWithDataColumnsDao:dataColumnsDao andAttributesRow:row  andColumnName:columnName];
+                                    columnName = [self columnNameWithDataColumnsDao:dataColumnsDao andAttributesRow:row  andColumnName:columnName];
                                 
-                                [attributeDataTypes setValue:[GPKGDataTypes name: row.attributesColumns.columns[i].dataType] forKey:columnName];
-                                if(value != nil){
-                                    [values setObject:value forKey:columnName];
+                                    [attributeDataTypes setValue:[GPKGDataTypes name: row.attributesColumns.columns[i].dataType] forKey:columnName];
+                                    if(value != nil){
+                                        [values setObject:value forKey:columnName];
+                                    }
                                 }
-                            }
                             
-                            GPKGFeatureRowData * attributeRowData = [[GPKGFeatureRowData alloc] initWithValues:values andGeometryColumnName:geometryColumnName];
-                            GeoPackageFeatureItem *featureItem = [[GeoPackageFeatureItem alloc] initWithFeatureId:row.idValue featureRowData: attributeRowData featureDataTypes: attributeDataTypes coordinate:coordinate layerName: [self getName] icon:nil style: nil mediaRows:attributeMedias attributeRows:nil];
-                            [attributeFeatureRowData addObject:featureItem];
-                        }
+                                GPKGFeatureRowData * attributeRowData = [[GPKGFeatureRowData alloc] initWithValues:values andGeometryColumnName:geometryColumnName];
+                                GeoPackageFeatureItem *featureItem = [[GeoPackageFeatureItem alloc] initWithFeatureId:row.idValue featureRowData: attributeRowData featureDataTypes: attributeDataTypes coordinate:coordinate layerName: [self getName] icon:nil style: nil mediaRows:attributeMedias attributeRows:nil];
+                                [attributeFeatureRowData addObject:featureItem];
+                            }
                         
-                        GPKGFeatureStyle *featureStyle = [styles featureStyleWithFeature:featureRow];
-                        UIImage *image = nil;
-                        if ([featureStyle hasIcon]){
-                            GPKGIconRow *icon = featureStyle.icon;
-                            image = icon.dataImage;
-                        }
-                        GPKGStyleRow *style = [featureStyle style];
+                            GPKGFeatureStyle *featureStyle = [styles featureStyleWithFeature:featureRow];
+                            UIImage *image = nil;
+                            if ([featureStyle hasIcon]){
+                                GPKGIconRow *icon = featureStyle.icon;
+                                image = icon.dataImage;
+                            }
+                            GPKGStyleRow *style = [featureStyle style];
                                                 
-                        GeoPackageFeatureItem *featureItem = [[GeoPackageFeatureItem alloc] initWithFeatureId:featureId featureRowData: featureRowData featureDataTypes: featureDataTypes coordinate:coordinate layerName: [self getName] icon:image style: style mediaRows:medias attributeRows:attributeFeatureRowData];
-                        [featureItems addObject:featureItem];
+                            GeoPackageFeatureItem *featureItem = [[GeoPackageFeatureItem alloc] initWithFeatureId:featureId featureRowData: featureRowData featureDataTypes: featureDataTypes coordinate:coordinate layerName: [self getName] icon:image style: style mediaRows:medias attributeRows:attributeFeatureRowData];
+                            [featureItems addObject:featureItem];
+                        }
+                    } @finally {
+                        if(openedGeoPackage != nil){
+                            [openedGeoPackage close];
+                        }
                     }
                 }
             }
@@ -313,17 +297,6 @@ NSInteger const GEO_PACKAGE_FEATURE_TABLE_MAX_ZOOM = 21;
     return newColumnName;
 }
 
--(GPKGDataColumnsDao *) dataColumnsDao: (GPKGConnection *) database {
-    
-    GPKGDataColumnsDao * dataColumnsDao = [[GPKGDataColumnsDao alloc] initWithDatabase:database];
-    
-    if(![dataColumnsDao tableExists]){
-        dataColumnsDao = nil;
-    }
-    
-    return dataColumnsDao;
-}
-
 -(BOOL) getIndexed{
     return self.indexed;
 }
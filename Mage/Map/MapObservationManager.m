@@ -71,6 +71,7 @@
                 {
                     StyledPolyline *styledPolyline = [StyledPolyline createWithPolyline:(MKPolyline *)shape.shape];
                     [self setStyledPolyline: styledPolyline withStyle:style];
+                    [styledPolyline buildMultiResolutionShapeInBackground];
                     [shape setShape:styledPolyline];
                 }
                 break;
@@ -78,6 +79,7 @@
                 {
                     StyledPolygon *styledPolygon = [StyledPolygon createWithPolygon:(MKPolygon *)shape.shape];
                     [self setStyledPolygon: styledPolygon withStyle:style];
+                    [styledPolygon buildMultiResolutionShapeInBackground];
                     [shape setShape:styledPolygon];
                 }
                 break;
@@ -25,6 +25,7 @@ class FilteredObservationsMapMixin: NSObject, MapMixin {
     var selectedObservationAccuracy: MKOverlay?
     
     var observations: Observations?
+    var subscription: PersistentHistorySubscription?
     var mapObservationManager: MapObservationManager
     private var pointAnnotationsByObjectID: [NSManagedObjectID: ObservationAnnotation] = [:]
     private var lineObservationsByObjectID: [NSManagedObjectID: StyledPolyline] = [:]
@@ -51,7 +52,8 @@ class FilteredObservationsMapMixin: NSObject, MapMixin {
         UserDefaults.standard.removeObserver(self, forKeyPath: #keyPath(UserDefaults.importantFilterKey))
         UserDefaults.standard.removeObserver(self, forKeyPath: #keyPath(UserDefaults.favoritesFilterKey))
         
-        observations?.delegate = nil
+        subscription?.cancel()
+        subscription = nil
         observations = nil
         pointAnnotationsByObjectID.removeAll()
         lineObservationsByObjectID.removeAll()
@@ -76,10 +78,14 @@ class FilteredObservationsMapMixin: NSObject, MapMixin {
         NotificationCenter.default.addObserver(forName: .MAGEFormFetched, object: nil, queue: .main) { [weak self] notification in
             if let event: Event = notification.object as? Event {
                 if event.remoteId == Server.currentEventId() {
-                    self?.addFilteredObservations()
+                    // form styles may have changed, redraw everything
+                    self?.addFilteredObservations(redraw: true)
                 }
             }
         }
+        subscription = PersistentHistoryChangeProcessor.shared.subscribe(entityNames: ["Observation"], keys: nil, queue: .main) { [weak self] changeSets in
+            self?.applyChanges(changeSets: changeSets)
+        }
         addFilteredObservations()
     }
     
@@ -110,35 +116,57 @@ class FilteredObservationsMapMixin: NSObject, MapMixin {
         return annotations
     }
     
-    func addFilteredObservations() {
-        if let observations = observations, let fetchedObservations = observations.fetchedResultsController.fetchedObjects as? [Observation] {
-            for observation in fetchedObservations {
-                deleteObservation(observation: observation)
+    func addFilteredObservations(redraw: Bool = false) {
+        if redraw {
+            let tracked = trackedObjectIDs
+            performMapMutation {
+                removeTrackedObservations(objectIDs: tracked)
             }
         }
         
+        // the fetched results controller only supplies the filter and the first fetch, changes come from the store history
         if let user = user {
             observations = Observations(for: user)
-            observations?.delegate = self
         } else if let observations = observations,
            let observationPredicates = Observations.getPredicatesForObservationsForMap() as? [NSPredicate] {
             observations.fetchedResultsController.fetchRequest.predicate = NSCompoundPredicate(andPredicateWithSubpredicates: observationPredicates)
             
         } else {
             observations = Observations.forMap()
-            observations?.delegate = self
         }
         
         if let observations = observations {
             do {
                 try observations.fetchedResultsController.performFetch()
-                updateObservations(observations: observations.fetchedResultsController.fetchedObjects as? [Observation])
+                applyFilteredObservations(observations: observations.fetchedResultsController.fetchedObjects as? [Observation] ?? [])
             } catch {
                 NSLog("Failed to perform fetch in the MapDelegate for observations \(error), \((error as NSError).userInfo)")
             }
         }
     }
     
+    /// Diff the newly filtered observations against what is already on the map, only removing observations
+    /// which no longer match the filter and only adding observations which are not already drawn
+    func applyFilteredObservations(observations: [Observation]) {
+        var filteredObjectIDs: Set<NSManagedObjectID> = []
+        var added: [Observation] = []
+        for observation in observations {
+            let objectID = trackedObjectID(for: observation)
+            filteredObjectIDs.insert(objectID)
+            if !isTracked(objectID: objectID) {
+                added.append(observation)
+            }
+        }
+        
+        let removed = trackedObjectIDs.subtracting(filteredObjectIDs)
+        if !removed.isEmpty {
+            performMapMutation {
+                removeTrackedObservations(objectIDs: removed)
+            }
+        }
+        updateObservations(observations: added)
+    }
+    
     func updateObservations(observations: [Observation]?) {
         guard let observations = observations else {
             return
@@ -192,6 +220,42 @@ class FilteredObservationsMapMixin: NSObject, MapMixin {
         }
     }
 
+    private var trackedObjectIDs: Set<NSManagedObjectID> {
+        return Set(pointAnnotationsByObjectID.keys)
+            .union(lineObservationsByObjectID.keys)
+            .union(polygonObservationsByObjectID.keys)
+    }
+
+    private func isTracked(objectID: NSManagedObjectID) -> Bool {
+        return pointAnnotationsByObjectID[objectID] != nil
+            || lineObservationsByObjectID[objectID] != nil
+            || polygonObservationsByObjectID[objectID] != nil
+    }
+
+    /// Remove many tracked observations with a single annotation and overlay removal on the map
+    private func removeTrackedObservations(objectIDs: Set<NSManagedObjectID>) {
+        var annotations: [MKAnnotation] = []
+        var overlays: [MKOverlay] = []
+        for objectID in objectIDs {
+            if let annotation = pointAnnotationsByObjectID.removeValue(forKey: objectID) {
+                annotations.append(annotation)
+                unregisterRemoteAlias(objectID: objectID, remoteId: annotation.observationId)
+            } else if let polyline = lineObservationsByObjectID.removeValue(forKey: objectID) {
+                overlays.append(polyline)
+                unregisterRemoteAlias(objectID: objectID, remoteId: polyline.observationRemoteId)
+            } else if let polygon = polygonObservationsByObjectID.removeValue(forKey: objectID) {
+                overlays.append(polygon)
+                unregisterRemoteAlias(objectID: objectID, remoteId: polygon.observationRemoteId)
+            }
+        }
+        if !annotations.isEmpty {
+            filteredObservationsMap?.mapView?.removeAnnotations(annotations)
+        }
+        if !overlays.isEmpty {
+            filteredObservationsMap?.mapView?.removeOverlays(overlays)
+        }
+    }
+
     private func removeTrackedObservation(objectID: NSManagedObjectID, remoteId: String?) {
         if let annotation = pointAnnotationsByObjectID.removeValue(forKey: objectID) {
             filteredObservationsMap?.mapView?.removeAnnotation(annotation)
@@ -237,6 +301,7 @@ class FilteredObservationsMapMixin: NSObject, MapMixin {
                     styledPolyline.lineWidth = style?.lineWidth ?? 1
                     styledPolyline.observationRemoteId = observation.remoteId
                     styledPolyline.observation = observation
+                    styledPolyline.buildMultiResolutionShapeInBackground()
                     lineObservationsByObjectID[objectID] = styledPolyline
                     registerRemoteAlias(objectID: objectID, remoteId: observation.remoteId)
                     filteredObservationsMap?.mapView?.addOverlay(styledPolyline)
@@ -247,6 +312,7 @@ class FilteredObservationsMapMixin: NSObject, MapMixin {
                     styledPolygon.fillColor = style?.fillColor ?? .clear
                     styledPolygon.observation = observation
                     styledPolygon.observationRemoteId = observation.remoteId
+                    styledPolygon.buildMultiResolutionShapeInBackground()
                     polygonObservationsByObjectID[objectID] = styledPolygon
                     registerRemoteAlias(objectID: objectID, remoteId: observation.remoteId)
                     filteredObservationsMap?.mapView?.addOverlay(styledPolygon)
@@ -352,23 +418,40 @@ class FilteredObservationsMapMixin: NSObject, MapMixin {
     }
 }
 
-extension FilteredObservationsMapMixin : NSFetchedResultsControllerDelegate {
-    func controller(_ controller: NSFetchedResultsController<NSFetchRequestResult>, didChange anObject: Any, at indexPath: IndexPath?, for type: NSFetchedResultsChangeType, newIndexPath: IndexPath?) {
-        guard let observation = anObject as? Observation else {
+extension FilteredObservationsMapMixin {
+    /// Redraw the changed observations which still match the filter and remove the rest, all of the
+    /// changes saved together are applied at once
+    func applyChanges(changeSets: [EntityChangeSet]) {
+        guard let predicate = observations?.fetchedResultsController.fetchRequest.predicate else {
             return
         }
-        switch(type) {
-            
-        case .insert:
-            self.updateObservation(observation: observation, animated: true)
-        case .delete:
-            self.deleteObservation(observation: observation)
-        case .move:
-            self.updateObservation(observation: observation, animated: false)
-        case .update:
-            self.updateObservation(observation: observation, animated: false)
-        @unknown default:
-            break
+        var removed: Set<NSManagedObjectID> = []
+        var changed: Set<NSManagedObjectID> = []
+        var inserted: Set<NSManagedObjectID> = []
+        for changeSet in changeSets {
+            removed.formUnion(changeSet.deleted)
+            changed.formUnion(changeSet.insertedOrUpdated)
+            inserted.formUnion(changeSet.inserted)
+        }
+
+        var matching: [Observation] = []
+        if !changed.isEmpty {
+            let fetchRequest = NSFetchRequest<Observation>(entityName: "Observation")
+            fetchRequest.predicate = NSCompoundPredicate(andPredicateWithSubpredicates: [NSPredicate(format: "self IN %@", Array(changed)), predicate])
+            // the main context may still hold the old values of observations it already has
+            fetchRequest.shouldRefreshRefetchedObjects = true
+            matching = (try? NSManagedObjectContext.mr_default().fetch(fetchRequest)) ?? []
+        }
+        let matchingIDs = Set(matching.map { $0.objectID })
+        removed.formUnion(changed.subtracting(matchingIDs).filter { isTracked(objectID: $0) })
+
+        if !removed.isEmpty {
+            performMapMutation {
+                removeTrackedObservations(objectIDs: removed)
+            }
+        }
+        for observation in matching {
+            updateObservation(observation: observation, animated: inserted.contains(observation.objectID))
         }
     }
 }
@@ -31,6 +31,9 @@ class FilteredUsersMapMixin: NSObject, MapMixin {
     var selectedUserAccuracy: MKOverlay?
     
     var locations: Locations?
+    var subscription: PersistentHistorySubscription?
+    // the user of each location on the map, a deleted location no longer knows its user
+    private var userRemoteIdByLocationID: [NSManagedObjectID: String] = [:]
     var user: User?
     
     init(filteredUsersMap: FilteredUsersMap, user: User? = nil, scheme: MDCContainerScheming?) {
@@ -51,8 +54,10 @@ class FilteredUsersMapMixin: NSObject, MapMixin {
         UserDefaults.standard.removeObserver(self, forKeyPath: #keyPath(UserDefaults.locationTimeFilterNumber))
         UserDefaults.standard.removeObserver(self, forKeyPath: #keyPath(UserDefaults.hidePeople))
         
-        locations?.fetchedResultsController.delegate = nil
+        subscription?.cancel()
+        subscription = nil
         locations = nil
+        userRemoteIdByLocationID.removeAll()
     }
     
     func setupMixin() {
@@ -69,6 +74,9 @@ class FilteredUsersMapMixin: NSObject, MapMixin {
             }
         }
         
+        subscription = PersistentHistoryChangeProcessor.shared.subscribe(entityNames: ["Location"], keys: nil, queue: .main) { [weak self] changeSets in
+            self?.applyChanges(changeSets: changeSets)
+        }
         addFilteredUsers()
     }
     
@@ -78,21 +86,19 @@ class FilteredUsersMapMixin: NSObject, MapMixin {
     }
     
     func addFilteredUsers() {
-        if let locations = locations, let fetchedLocations = locations.fetchedResultsController.fetchedObjects as? [Location] {
-            for location in fetchedLocations {
-                deleteLocation(location: location)
-            }
+        for userRemoteId in Set(userRemoteIdByLocationID.values) {
+            deleteAnnotation(userRemoteId: userRemoteId)
         }
+        userRemoteIdByLocationID.removeAll()
         
+        // the fetched results controller only supplies the filter and the first fetch, changes come from the store history
         if let user = user {
             locations = Locations(for: user)
-            locations?.delegate = self
         } else if let locations = locations,
            let locationPredicates = Locations.getPredicatesForLocationsForMap() as? [NSPredicate] {
             locations.fetchedResultsController.fetchRequest.predicate = NSCompoundPredicate(andPredicateWithSubpredicates: locationPredicates)
         } else {
             locations = Locations.forMap()
-            locations?.delegate = self
         }
         
         if let locations = locations {
@@ -121,6 +127,9 @@ class FilteredUsersMapMixin: NSObject, MapMixin {
         guard let coordinate = location.location?.coordinate else {
             return
         }
+        if let userRemoteId = location.user?.remoteId {
+            userRemoteIdByLocationID[location.objectID] = userRemoteId
+        }
         
         if let annotation: LocationAnnotation = mapView?.annotations.first(where: { annotation in
             if let annotation = annotation as? LocationAnnotation {
@@ -137,9 +146,14 @@ class FilteredUsersMapMixin: NSObject, MapMixin {
     }
     
     func deleteLocation(location: Location) {
+        userRemoteIdByLocationID.removeValue(forKey: location.objectID)
+        deleteAnnotation(userRemoteId: location.user?.remoteId)
+    }
+    
+    func deleteAnnotation(userRemoteId: String?) {
         let annotation = mapView?.annotations.first(where: { annotation in
             if let annotation = annotation as? LocationAnnotation {
-                return annotation.user.remoteId == location.user?.remoteId
+                return annotation.user.remoteId == userRemoteId
             }
             return false
         })
@@ -239,23 +253,39 @@ class FilteredUsersMapMixin: NSObject, MapMixin {
     }
 }
 
-extension FilteredUsersMapMixin : NSFetchedResultsControllerDelegate {
-    func controller(_ controller: NSFetchedResultsController<NSFetchRequestResult>, didChange anObject: Any, at indexPath: IndexPath?, for type: NSFetchedResultsChangeType, newIndexPath: IndexPath?) {
-        guard let location = anObject as? Location else {
+extension FilteredUsersMapMixin {
+    /// Move the users whose changed locations still match the filter and remove the rest, all of the
+    /// changes saved together are applied at once
+    func applyChanges(changeSets: [EntityChangeSet]) {
+        guard let predicate = locations?.fetchedResultsController.fetchRequest.predicate else {
             return
         }
-        switch(type) {
-            
-        case .insert:
-            self.updateLocation(location: location)
-        case .delete:
-            self.deleteLocation(location: location)
-        case .move:
-            self.updateLocation(location: location)
-        case .update:
-            self.updateLocation(location: location)
-        @unknown default:
-            break
+        var removed: Set<NSManagedObjectID> = []
+        var changed: Set<NSManagedObjectID> = []
+        for changeSet in changeSets {
+            removed.formUnion(changeSet.deleted)
+            changed.formUnion(changeSet.insertedOrUpdated)
+        }
+
+        var matching: [Location] = []
+        if !changed.isEmpty {
+            let fetchRequest = NSFetchRequest<Location>(entityName: "Location")
+            fetchRequest.predicate = NSCompoundPredicate(andPredicateWithSubpredicates: [NSPredicate(format: "self IN %@", Array(changed)), predicate])
+            // the main context may still hold the old values of locations it already has
+            fetchRequest.shouldRefreshRefetchedObjects = true
+            matching = (try? NSManagedObjectContext.mr_default().fetch(fetchRequest)) ?? []
+        }
+        removed.formUnion(changed.subtracting(matching.map { $0.objectID }))
+
+        let movedUsers = Set(matching.compactMap { $0.user?.remoteId })
+        for locationID in removed {
+            // the user may have moved to a new location in the same save
+            if let userRemoteId = userRemoteIdByLocationID.removeValue(forKey: locationID), !movedUsers.contains(userRemoteId) {
+                deleteAnnotation(userRemoteId: userRemoteId)
+            }
+        }
+        for location in matching {
+            updateLocation(location: location)
         }
     }
 }
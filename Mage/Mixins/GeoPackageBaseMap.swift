@@ -48,9 +48,9 @@ class GeoPackageBaseMapMixin: NSObject, MapMixin {
         mapView?.removeOverlay(darkBackgroundOverlay)
         mapView?.removeOverlay(backgroundOverlay)
         
+        let overrideStyle = mapView?.window?.overrideUserInterfaceStyle ?? UITraitCollection.current.userInterfaceStyle
+        let style = overrideStyle == .unspecified ? UITraitCollection.current.userInterfaceStyle : overrideStyle
         if UserDefaults.standard.mapType == 3 {
-            let overrideStyle = mapView?.window?.overrideUserInterfaceStyle ?? UITraitCollection.current.userInterfaceStyle
-            let style = overrideStyle == .unspecified ? UITraitCollection.current.userInterfaceStyle : overrideStyle
             if style == .dark {
                 mapView?.addOverlay(darkBackgroundOverlay, level: .aboveRoads)
             } else {
@@ -65,10 +65,10 @@ class GeoPackageBaseMapMixin: NSObject, MapMixin {
         }
         switch GridType(rawValue: UserDefaults.standard.gridType) {
         case .GARS:
-            gridOverlay = GridSystems.garsTileOverlay()
+            gridOverlay = GridSystems.garsTileOverlay(userInterfaceStyle: style)
             break;
         case .MGRS:
-            gridOverlay = GridSystems.mgrsTileOverlay()
+            gridOverlay = GridSystems.mgrsTileOverlay(userInterfaceStyle: style)
             break;
         default:
             gridOverlay = nil
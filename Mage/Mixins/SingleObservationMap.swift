@@ -33,7 +33,7 @@ class SingleObservationMapMixin: FilteredObservationsMapMixin {
         self._observation = observation
     }
     
-    override func addFilteredObservations() {
+    override func addFilteredObservations(redraw: Bool = false) {
         if let observations = observations, let fetchedObservations = observations.fetchedResultsController.fetchedObjects as? [Observation] {
             for observation in fetchedObservations {
                 deleteObservation(observation: observation)
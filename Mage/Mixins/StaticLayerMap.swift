@@ -21,7 +21,21 @@ class StaticLayerMapMixin: NSObject, MapMixin {
     var mapAnnotationFocusedObserver: AnyObject?
 
     var staticLayerMap: StaticLayerMap
+    /// points for each layer on the map
     var staticLayers: [NSNumber:[Any]] = [:]
+    /// overlays added to the map for each layer, shapes which share a style are combined into one overlay
+    var staticLayerOverlays: [NSNumber:[MKOverlay]] = [:]
+    /// layers being built in the background
+    var pendingStaticLayers: [NSNumber:Operation] = [:]
+    /// identifies each load in the progress notifications, only changed on the main thread
+    private static var lastLoadId = 0
+    let staticLayerQueue: OperationQueue = {
+        let queue = OperationQueue()
+        queue.name = "Static layer queue"
+        queue.qualityOfService = .userInitiated
+        queue.maxConcurrentOperationCount = 1
+        return queue
+    }()
     var enlargedAnnotationView: MKAnnotationView?
     
     init(staticLayerMap: StaticLayerMap) {
@@ -34,6 +48,10 @@ class StaticLayerMapMixin: NSObject, MapMixin {
         }
         mapAnnotationFocusedObserver = nil
         UserDefaults.standard.removeObserver(self, forKeyPath: "selectedStaticLayers")
+        for operation in pendingStaticLayers.values {
+            operation.cancel()
+        }
+        pendingStaticLayers.removeAll()
     }
     
     func setupMixin() {
@@ -53,7 +71,7 @@ class StaticLayerMapMixin: NSObject, MapMixin {
     }
     
     func updateStaticLayers() {
-        var unselectedStaticLayerIds: [NSNumber] = staticLayers.map({ $0.key })
+        var unselectedStaticLayerIds: [NSNumber] = staticLayers.map({ $0.key }) + pendingStaticLayers.map({ $0.key })
         
         guard let staticLayersPerEvent = UserDefaults.standard.selectedStaticLayers, let currentEvent = Server.currentEventId() else {
             return
@@ -61,106 +79,103 @@ class StaticLayerMapMixin: NSObject, MapMixin {
         
         let staticLayersInEvent = staticLayersPerEvent[currentEvent.stringValue] ?? []
         for staticLayerId in staticLayersInEvent {
-            guard let staticLayer = StaticLayer.mr_findFirst(with: NSPredicate(format: "remoteId == %@ AND eventId == %@", staticLayerId, currentEvent), in: NSManagedObjectContext.mr_default()) else {
-                continue
-            }
             if !unselectedStaticLayerIds.contains(staticLayerId) {
-                print("Adding the static layer \(staticLayer.name ?? "No Name") to the map")
-                guard let features = staticLayer.features else {
-                    continue
-                }
-                var annotations: [Any] = []
-                for feature in features {
-                    guard let featureType = StaticLayer.featureType(feature: feature) else {
-                        continue
-                    }
-                    if featureType == "Point" {
-                        if let annotation = StaticPointAnnotation(feature: feature) {
-                            annotation.layerName = staticLayer.name
-                            annotation.title = StaticLayer.featureName(feature: feature)
-                            annotation.subtitle = StaticLayer.featureDescription(feature: feature)
-                            staticLayerMap.mapView?.addAnnotation(annotation)
-                            annotations.append(annotation)
-                        }
-                    } else if featureType == "Polygon" {
-                        if let coordinates = StaticLayer.featureCoordinates(feature: feature) {
-                            let polygon = StyledPolygon.generate(coordinates: coordinates as? [[[NSNumber]]] ?? [])
-                            let fillOpacity = StaticLayer.featureFillOpacity(feature: feature)
-                            let fillAlpha = fillOpacity / 255.0
-                            polygon.setFillColor(hex: StaticLayer.featureFillColor(feature: feature), alpha: fillAlpha)
-                            
-                            let lineOpacity = staticLayer.featureLineOpacity(feature: feature)
-                            let lineAlpha = lineOpacity / 255.0
-                            polygon.setLineColor(hex: StaticLayer.featureLineColor(feature: feature), alpha: lineAlpha)
-                            
-                            polygon.lineWidth = StaticLayer.featureLineWidth(feature: feature)
-                            
-                            polygon.title = StaticLayer.featureName(feature: feature)
-                            polygon.subtitle = StaticLayer.featureDescription(feature: feature)
-                            
-                            annotations.append(polygon)
-                            staticLayerMap.mapView?.addOverlay(polygon)
-                        }
-                    } else if featureType == "LineString" {
-                        if let coordinates = StaticLayer.featureCoordinates(feature: feature) {
-                            let polyline = StyledPolyline.generate(path: coordinates as? [[NSNumber]] ?? [])
-                            
-                            let lineOpacity = staticLayer.featureLineOpacity(feature: feature)
-                            let lineAlpha = lineOpacity / 255.0
-                            polyline.setLineColor(hex: StaticLayer.featureLineColor(feature: feature), alpha: lineAlpha)
-                            polyline.lineWidth = StaticLayer.featureLineWidth(feature: feature)
-                            
-                            polyline.title = StaticLayer.featureName(feature: feature)
-                            polyline.subtitle = StaticLayer.featureDescription(feature: feature)
-                            
-                            annotations.append(polyline)
-                            staticLayerMap.mapView?.addOverlay(polyline)
-                        }
-                    }
-                }
-                staticLayers[staticLayerId] = annotations
+                buildStaticLayer(staticLayerId: staticLayerId, eventId: currentEvent)
             }
             
-            if let index = unselectedStaticLayerIds.firstIndex(of: staticLayerId) {
-                unselectedStaticLayerIds.remove(at: index)
-            }
+            unselectedStaticLayerIds.removeAll { $0 == staticLayerId }
         }
         
         for unselectedStaticLayerId in unselectedStaticLayerIds {
-            if let unselectedStaticLayer = StaticLayer.mr_findFirst(byAttribute: "remoteId", withValue: unselectedStaticLayerId), let staticItems = staticLayers[unselectedStaticLayerId] {
-                print("removing the layer \(unselectedStaticLayer.name ?? "No Name") from the map")
-                for staticItem in staticItems {
-                    if let overlay = staticItem as? MKOverlay {
-                        staticLayerMap.mapView?.removeOverlay(overlay)
-                    } else if let annotation = staticItem as? MKAnnotation {
-                        staticLayerMap.mapView?.removeAnnotation(annotation)
+            removeStaticLayer(staticLayerId: unselectedStaticLayerId)
+        }
+    }
+    
+    // the features are read and turned into shapes off of the main thread, then added to the map all at once
+    func buildStaticLayer(staticLayerId: NSNumber, eventId: NSNumber) {
+        weak var mapView = staticLayerMap.mapView
+        let start = Date()
+        StaticLayerMapMixin.lastLoadId += 1
+        let loadId = StaticLayerMapMixin.lastLoadId
+        let operation = BlockOperation()
+        operation.addExecutionBlock { [weak self, weak operation] in
+            var shapes: StaticLayerShapes?
+            let context = NSManagedObjectContext.mr_context(withParent: NSManagedObjectContext.mr_rootSaving())
+            context.performAndWait {
+                guard let staticLayer = StaticLayer.mr_findFirst(with: NSPredicate(format: "remoteId == %@ AND eventId == %@", staticLayerId, eventId), in: context), let featureSequence = staticLayer.featureSequence(drawingOnly: true) else {
+                    return
+                }
+                let layerName = staticLayer.name
+                print("Adding the static layer \(layerName ?? "No Name") to the map")
+                shapes = StaticLayerShapes.build(layerName: layerName, features: featureSequence.features, isCancelled: { operation?.isCancelled ?? true }) { featuresBuilt in
+                    DispatchQueue.main.async {
+                        NotificationCenter.default.post(name: .StaticLayerLoadProgress, object: StaticLayerLoadProgressNotification(layerId: staticLayerId, loadId: loadId, layerName: layerName, featuresBuilt: featuresBuilt, featureCount: featureSequence.count, mapView: mapView))
                     }
                 }
-                staticLayers.removeValue(forKey: unselectedStaticLayerId)
+                shapes?.buildMultiResolutionShapes(isCancelled: { operation?.isCancelled ?? true })
+                context.reset()
             }
+            DispatchQueue.main.async {
+                // built or cancelled, either way the layer is no longer loading
+                NotificationCenter.default.post(name: .StaticLayerLoadProgress, object: StaticLayerLoadProgressNotification(layerId: staticLayerId, loadId: loadId, layerName: nil, featuresBuilt: 0, featureCount: 0, mapView: mapView, finished: true))
+                guard let self = self, let operation = operation, self.pendingStaticLayers[staticLayerId] === operation else {
+                    return
+                }
+                self.pendingStaticLayers.removeValue(forKey: staticLayerId)
+                guard let shapes = shapes, !operation.isCancelled else {
+                    return
+                }
+                self.staticLayerMap.mapView?.addAnnotations(shapes.annotations)
+                self.staticLayerMap.mapView?.addOverlays(shapes.overlays)
+                self.staticLayers[staticLayerId] = shapes.annotations
+                self.staticLayerOverlays[staticLayerId] = shapes.overlays
+                NSLog("TIMING Added static layer \(staticLayerId) with \(shapes.annotations.count) points and \(shapes.shapes.count) shapes as \(shapes.overlays.count) overlays. Elapsed: \(start.timeIntervalSinceNow) seconds")
+            }
+        }
+        pendingStaticLayers[staticLayerId] = operation
+        staticLayerQueue.addOperation(operation)
+    }
+    
+    func removeStaticLayer(staticLayerId: NSNumber) {
+        if let operation = pendingStaticLayers.removeValue(forKey: staticLayerId) {
+            operation.cancel()
+        }
+        guard let staticItems = staticLayers.removeValue(forKey: staticLayerId) else {
+            return
+        }
+        print("removing the layer \(staticLayerId) from the map")
+        staticLayerMap.mapView?.removeAnnotations(staticItems.compactMap { $0 as? MKAnnotation })
+        if let overlays = staticLayerOverlays.removeValue(forKey: staticLayerId) {
+            staticLayerMap.mapView?.removeOverlays(overlays)
         }
     }
     
+    // only the features near the tap are read and hit tested
     func items(at location: CLLocationCoordinate2D) -> [Any]? {
+        guard let currentEventId = Server.currentEventId(), !staticLayers.isEmpty else {
+            return []
+        }
         let screenPercentage = UserDefaults.standard.shapeScreenClickPercentage
         let tolerance = (self.staticLayerMap.mapView?.visibleMapRect.size.width ?? 0) * Double(screenPercentage)
+        let mapPoint = MKMapPoint(location)
+        let tapRect = MKMapRect(x: mapPoint.x - tolerance, y: mapPoint.y - tolerance, width: tolerance * 2, height: tolerance * 2)
         
         var annotations: [Any] = []
         
-        for (layerId, features) in staticLayers {
-            for feature in features {
-                if let polyline = feature as? StyledPolyline {
-                    if lineHitTest(lineObservation: polyline, location: location, tolerance: tolerance) {
-                        if let currentEventId = Server.currentEventId(), let staticLayer = StaticLayer.mr_findFirst(with: NSPredicate(format: "remoteId == %@ AND eventId == %@", layerId, currentEventId), in: NSManagedObjectContext.mr_default()) {
-                            annotations.append(FeatureItem(featureId: 0, featureDetail: polyline.subtitle, coordinate: location, featureTitle: polyline.title, layerName: staticLayer.name, iconURL: nil, images: nil))
-                        }
-                    }
-                } else if let polygon = feature as? StyledPolygon {
-                    if polygonHitTest(polygonObservation: polygon, location: location) {
-                        if let currentEventId = Server.currentEventId(), let staticLayer = StaticLayer.mr_findFirst(with: NSPredicate(format: "remoteId == %@ AND eventId == %@", layerId, currentEventId), in: NSManagedObjectContext.mr_default()) {
-                            annotations.append(FeatureItem(featureId: 0, featureDetail: polygon.subtitle, coordinate: location, featureTitle: polygon.title, layerName: staticLayer.name, iconURL: nil, images: nil))
-                        }
-                    }
+        let staticFeatures = StaticLayerFeature.fetchFeatures(intersecting: tapRect, layerIds: Array(staticLayers.keys), eventId: currentEventId, context: NSManagedObjectContext.mr_default())
+        for staticFeature in staticFeatures where staticFeature.featureType != "Point" {
+            guard let feature = staticFeature.drawingFeature, let shapes = StaticLayerShapes.build(layerName: nil, features: [feature]) else {
+                continue
+            }
+            for shape in shapes.shapes {
+                var onShape = false
+                if let polyline = shape as? StyledPolyline {
+                    onShape = lineHitTest(lineObservation: polyline, location: location, tolerance: tolerance)
+                } else if let polygon = shape as? StyledPolygon {
+                    onShape = polygonHitTest(polygonObservation: polygon, location: location)
+                }
+                if onShape {
+                    annotations.append(FeatureItem(featureId: 0, featureDetail: staticFeature.featureDescription, coordinate: location, featureTitle: staticFeature.name, layerName: staticFeature.staticLayer?.name, iconURL: nil, images: nil))
                 }
             }
         }
@@ -0,0 +1,312 @@
+//
+//  MultiResolutionShape.swift
+//  MAGE
+//
+//  Copyright © 2026 National Geospatial Intelligence Agency. All rights reserved.
+//
+
+import Foundation
+import MapKit
+
+/// Simplified copies of a shape's map points, one per zoom band.  At low zooms most of the
+/// vertices of a detailed shape fall within a single screen point so drawing them is wasted work.
+/// Each band is simplified with Douglas-Peucker to half a screen point at the band's zoom level
+/// and is used for every zoom at or below that level.  Above the finest band the full resolution
+/// points are drawn.  Only drawing uses the simplified points, the overlay keeps the full geometry
+/// for hit testing.
+final class MultiResolutionShape {
+    /// shapes with fewer points than this are always drawn at full resolution
+    static let minimumPointCount = 64
+    /// zoom bands from finest to coarsest
+    static let zoomBands = [16, 12, 8, 4]
+
+    private let bands: [(zoom: Int, rings: [[MKMapPoint]])]
+
+    /// rings holds the exterior points followed by any interior rings, closed rings are simplified keeping them closed
+    init?(rings: [[MKMapPoint]], closed: Bool) {
+        let pointCount = rings.reduce(0) { $0 + $1.count }
+        if pointCount < MultiResolutionShape.minimumPointCount {
+            return nil
+        }
+        var bands: [(zoom: Int, rings: [[MKMapPoint]])] = []
+        var previous = rings
+        // each band is simplified from the next finer band, the tolerance grows by 16x per band so the error stays bounded
+        for zoom in MultiResolutionShape.zoomBands {
+            let tolerance = MultiResolutionShape.tolerance(zoom: zoom)
+            let simplified = previous.map { MultiResolutionShape.simplify(points: $0, tolerance: tolerance, closed: closed) }
+            bands.append((zoom: zoom, rings: simplified))
+            previous = simplified
+        }
+        self.bands = bands
+    }
+
+    convenience init?(polyline: MKPolyline) {
+        self.init(polylines: [polyline])
+    }
+
+    convenience init?(polylines: [MKPolyline]) {
+        let rings = polylines.map { Array(UnsafeBufferPointer(start: $0.points(), count: $0.pointCount)) }
+        self.init(rings: rings, closed: false)
+    }
+
+    convenience init?(polygon: MKPolygon) {
+        self.init(polygons: [polygon])
+    }
+
+    /// the rings of every polygon are simplified on their own and drawn as one path
+    convenience init?(polygons: [MKPolygon]) {
+        var rings: [[MKMapPoint]] = []
+        for polygon in polygons {
+            rings.append(Array(UnsafeBufferPointer(start: polygon.points(), count: polygon.pointCount)))
+            for interior in polygon.interiorPolygons ?? [] {
+                rings.append(Array(UnsafeBufferPointer(start: interior.points(), count: interior.pointCount)))
+            }
+        }
+        self.init(rings: rings, closed: true)
+    }
+
+    /// Map point distance covered by half a screen point at the zoom level
+    static func tolerance(zoom: Int) -> Double {
+        return MKMapSize.world.width / (256.0 * pow(2.0, Double(zoom))) * 0.5
+    }
+
+    static func zoomLevel(zoomScale: MKZoomScale) -> Double {
+        return log2(Double(zoomScale) * MKMapSize.world.width / 256.0)
+    }
+
+    /// The coarsest band which is still accurate at this zoom scale, nil when the full resolution points should be drawn
+    func band(zoomScale: MKZoomScale) -> Int? {
+        let zoom = MultiResolutionShape.zoomLevel(zoomScale: zoomScale)
+        return bands.lastIndex { Double($0.zoom) >= zoom }
+    }
+
+    func rings(band: Int) -> [[MKMapPoint]] {
+        return bands[band].rings
+    }
+
+    func pointCount(band: Int) -> Int {
+        return bands[band].rings.reduce(0) { $0 + $1.count }
+    }
+
+    static func simplify(points: [MKMapPoint], tolerance: Double, closed: Bool) -> [MKMapPoint] {
+        let minimum = closed ? 4 : 2
+        if points.count <= minimum {
+            return points
+        }
+        var keep = [Bool](repeating: false, count: points.count)
+        keep[0] = true
+        keep[points.count - 1] = true
+        var stack: [(Int, Int)] = [(0, points.count - 1)]
+        let toleranceSquared = tolerance * tolerance
+        while let (first, last) = stack.popLast() {
+            if last - first < 2 {
+                continue
+            }
+            var maxDistance = 0.0
+            var index = first
+            for i in (first + 1)..<last {
+                let distance = distanceSquared(points[i], segmentStart: points[first], segmentEnd: points[last])
+                if distance > maxDistance {
+                    maxDistance = distance
+                    index = i
+                }
+            }
+            if maxDistance > toleranceSquared {
+                keep[index] = true
+                stack.append((first, index))
+                stack.append((index, last))
+            }
+        }
+        var simplified: [MKMapPoint] = []
+        simplified.reserveCapacity(points.count)
+        for (i, point) in points.enumerated() where keep[i] {
+            simplified.append(point)
+        }
+        if simplified.count < minimum {
+            // a ring collapsed below a triangle, keep a coarse triangle so it is still visible
+            let third = points.count / 3
+            return [points[0], points[third], points[third * 2], points[points.count - 1]]
+        }
+        return simplified
+    }
+
+    private static func distanceSquared(_ point: MKMapPoint, segmentStart: MKMapPoint, segmentEnd: MKMapPoint) -> Double {
+        let dx = segmentEnd.x - segmentStart.x
+        let dy = segmentEnd.y - segmentStart.y
+        let lengthSquared = dx * dx + dy * dy
+        if lengthSquared == 0 {
+            let px = point.x - segmentStart.x
+            let py = point.y - segmentStart.y
+            return px * px + py * py
+        }
+        let t = max(0, min(1, ((point.x - segmentStart.x) * dx + (point.y - segmentStart.y) * dy) / lengthSquared))
+        let projectedX = segmentStart.x + t * dx - point.x
+        let projectedY = segmentStart.y + t * dy - point.y
+        return projectedX * projectedX + projectedY * projectedY
+    }
+}
+
+/// Overlays which can be drawn from simplified bands
+protocol MultiResolutionOverlay: AnyObject {
+    var multiResolution: MultiResolutionShapeStorage { get }
+    /// Simplifies the overlay, blocks so call this off of the main thread
+    func buildMultiResolutionShape()
+}
+
+extension MultiResolutionOverlay {
+    /// nil until the bands are built and for shapes too small to simplify
+    var multiResolutionShape: MultiResolutionShape? {
+        return multiResolution.shape
+    }
+}
+
+/// Holds the bands of one overlay.  They are built once off of the main thread and read by the
+/// renderers from the tile drawing threads.
+final class MultiResolutionShapeStorage {
+    static let queue = DispatchQueue(label: "mil.nga.mage.multiResolutionShape", qos: .utility)
+
+    private var _shape: MultiResolutionShape?
+    private var built = false
+    private let lock = NSLock()
+
+    var shape: MultiResolutionShape? {
+        lock.lock()
+        defer { lock.unlock() }
+        return _shape
+    }
+
+    func build(_ make: () -> MultiResolutionShape?) {
+        lock.lock()
+        let alreadyBuilt = built
+        built = true
+        lock.unlock()
+        if alreadyBuilt {
+            return
+        }
+        let shape = make()
+        lock.lock()
+        _shape = shape
+        lock.unlock()
+    }
+}
+
+/// The simplified path for each band in a renderer's coordinates, draw is called from multiple tile threads
+final class MultiResolutionPaths {
+    private let storage: MultiResolutionShapeStorage
+    private let closed: Bool
+    private var paths: [Int: CGPath] = [:]
+    private let lock = NSLock()
+
+    init(storage: MultiResolutionShapeStorage, closed: Bool) {
+        self.storage = storage
+        self.closed = closed
+    }
+
+    /// nil when the full resolution path should be drawn
+    func path(zoomScale: MKZoomScale, point: (MKMapPoint) -> CGPoint) -> CGPath? {
+        guard let shape = storage.shape, let band = shape.band(zoomScale: zoomScale) else {
+            return nil
+        }
+        lock.lock()
+        defer { lock.unlock() }
+        if let path = paths[band] {
+            return path
+        }
+        let path = CGMutablePath()
+        for ring in shape.rings(band: band) {
+            path.addLines(between: ring.map(point))
+            if closed {
+                path.closeSubpath()
+            }
+        }
+        paths[band] = path
+        return path
+    }
+}
+
+extension MKOverlayPathRenderer {
+    func drawSimplified(path: CGPath, zoomScale: MKZoomScale, in context: CGContext) {
+        if fillColor != nil {
+            context.addPath(path)
+            applyFillProperties(to: context, atZoomScale: zoomScale)
+            context.fillPath(using: .evenOdd)
+        }
+        if strokeColor != nil {
+            context.addPath(path)
+            applyStrokeProperties(to: context, atZoomScale: zoomScale)
+            context.strokePath()
+        }
+    }
+}
+
+/// Draws the simplified points for the current zoom band, the path used for hit testing is the full polyline
+class MultiResolutionPolylineRenderer: MKPolylineRenderer {
+    private let paths: MultiResolutionPaths
+
+    init(polyline: MKPolyline & MultiResolutionOverlay) {
+        paths = MultiResolutionPaths(storage: polyline.multiResolution, closed: false)
+        super.init(overlay: polyline)
+    }
+
+    override func draw(_ mapRect: MKMapRect, zoomScale: MKZoomScale, in context: CGContext) {
+        guard let path = paths.path(zoomScale: zoomScale, point: point(for:)) else {
+            super.draw(mapRect, zoomScale: zoomScale, in: context)
+            return
+        }
+        drawSimplified(path: path, zoomScale: zoomScale, in: context)
+    }
+}
+
+/// Fills and strokes the simplified rings for the current zoom band, the path used for hit testing is the full polygon
+class MultiResolutionPolygonRenderer: MKPolygonRenderer {
+    private let paths: MultiResolutionPaths
+
+    init(polygon: MKPolygon & MultiResolutionOverlay) {
+        paths = MultiResolutionPaths(storage: polygon.multiResolution, closed: true)
+        super.init(overlay: polygon)
+    }
+
+    override func draw(_ mapRect: MKMapRect, zoomScale: MKZoomScale, in context: CGContext) {
+        guard let path = paths.path(zoomScale: zoomScale, point: point(for:)) else {
+            super.draw(mapRect, zoomScale: zoomScale, in: context)
+            return
+        }
+        drawSimplified(path: path, zoomScale: zoomScale, in: context)
+    }
+}
+
+/// Draws the simplified points of all of the lines for the current zoom band
+class MultiResolutionMultiPolylineRenderer: MKMultiPolylineRenderer {
+    private let paths: MultiResolutionPaths
+
+    init(multiPolyline: MKMultiPolyline & MultiResolutionOverlay) {
+        paths = MultiResolutionPaths(storage: multiPolyline.multiResolution, closed: false)
+        super.init(overlay: multiPolyline)
+    }
+
+    override func draw(_ mapRect: MKMapRect, zoomScale: MKZoomScale, in context: CGContext) {
+        guard let path = paths.path(zoomScale: zoomScale, point: point(for:)) else {
+            super.draw(mapRect, zoomScale: zoomScale, in: context)
+            return
+        }
+        drawSimplified(path: path, zoomScale: zoomScale, in: context)
+    }
+}
+
+/// Fills and strokes the simplified rings of all of the polygons for the current zoom band
+class MultiResolutionMultiPolygonRenderer: MKMultiPolygonRenderer {
+    private let paths: MultiResolutionPaths
+
+    init(multiPolygon: MKMultiPolygon & MultiResolutionOverlay) {
+        paths = MultiResolutionPaths(storage: multiPolygon.multiResolution, closed: true)
+        super.init(overlay: multiPolygon)
+    }
+
+    override func draw(_ mapRect: MKMapRect, zoomScale: MKZoomScale, in context: CGContext) {
+        guard let path = paths.path(zoomScale: zoomScale, point: point(for:)) else {
+            super.draw(mapRect, zoomScale: zoomScale, in: context)
+            return
+        }
+        drawSimplified(path: path, zoomScale: zoomScale, in: context)
+    }
+}
@@ -14,6 +14,18 @@ struct MapAnnotationFocusedNotification {
     var mapView: MKMapView?
 }
 
+struct StaticLayerLoadProgressNotification {
+    var layerId: NSNumber
+    /// increases with every load of a layer, a load with a lower id was superseded
+    var loadId: Int
+    var layerName: String?
+    var featuresBuilt: Int
+    var featureCount: Int
+    var mapView: MKMapView?
+    /// the layer was added to the map or its build was cancelled
+    var finished: Bool = false
+}
+
 struct MapItemsTappedNotification {
     var annotations: [Any]?
     var items: [Any]?
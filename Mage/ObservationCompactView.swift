@@ -81,20 +81,23 @@ class ObservationCompactView: UIView {
     }
     
     @objc public func configure(observation: Observation, scheme: MDCContainerScheming?, actionsDelegate: ObservationActionsDelegate?, attachmentSelectionDelegate: AttachmentSelectionDelegate?) {
+        configure(observation: observation, displayModel: ObservationDisplayModelCache.shared.freshModel(for: observation), scheme: scheme, actionsDelegate: actionsDelegate, attachmentSelectionDelegate: attachmentSelectionDelegate);
+    }
+    
+    /// Binds the display model, the observation is only read when there are attachments to show
+    func configure(observation: Observation, displayModel: ObservationDisplayModel, scheme: MDCContainerScheming?, actionsDelegate: ObservationActionsDelegate?, attachmentSelectionDelegate: AttachmentSelectionDelegate?) {
         self.observation = observation;
         self.actionsDelegate = actionsDelegate;
-        if (observation.isImportant) {
-            importantView.populate(observation: observation);
+        if (displayModel.isImportant) {
+            importantView.populate(displayModel: displayModel);
             importantView.isHidden = false;
         } else {
             importantView.isHidden = true;
         }
-        observationSummaryView.populate(observation: observation);
-        observationActionsView.populate(observation: observation, delegate: actionsDelegate);
+        observationSummaryView.populate(displayModel: displayModel);
+        observationActionsView.populate(observation: observation, displayModel: displayModel, delegate: actionsDelegate);
         attachmentSlideshow.applyTheme(withScheme: scheme)
-        if includeAttachments, let attachments = observation.attachments, attachments.filter({ attachment in
-            attachment.url != nil
-        }).count > 0 {
+        if includeAttachments, displayModel.attachmentCount > 0 {
             attachmentSlideshow.populate(observation: observation, attachmentSelectionDelegate: attachmentSelectionDelegate);
             attachmentSlideshow.isHidden = false;
         } else {
@@ -16,6 +16,10 @@ class ObservationDataStore: NSObject {
     weak var observationActionsDelegate: ObservationActionsDelegate?;
     weak var attachmentSelectionDelegate: AttachmentSelectionDelegate?;
     var emptyView: UIView?
+    let timeWindow = TimeWindowedList(field: "timestamp")
+    var timeFiltered = false
+    var refetchOnChange = false
+    let prefetchCoordinator = ListPrefetchCoordinator()
     
     public init(tableView: UITableView, observationActionsDelegate: ObservationActionsDelegate?, attachmentSelectionDelegate: AttachmentSelectionDelegate?, emptyView: UIView? = nil, scheme: MDCContainerScheming?) {
         self.scheme = scheme;
@@ -26,6 +30,7 @@ class ObservationDataStore: NSObject {
         super.init();
         self.tableView.dataSource = self;
         self.tableView.delegate = self;
+        self.tableView.prefetchDataSource = self;
     }
     
     func applyTheme(withContainerScheme containerScheme: MDCContainerScheming?) {
@@ -38,9 +43,12 @@ class ObservationDataStore: NSObject {
         } else {
             self.observations = observations;
         }
+        self.prefetchCoordinator.cancelAll();
+        self.timeFiltered = observations == nil;
         self.observations?.delegate = self;
         do {
             try self.observations?.fetchedResultsController.performFetch()
+            self.timeWindow.reset(windowStart: timeFiltered ? TimeFilter.getObservationTimeFilterStartDate() : nil);
         } catch {
             print("Error fetching observations \(error) \(error.localizedDescription)")
         }
@@ -48,25 +56,41 @@ class ObservationDataStore: NSObject {
     }
     
     func updatePredicates() {
+        self.prefetchCoordinator.cancelAll();
         self.observations?.fetchedResultsController.fetchRequest.predicate = NSCompoundPredicate(andPredicateWithSubpredicates: Observations.getPredicatesForObservations() as! [NSPredicate]);
         do {
             try self.observations?.fetchedResultsController.performFetch()
+            self.timeWindow.reset(windowStart: timeFiltered ? TimeFilter.getObservationTimeFilterStartDate() : nil);
         } catch {
             print("Error fetching observations \(error) \(error.localizedDescription)")
         }
         self.tableView.reloadData();
     }
+    
+    /// Remove the observations which have aged out of a relative time filter since the last advance without fetching them all again
+    func advanceTimeWindow() {
+        guard timeFiltered, !refetchOnChange else {
+            return;
+        }
+        let changes = timeWindow.advance(to: TimeFilter.getObservationTimeFilterStartDate(), controller: self.observations?.fetchedResultsController);
+        if changes.sections.isEmpty && changes.rows.isEmpty {
+            return;
+        }
+        self.tableView.performBatchUpdates {
+            self.tableView.deleteSections(changes.sections, with: .fade);
+            self.tableView.deleteRows(at: changes.rows, with: .fade);
+        }
+    }
 }
 
 extension ObservationDataStore: UITableViewDataSource {
     
     func tableView(_ tableView: UITableView, numberOfRowsInSection section: Int) -> Int {
-        let sectionInfo: NSFetchedResultsSectionInfo? = self.observations?.fetchedResultsController.sections?[section];
-        return sectionInfo?.numberOfObjects ?? 0;
+        return timeWindow.numberOfRows(inSection: section, controller: self.observations?.fetchedResultsController);
     }
     
     func numberOfSections(in tableView: UITableView) -> Int {
-        let number = self.observations?.fetchedResultsController.sections?.count ?? 0
+        let number = timeWindow.numberOfSections(controller: self.observations?.fetchedResultsController)
         if number == 0 {
             tableView.backgroundView = emptyView
         } else {
@@ -81,14 +105,56 @@ extension ObservationDataStore: UITableViewDataSource {
         return cell;
     }
     
+    /// The observations of the rows which are still in the list
+    func objectIDs(at indexPaths: [IndexPath]) -> [NSManagedObjectID] {
+        guard let controller = self.observations?.fetchedResultsController else {
+            return [];
+        }
+        let numberOfSections = timeWindow.numberOfSections(controller: controller);
+        return indexPaths.compactMap { indexPath in
+            guard indexPath.section < numberOfSections, indexPath.row < timeWindow.numberOfRows(inSection: indexPath.section, controller: controller) else {
+                return nil;
+            }
+            return (controller.object(at: indexPath) as? NSManagedObject)?.objectID;
+        }
+    }
+    
     func configure(cell: ObservationListCardCell, at indexPath: IndexPath) {
         let observation: Observation = self.observations?.fetchedResultsController.object(at: indexPath) as! Observation;
         cell.configure(observation: observation, scheme: scheme, actionsDelegate: observationActionsDelegate, attachmentSelectionDelegate: attachmentSelectionDelegate)
     }
 }
 
+extension ObservationDataStore: UITableViewDataSourcePrefetching {
+    
+    func tableView(_ tableView: UITableView, prefetchRowsAt indexPaths: [IndexPath]) {
+        let objectIDs = objectIDs(at: indexPaths);
+        prefetchCoordinator.request(objectIDs: objectIDs);
+        // the slideshow is as wide as the card and thumbnails are cached under the same key whatever size is asked for
+        let size = Int(max(tableView.bounds.width, 150) * UIScreen.main.scale);
+        let allowDownloads = DataConnectionUtilities.shouldFetchAttachments();
+        ObservationDisplayModelCache.shared.warm(objectIDs: objectIDs) { [weak self] models in
+            for model in models where !model.thumbnailUrls.isEmpty {
+                let resources = model.thumbnailUrls.compactMap { ListPrefetchCoordinator.thumbnailResource(attachmentUrl: $0, size: size) };
+                self?.prefetchCoordinator.prefetch(objectID: model.objectID, resources: resources, allowDownloads: allowDownloads);
+            }
+        }
+    }
+    
+    func tableView(_ tableView: UITableView, cancelPrefetchingForRowsAt indexPaths: [IndexPath]) {
+        prefetchCoordinator.cancel(objectIDs: objectIDs(at: indexPaths));
+    }
+}
+
 extension ObservationDataStore: UITableViewDelegate {
     
+    func tableView(_ tableView: UITableView, didEndDisplaying cell: UITableViewCell, forRowAt indexPath: IndexPath) {
+        // the index path may already point at another row after an update
+        if let objectID = (cell as? ObservationListCardCell)?.observationObjectID {
+            prefetchCoordinator.cancel(objectIDs: [objectID]);
+        }
+    }
+    
     func tableView(_ tableView: UITableView, heightForFooterInSection section: Int) -> CGFloat {
         return CGFloat.leastNormalMagnitude;
     }
@@ -106,13 +172,16 @@ extension ObservationDataStore: UITableViewDelegate {
             return nil;
         }
         
-        return ObservationTableHeaderView(name: sectionInfo.name, andScheme: self.scheme);
+        return ObservationTableHeaderView(name: ObservationDaySection.title(sectionName: sectionInfo.name), andScheme: self.scheme);
     }
 }
 
 extension ObservationDataStore: NSFetchedResultsControllerDelegate {
     
     func controller(_ controller: NSFetchedResultsController<NSFetchRequestResult>, didChange anObject: Any, at indexPath: IndexPath?, for type: NSFetchedResultsChangeType, newIndexPath: IndexPath?) {
+        if refetchOnChange {
+            return;
+        }
         switch type {
         case .insert:
             if let insertIndexPath = newIndexPath {
@@ -125,6 +194,9 @@ extension ObservationDataStore: NSFetchedResultsControllerDelegate {
             }
             break;
         case .update:
+            if let observation = anObject as? Observation {
+                ObservationDisplayModelCache.shared.invalidate(objectIDs: [observation.objectID]);
+            }
             if let updateIndexPath = indexPath {
                 self.tableView.reloadRows(at: [updateIndexPath], with: .none);
             }
@@ -143,6 +215,9 @@ extension ObservationDataStore: NSFetchedResultsControllerDelegate {
     }
     
     func controller(_ controller: NSFetchedResultsController<NSFetchRequestResult>, didChange sectionInfo: NSFetchedResultsSectionInfo, atSectionIndex sectionIndex: Int, for type: NSFetchedResultsChangeType) {
+        if refetchOnChange {
+            return;
+        }
         switch type {
         case .insert:
             self.tableView.insertSections(IndexSet(integer: sectionIndex), with: .fade);
@@ -156,10 +231,25 @@ extension ObservationDataStore: NSFetchedResultsControllerDelegate {
     }
     
     func controllerDidChangeContent(_ controller: NSFetchedResultsController<NSFetchRequestResult>) {
+        self.timeWindow.invalidate();
+        if refetchOnChange {
+            // the index paths of the change include rows hidden by the time window, fetch again instead
+            DispatchQueue.main.async { [weak self] in
+                self?.refetchOnChange = false;
+                self?.updatePredicates();
+            }
+            return;
+        }
         self.tableView.endUpdates();
     }
     
     func controllerWillChangeContent(_ controller: NSFetchedResultsController<NSFetchRequestResult>) {
+        if timeWindow.hiddenCount > 0 {
+            refetchOnChange = true;
+        }
+        if refetchOnChange {
+            return;
+        }
         self.tableView.beginUpdates();
     }
 }
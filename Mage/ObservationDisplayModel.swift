@@ -0,0 +1,339 @@
+//
+//  ObservationDisplayModel.swift
+//  MAGE
+//
+//  Copyright © 2026 National Geospatial Intelligence Agency. All rights reserved.
+//
+
+import Foundation
+import CoreData
+import CoreLocation
+import UIKit
+import MagicalRecord
+
+/// Everything an observation card shows, read from the observation once so binding a cell does
+/// not fault the properties, the form or the relationships of the observation on the main thread.
+/// Models never change, a changed observation gets a new model.
+final class ObservationDisplayModel {
+    let objectID: NSManagedObjectID
+    /// The version of the observation in the cache the model was made for
+    let version: Int
+    let primaryText: String?
+    let secondaryText: String?
+    let userObjectID: NSManagedObjectID?
+    let userName: String?
+    /// The user name and the timestamp as the summary shows them
+    let timestampText: String
+    let iconPath: String?
+    let hasError: Bool
+    let hasValidationError: Bool
+    let isImportant: Bool
+    let importantFlaggedBy: String?
+    let importantReason: String?
+    let coordinate: CLLocationCoordinate2D?
+    let favoriteCount: Int
+    let currentUserFavorited: Bool
+    /// Attachments which have been uploaded and can be shown in the slideshow
+    let attachmentCount: Int
+    /// The urls of the uploaded images which are not on the device, their thumbnails are downloaded for the slideshow
+    let thumbnailUrls: [String]
+
+    /// Formats like formattedDisplayDate, each queue making models needs its own formatter
+    static func makeTimestampFormatter() -> DateFormatter {
+        let formatter = DateFormatter()
+        formatter.dateFormat = "yyyy-MM-dd HH:mm zzz"
+        return formatter
+    }
+
+    init(observation: Observation, version: Int = 0, formatter: DateFormatter) {
+        objectID = observation.objectID
+        self.version = version
+        primaryText = observation.primaryFeedFieldText
+        secondaryText = observation.secondaryFeedFieldText
+        userObjectID = observation.user?.objectID
+        userName = observation.user?.name
+        // we do not want the date to word break so we replace all spaces with a non word breaking spaces
+        var timeText = ""
+        if let timestamp = observation.timestamp {
+            formatter.timeZone = NSDate.isDisplayGMT() ? TimeZone(secondsFromGMT: 0) : TimeZone.current
+            timeText = formatter.string(from: timestamp).uppercased().replacingOccurrences(of: " ", with: "\u{00a0}")
+        }
+        timestampText = "\(userName?.uppercased() ?? "") \u{2022} \(timeText)"
+        iconPath = ObservationImage.imageName(observation: observation)
+        hasError = observation.error != nil
+        hasValidationError = observation.hasValidationError
+
+        isImportant = observation.isImportant
+        if isImportant, let important = observation.observationImportant {
+            if let userId = important.userId, let context = observation.managedObjectContext {
+                let user = User.mr_findFirst(byAttribute: "remoteId", withValue: userId, in: context)
+                importantFlaggedBy = "Flagged By \(user?.name ?? "")".uppercased()
+            } else {
+                importantFlaggedBy = nil
+            }
+            importantReason = important.reason
+        } else {
+            importantFlaggedBy = nil
+            importantReason = nil
+        }
+
+        if let point = observation.geometry?.centroid() {
+            coordinate = CLLocationCoordinate2D(latitude: point.y.doubleValue, longitude: point.x.doubleValue)
+        } else {
+            coordinate = nil
+        }
+
+        let currentUserId = UserDefaults.standard.currentUserId
+        var favoriteCount = 0
+        var currentUserFavorited = false
+        for favorite in observation.favorites ?? [] where favorite.favorite {
+            favoriteCount += 1
+            if currentUserId != nil && favorite.userId == currentUserId {
+                currentUserFavorited = true
+            }
+        }
+        self.favoriteCount = favoriteCount
+        self.currentUserFavorited = currentUserFavorited
+        let uploaded = observation.attachments?.filter { $0.url != nil } ?? []
+        attachmentCount = uploaded.count
+        thumbnailUrls = uploaded.compactMap { attachment in
+            guard attachment.contentType?.hasPrefix("image") ?? false else {
+                return nil
+            }
+            if let localPath = attachment.localPath, FileManager.default.fileExists(atPath: localPath) {
+                return nil
+            }
+            return attachment.url
+        }
+    }
+}
+
+/// Display models keyed by observation id.  Every observation has a version which goes up when a
+/// save changes the observation, its favorites, its important flag or its attachments, and a model
+/// is only handed out while its version is current.  Saving a form or fetching new form icons empties
+/// the cache.  Models can be made ahead of time on a private context so the rows about to scroll in
+/// are ready before they are bound.
+@objc public class ObservationDisplayModelCache: NSObject {
+
+    @objc public static let shared = ObservationDisplayModelCache()
+
+    static let relatedEntityNames: Set<String> = ["ObservationFavorite", "ObservationImportant", "Attachment"]
+
+    private let cache = NSCache<NSManagedObjectID, ObservationDisplayModel>()
+    private let lock = NSLock()
+    private let warmQueue = DispatchQueue(label: "mil.nga.giat.mage.observationDisplayModelCache.warm", qos: .userInitiated)
+    private lazy var mainFormatter = ObservationDisplayModel.makeTimestampFormatter()
+    private lazy var warmFormatter = ObservationDisplayModel.makeTimestampFormatter()
+    // every version handed out is a new value of the counter so a version never comes back.  Observations
+    // which were not invalidated since the cache was last emptied are at the floor.
+    private var counter = 0
+    private var floor = 0
+    private var versions: [NSManagedObjectID: Int] = [:]
+    // the user names the cached models show
+    private var userNames: [NSManagedObjectID: String] = [:]
+    private var observers: [AnyObject] = []
+
+    init(countLimit: Int = 2000) {
+        super.init()
+        cache.countLimit = countLimit
+        observers.append(NotificationCenter.default.addObserver(forName: .NSManagedObjectContextDidSave, object: nil, queue: nil) { [weak self] notification in
+            self?.invalidate(notification: notification)
+        })
+        // changes merged into the main context, models made on the main thread before the merge are out of date
+        observers.append(NotificationCenter.default.addObserver(forName: .NSManagedObjectContextObjectsDidChange, object: nil, queue: nil) { [weak self] notification in
+            guard let context = notification.object as? NSManagedObjectContext, context.concurrencyType == .mainQueueConcurrencyType, context === NSManagedObjectContext.mr_default() else {
+                return
+            }
+            self?.invalidate(notification: notification)
+        })
+        observers.append(NotificationCenter.default.addObserver(forName: .NSSystemTimeZoneDidChange, object: nil, queue: nil) { [weak self] _ in
+            self?.removeAll()
+        })
+        observers.append(NotificationCenter.default.addObserver(forName: UIApplication.didReceiveMemoryWarningNotification, object: nil, queue: nil) { [weak self] _ in
+            self?.removeAll()
+        })
+    }
+
+    deinit {
+        for observer in observers {
+            NotificationCenter.default.removeObserver(observer)
+        }
+    }
+
+    func version(of objectID: NSManagedObjectID) -> Int {
+        lock.lock()
+        defer { lock.unlock() }
+        return versions[objectID] ?? floor
+    }
+
+    /// The current model of the observation, made from it on the main thread when there is none.  Call this on the main thread.
+    func model(for observation: Observation) -> ObservationDisplayModel {
+        let objectID = observation.objectID
+        // temporary ids change when the observation is saved, make the model without caching it
+        if objectID.isTemporaryID {
+            return freshModel(for: observation)
+        }
+        let version = self.version(of: objectID)
+        if let model = cache.object(forKey: objectID), model.version == version {
+            return model
+        }
+        let model = ObservationDisplayModel(observation: observation, version: version, formatter: mainFormatter)
+        store(model)
+        return model
+    }
+
+    /// A model made from the observation as it is now, for views which show one observation and have to reflect edits
+    /// right away.  Call this on the main thread.
+    func freshModel(for observation: Observation) -> ObservationDisplayModel {
+        return ObservationDisplayModel(observation: observation, formatter: mainFormatter)
+    }
+
+    /// The cached model if it is current
+    func cachedModel(for objectID: NSManagedObjectID) -> ObservationDisplayModel? {
+        guard let model = cache.object(forKey: objectID), model.version == version(of: objectID) else {
+            return nil
+        }
+        return model
+    }
+
+    /// Make the models which are not current in the background along with their icons.  The completion is called on the
+    /// main queue with the models of the objects, whether they were cached already or just made.
+    func warm(objectIDs: [NSManagedObjectID], completion: (([ObservationDisplayModel]) -> Void)? = nil) {
+        var models: [ObservationDisplayModel] = []
+        var missing: [NSManagedObjectID] = []
+        for objectID in objectIDs where !objectID.isTemporaryID {
+            if let model = cachedModel(for: objectID) {
+                models.append(model)
+            } else {
+                missing.append(objectID)
+            }
+        }
+        guard !missing.isEmpty, let coordinator = NSManagedObjectContext.mr_default().persistentStoreCoordinator else {
+            if let completion = completion {
+                DispatchQueue.main.async {
+                    completion(models)
+                }
+            }
+            return
+        }
+        warmQueue.async { [weak self] in
+            let made = self?.makeModels(objectIDs: missing, coordinator: coordinator) ?? []
+            if let completion = completion {
+                DispatchQueue.main.async {
+                    completion(models + made)
+                }
+            }
+        }
+    }
+
+    /// Blocks until the models queued to be made have been made
+    func waitUntilWarmed() {
+        warmQueue.sync {}
+    }
+
+    @objc public func removeAll() {
+        lock.lock()
+        counter += 1
+        floor = counter
+        versions.removeAll()
+        userNames.removeAll()
+        lock.unlock()
+        cache.removeAllObjects()
+    }
+
+    func invalidate(objectIDs: [NSManagedObjectID]) {
+        guard !objectIDs.isEmpty else {
+            return
+        }
+        lock.lock()
+        for objectID in objectIDs {
+            counter += 1
+            versions[objectID] = counter
+        }
+        lock.unlock()
+        for objectID in objectIDs {
+            cache.removeObject(forKey: objectID)
+        }
+    }
+
+    private func store(_ model: ObservationDisplayModel) {
+        lock.lock()
+        // changed while it was being made
+        guard (versions[model.objectID] ?? floor) == model.version else {
+            lock.unlock()
+            return
+        }
+        if let userObjectID = model.userObjectID, let userName = model.userName {
+            userNames[userObjectID] = userName
+        }
+        lock.unlock()
+        cache.setObject(model, forKey: model.objectID)
+    }
+
+    // only called on the warm queue
+    private func makeModels(objectIDs: [NSManagedObjectID], coordinator: NSPersistentStoreCoordinator) -> [ObservationDisplayModel] {
+        let start = Date()
+        var models: [ObservationDisplayModel] = []
+        let versions = Dictionary(uniqueKeysWithValues: objectIDs.map { ($0, version(of: $0)) })
+        let context = NSManagedObjectContext(concurrencyType: .privateQueueConcurrencyType)
+        context.persistentStoreCoordinator = coordinator
+        context.performAndWait {
+            let fetchRequest = Observation.fetchRequest()
+            fetchRequest.predicate = NSPredicate(format: "self IN %@", objectIDs)
+            fetchRequest.relationshipKeyPathsForPrefetching = ["user", "observationImportant", "favorites", "attachments"]
+            let observations = (try? context.fetch(fetchRequest)) ?? []
+            for observation in observations {
+                autoreleasepool {
+                    let model = ObservationDisplayModel(observation: observation, version: versions[observation.objectID] ?? 0, formatter: warmFormatter)
+                    store(model)
+                    models.append(model)
+                    // scale and decode the icon now rather than when the row is bound
+                    if let iconPath = model.iconPath {
+                        _ = AnnotationImageCache.shared.image(path: iconPath, width: CGFloat(ObservationImage.annotationScaleWidth))
+                    }
+                }
+            }
+            context.reset()
+        }
+        NSLog("TIMING Made \(objectIDs.count) observation display models. Elapsed: \(start.timeIntervalSinceNow) seconds")
+        return models
+    }
+
+    // called on the queue of the context which changed so the changed objects can be read
+    private func invalidate(notification: Notification) {
+        var changed: [NSManagedObjectID] = []
+        var removeAll = false
+        for key in [NSInsertedObjectsKey, NSUpdatedObjectsKey, NSDeletedObjectsKey, NSRefreshedObjectsKey] {
+            guard let objects = notification.userInfo?[key] as? Set<NSManagedObject> else {
+                continue
+            }
+            for object in objects {
+                if object is Observation {
+                    changed.append(object.objectID)
+                } else if object is Form {
+                    // the primary and secondary fields of any observation of the form may have changed
+                    removeAll = true
+                } else if let entityName = object.entity.name, ObservationDisplayModelCache.relatedEntityNames.contains(entityName) {
+                    if let observationID = object.objectIDs(forRelationshipNamed: "observation").first {
+                        changed.append(observationID)
+                    } else if key == NSDeletedObjectsKey {
+                        // no way to tell which observation it belonged to
+                        removeAll = true
+                    }
+                } else if let user = object as? User, key == NSUpdatedObjectsKey || key == NSRefreshedObjectsKey {
+                    lock.lock()
+                    let shownName = userNames[user.objectID]
+                    lock.unlock()
+                    if let shownName = shownName, shownName != user.name {
+                        removeAll = true
+                    }
+                }
+            }
+        }
+        if removeAll {
+            self.removeAll()
+        } else {
+            invalidate(objectIDs: changed)
+        }
+    }
+}
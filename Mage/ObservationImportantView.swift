@@ -76,4 +76,13 @@ class ObservationImportantView: UIView {
         }
         
     }
+    
+    func populate(displayModel: ObservationDisplayModel) {
+        if let flaggedBy = displayModel.importantFlaggedBy {
+            flaggedByLabel.text = flaggedBy;
+        }
+        if let reason = displayModel.importantReason {
+            reasonLabel.text = reason;
+        }
+    }
 }
@@ -114,39 +114,24 @@ class ObservationListActionsView: UIView {
     }
     
     public func populate(observation: Observation!, delegate: ObservationActionsDelegate?) {
+        populate(observation: observation, displayModel: ObservationDisplayModelCache.shared.freshModel(for: observation), delegate: delegate);
+    }
+    
+    /// The observation is only kept for the actions, everything shown comes from the display model
+    func populate(observation: Observation?, displayModel: ObservationDisplayModel, delegate: ObservationActionsDelegate?) {
         self.observation = observation;
         self.observationActionsDelegate = delegate;
-        if let geometry = self.observation?.geometry {
-            if let point: SFPoint = geometry.centroid() {
-                let coordinate = CLLocationCoordinate2D(latitude: point.y.doubleValue, longitude: point.x.doubleValue)
-                latitudeLongitudeButton.coordinate = coordinate
-            }
-        } else {
-            latitudeLongitudeButton.coordinate = nil
-        }
+        latitudeLongitudeButton.coordinate = displayModel.coordinate
         
-        currentUserFavorited = false;
-        var favoriteCounter = 0;
-        if let favorites = observation.favorites {
-            if let user = User.fetchCurrentUser(context: NSManagedObjectContext.mr_default()) {
-                currentUserFavorited = favorites.contains { (favorite) -> Bool in
-                    return favorite.userId == user.remoteId && favorite.favorite;
-                }
-            }
-            if (currentUserFavorited) {
-                favoriteButton.setImage(UIImage(systemName: "heart.fill", withConfiguration: UIImage.SymbolConfiguration(weight: .semibold)), for: .normal);
-            } else {
-                favoriteButton.setImage(UIImage(systemName: "heart", withConfiguration: UIImage.SymbolConfiguration(weight: .semibold)), for: .normal);
-            }
-            favorites.forEach { favorite in
-                if (favorite.favorite) {
-                    favoriteCounter = favoriteCounter + 1
-                }
-            }
+        currentUserFavorited = displayModel.currentUserFavorited;
+        if (currentUserFavorited) {
+            favoriteButton.setImage(UIImage(systemName: "heart.fill", withConfiguration: UIImage.SymbolConfiguration(weight: .semibold)), for: .normal);
+        } else {
+            favoriteButton.setImage(UIImage(systemName: "heart", withConfiguration: UIImage.SymbolConfiguration(weight: .semibold)), for: .normal);
         }
         
-        if (favoriteCounter != 0) {
-            favoriteCount.text = "\(favoriteCounter)"
+        if (displayModel.favoriteCount != 0) {
+            favoriteCount.text = "\(displayModel.favoriteCount)"
         } else {
             favoriteCount.text = nil;
         }
@@ -14,6 +14,10 @@ import MaterialComponents.MDCCard;
     private var constructed = false;
     private var didSetUpConstraints = false;
     private var observation: Observation?;
+    
+    var observationObjectID: NSManagedObjectID? {
+        return observation?.objectID;
+    }
     private weak var actionsDelegate: ObservationActionsDelegate?;
     
     private lazy var card: MDCCard = {
@@ -57,11 +61,15 @@ import MaterialComponents.MDCCard;
     }
     
     @objc public func configure(observation: Observation, scheme: MDCContainerScheming?, actionsDelegate: ObservationActionsDelegate?, attachmentSelectionDelegate: AttachmentSelectionDelegate?) {
+        configure(observation: observation, displayModel: ObservationDisplayModelCache.shared.model(for: observation), scheme: scheme, actionsDelegate: actionsDelegate, attachmentSelectionDelegate: attachmentSelectionDelegate);
+    }
+    
+    func configure(observation: Observation, displayModel: ObservationDisplayModel, scheme: MDCContainerScheming?, actionsDelegate: ObservationActionsDelegate?, attachmentSelectionDelegate: AttachmentSelectionDelegate?) {
         self.observation = observation;
-        card.accessibilityLabel = "observation card \(observation.objectID.uriRepresentation().absoluteString)"
+        card.accessibilityLabel = "observation card \(displayModel.objectID.uriRepresentation().absoluteString)"
         self.actionsDelegate = actionsDelegate;
         
-        compactView.configure(observation: observation, scheme: scheme, actionsDelegate: actionsDelegate, attachmentSelectionDelegate: attachmentSelectionDelegate);
+        compactView.configure(observation: observation, displayModel: displayModel, scheme: scheme, actionsDelegate: actionsDelegate, attachmentSelectionDelegate: attachmentSelectionDelegate);
         
         applyTheme(withScheme: scheme);
     }
@@ -9,28 +9,38 @@
 #import <Foundation/Foundation.h>
 
 /**
- * Observation shape style for lines and polygons including stroke width, stroke color, and fill color
+ * Observation shape style for lines and polygons including stroke width, stroke color, and fill color.
+ * Styles are immutable so one instance can be shared by every shape drawn with it.
  */
 @interface ObservationShapeStyle : NSObject
 
 /**
  * Line width for lines and polygons
  */
-@property (nonatomic) CGFloat lineWidth;
+@property (nonatomic, readonly) CGFloat lineWidth;
 
 /**
  * Stroke color for lines and polygons
  */
-@property (nonatomic) UIColor *strokeColor;
+@property (nonatomic, readonly) UIColor *strokeColor;
 
 /**
  * Fill color for polygons
  */
-@property (nonatomic) UIColor *fillColor;
+@property (nonatomic, readonly) UIColor *fillColor;
 
 /**
- * Initializer
+ * Initializer using the default line and fill styles from the user defaults
  */
 - (id)init;
 
+/**
+ * Initializer
+ *
+ * @param lineWidth line width in pixels
+ * @param strokeColor stroke color
+ * @param fillColor fill color
+ */
+- (id)initWithLineWidth: (CGFloat) lineWidth strokeColor: (UIColor *) strokeColor fillColor: (UIColor *) fillColor;
+
 @end
@@ -13,18 +13,20 @@
 @implementation ObservationShapeStyle
 
 -(id) init{
+    NSUserDefaults *defaults = [NSUserDefaults standardUserDefaults];
+    return [self initWithLineWidth:[defaults floatForKey:@"fill_default_line_width"]
+                       strokeColor:[UIColor hx_colorWithHexRGBAString:[defaults stringForKey:@"line_default_color"] alpha:[defaults integerForKey:@"line_default_color_alpha"] / 255.0]
+                         fillColor:[UIColor hx_colorWithHexRGBAString:[defaults stringForKey:@"fill_default_color"] alpha:[defaults integerForKey:@"fill_default_color_alpha"] / 255.0]];
+}
+
+-(id) initWithLineWidth: (CGFloat) lineWidth strokeColor: (UIColor *) strokeColor fillColor: (UIColor *) fillColor{
     self = [super init];
     if(self != nil){
-        NSUserDefaults *defaults = [NSUserDefaults standardUserDefaults];
-        [self setLineWidth:[defaults floatForKey:@"fill_default_line_width"]];
-        [self setStrokeColor:[UIColor hx_colorWithHexRGBAString:[defaults stringForKey:@"line_default_color"] alpha:[defaults integerForKey:@"line_default_color_alpha"] / 255.0]];
-        [self setFillColor:[UIColor hx_colorWithHexRGBAString:[defaults stringForKey:@"fill_default_color"] alpha:[defaults integerForKey:@"fill_default_color_alpha"] / 255.0]];
+        _lineWidth = lineWidth / [[UIScreen mainScreen] scale];
+        _strokeColor = strokeColor;
+        _fillColor = fillColor;
     }
     return self;
 }
 
--(void) setLineWidth:(CGFloat)lineWidth{
-    _lineWidth = lineWidth / [[UIScreen mainScreen] scale];
-}
-
 @end
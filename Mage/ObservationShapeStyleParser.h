@@ -11,7 +11,8 @@
 
 @class Observation;
 /**
- * Parses the observation form json and retrieves the style
+ * Parses the observation form json and retrieves the style.  The style of each form is parsed once
+ * into a table of shared styles keyed by the primary and secondary field values.
  */
 @interface ObservationShapeStyleParser : NSObject
 
@@ -23,4 +24,19 @@
  */
 +(ObservationShapeStyle *) styleOfObservation: (Observation *) observation;
 
+/**
+ * Get the style for the primary and secondary field values from the form style json
+ *
+ * @param formStyle form style json
+ * @param primary primary field value
+ * @param secondary secondary field value
+ * @return shape style
+ */
++(ObservationShapeStyle *) styleOfFormStyle: (NSDictionary *) formStyle primary: (NSString *) primary secondary: (NSString *) secondary;
+
+/**
+ * Clear the parsed form styles
+ */
++(void) clearCache;
+
 @end
@@ -9,69 +9,169 @@
 #import "ObservationShapeStyleParser.h"
 #import "MAGE-Swift.h"
 
+/**
+ * The styles of one form, the form level style followed by the styles of each type and each variant of a type
+ */
+@interface ObservationShapeStyleTable : NSObject
+
+@property (nonatomic, strong, readonly) ObservationShapeStyle *style;
+@property (nonatomic, strong, readonly) NSDictionary<NSString *, ObservationShapeStyle *> *typeStyles;
+@property (nonatomic, strong, readonly) NSDictionary<NSString *, NSDictionary<NSString *, ObservationShapeStyle *> *> *variantStyles;
+
+-(instancetype) initWithFormStyle: (NSDictionary *) formStyle;
+
+-(ObservationShapeStyle *) styleOfPrimary: (NSString *) primary secondary: (NSString *) secondary;
+
+@end
+
 @implementation ObservationShapeStyleParser
 
-static NSString * const STYLE_ELEMENT = @"style";
 static NSString * const FILL_ELEMENT = @"fill";
 static NSString * const STROKE_ELEMENT = @"stroke";
 static NSString * const FILL_OPACITY_ELEMENT = @"fillOpacity";
 static NSString * const STROKE_OPACITY_ELEMENT = @"strokeOpacity";
 static NSString * const STROKE_WIDTH_ELEMENT = @"strokeWidth";
 
++(NSCache<NSManagedObjectID *, ObservationShapeStyleTable *> *) formStyles{
+    static NSCache *formStyles = nil;
+    static dispatch_once_t onceToken;
+    dispatch_once(&onceToken, ^{
+        formStyles = [[NSCache alloc] init];
+    });
+    return formStyles;
+}
+
 +(ObservationShapeStyle *) styleOfObservation: (Observation *) observation{
     
-    ObservationShapeStyle *style = [[ObservationShapeStyle alloc] init];
-    
     Form *form = observation.primaryEventForm;
+    if(form == nil){
+        return [self defaultStyle];
+    }
     
-    // Check for a style
-    NSDictionary *styleField = form.style;
-    if(styleField != nil && styleField.count > 0){
-        
-        // Found the top level style
-        NSString *type = [observation primaryFieldText];
-        
-        // Check for a type within the style
-        NSDictionary *typeField = [styleField objectForKey:type];
-        if(typeField != nil && typeField.count > 0){
-            
-            // Found the type level style
-            styleField = typeField;
+    // Forms are replaced rather than updated when an event is fetched so the object id identifies the style
+    NSManagedObjectID *formObjectID = form.objectID;
+    ObservationShapeStyleTable *table = formObjectID.isTemporaryID ? nil : [[self formStyles] objectForKey:formObjectID];
+    if(table == nil){
+        table = [[ObservationShapeStyleTable alloc] initWithFormStyle:form.style];
+        if(!formObjectID.isTemporaryID){
+            [[self formStyles] setObject:table forKey:formObjectID];
+        }
+    }
+    
+    if(table.style == nil){
+        return [self defaultStyle];
+    }
+    return [table styleOfPrimary:[observation primaryFieldText] secondary:[observation secondaryFieldText]];
+}
+
++(ObservationShapeStyle *) styleOfFormStyle: (NSDictionary *) formStyle primary: (NSString *) primary secondary: (NSString *) secondary{
+    ObservationShapeStyleTable *table = [[ObservationShapeStyleTable alloc] initWithFormStyle:formStyle];
+    if(table.style == nil){
+        return [self defaultStyle];
+    }
+    return [table styleOfPrimary:primary secondary:secondary];
+}
+
++(void) clearCache{
+    [[self formStyles] removeAllObjects];
+}
+
+/**
+ * Shared style built from the user defaults, rebuilt only when the defaults it is built from change
+ */
++(ObservationShapeStyle *) defaultStyle{
+    static ObservationShapeStyle *defaultStyle = nil;
+    static NSString *defaultStyleKey = nil;
+    
+    NSUserDefaults *defaults = [NSUserDefaults standardUserDefaults];
+    NSString *key = [NSString stringWithFormat:@"%f|%@|%ld|%@|%ld",
+                     [defaults floatForKey:@"fill_default_line_width"],
+                     [defaults stringForKey:@"line_default_color"], (long)[defaults integerForKey:@"line_default_color_alpha"],
+                     [defaults stringForKey:@"fill_default_color"], (long)[defaults integerForKey:@"fill_default_color_alpha"]];
+    @synchronized (self) {
+        if(defaultStyle == nil || ![defaultStyleKey isEqualToString:key]){
+            defaultStyle = [[ObservationShapeStyle alloc] init];
+            defaultStyleKey = key;
+        }
+        return defaultStyle;
+    }
+}
+
++(ObservationShapeStyle *) styleOfStyleField: (NSDictionary *) styleField{
+    
+    // Get the style properties
+    NSString *fill = [styleField objectForKey:FILL_ELEMENT];
+    NSString *stroke = [styleField objectForKey:STROKE_ELEMENT];
+    float fillOpacity = [((NSNumber *)[styleField objectForKey:FILL_OPACITY_ELEMENT]) floatValue];
+    float strokeOpacity = [((NSNumber *)[styleField objectForKey:STROKE_OPACITY_ELEMENT]) floatValue];
+    float strokeWidth = [((NSNumber *)[styleField objectForKey:STROKE_WIDTH_ELEMENT]) floatValue];
+    
+    return [[ObservationShapeStyle alloc] initWithLineWidth:strokeWidth
+                                                strokeColor:[UIColor hx_colorWithHexRGBAString:stroke alpha:strokeOpacity]
+                                                  fillColor:[UIColor hx_colorWithHexRGBAString:fill alpha:fillOpacity]];
+}
+
+@end
+
+@implementation ObservationShapeStyleTable
+
+-(instancetype) initWithFormStyle: (NSDictionary *) formStyle{
+    self = [super init];
+    if(self != nil){
+        // Check for a style
+        if(formStyle != nil && formStyle.count > 0){
             
-            // Check for a variant
+            // Found the top level style
+            _style = [ObservationShapeStyleParser styleOfStyleField:formStyle];
             
-            NSString *variant = [observation secondaryFieldText];
-            if (variant != nil) {
-                // Check for a variant within the style type
-                NSDictionary *typeVariantField = [styleField objectForKey:variant];
-                if(typeVariantField != nil && typeVariantField.count > 0){
-                    
-                    // Found the variant level style
-                    styleField = typeVariantField;
+            // Each type and each variant within a type may have its own style
+            NSMutableDictionary *typeStyles = [[NSMutableDictionary alloc] init];
+            NSMutableDictionary *variantStyles = [[NSMutableDictionary alloc] init];
+            for(id type in formStyle){
+                NSDictionary *typeField = [formStyle objectForKey:type];
+                if(![type isKindOfClass:[NSString class]] || ![typeField isKindOfClass:[NSDictionary class]] || typeField.count == 0){
+                    continue;
+                }
+                [typeStyles setObject:[ObservationShapeStyleParser styleOfStyleField:typeField] forKey:type];
+                
+                NSMutableDictionary *styles = [[NSMutableDictionary alloc] init];
+                for(id variant in typeField){
+                    NSDictionary *typeVariantField = [typeField objectForKey:variant];
+                    if(![variant isKindOfClass:[NSString class]] || ![typeVariantField isKindOfClass:[NSDictionary class]] || typeVariantField.count == 0){
+                        continue;
+                    }
+                    [styles setObject:[ObservationShapeStyleParser styleOfStyleField:typeVariantField] forKey:variant];
+                }
+                if(styles.count > 0){
+                    [variantStyles setObject:styles forKey:type];
                 }
             }
+            _typeStyles = typeStyles;
+            _variantStyles = variantStyles;
         }
-        
-        // Get the style properties
-        NSString *fill = [styleField objectForKey:FILL_ELEMENT];
-        NSString *stroke = [styleField objectForKey:STROKE_ELEMENT];
-        float fillOpacity = [((NSNumber *)[styleField objectForKey:FILL_OPACITY_ELEMENT]) floatValue];
-        float strokeOpacity = [((NSNumber *)[styleField objectForKey:STROKE_OPACITY_ELEMENT]) floatValue];
-        float strokeWidth = [((NSNumber *)[styleField objectForKey:STROKE_WIDTH_ELEMENT]) floatValue];
-        
-        // Set the stroke width
-        [style setLineWidth:strokeWidth];
-        
-        // Create and set the stroke color
-        UIColor *strokeColor = [UIColor hx_colorWithHexRGBAString:stroke alpha:strokeOpacity];
-        [style setStrokeColor:strokeColor];
-        
-        // Create and set the fill color
-        UIColor *fillColor = [UIColor hx_colorWithHexRGBAString:fill alpha:fillOpacity];
-        [style setFillColor:fillColor];
+    }
+    return self;
+}
+
+-(ObservationShapeStyle *) styleOfPrimary: (NSString *) primary secondary: (NSString *) secondary{
+    if(primary == nil){
+        return self.style;
+    }
+    
+    // Check for a type within the style
+    ObservationShapeStyle *typeStyle = [self.typeStyles objectForKey:primary];
+    if(typeStyle == nil){
+        return self.style;
     }
     
-    return style;
+    // Check for a variant within the style type
+    if(secondary != nil){
+        ObservationShapeStyle *variantStyle = [[self.variantStyles objectForKey:primary] objectForKey:secondary];
+        if(variantStyle != nil){
+            return variantStyle;
+        }
+    }
+    return typeStyle;
 }
 
 @end
@@ -103,25 +103,23 @@ class ObservationSummaryView: CommonSummaryView<Observation, ObservationActionsD
     
     func populate(observation: Observation, actionsDelegate: ObservationActionsDelegate? = nil) {
         self.observation = observation;
-        
+        populate(displayModel: ObservationDisplayModelCache.shared.freshModel(for: observation));
+    }
+    
+    func populate(displayModel: ObservationDisplayModel) {
         if (self.imageOverride != nil) {
             itemImage.image = self.imageOverride;
         } else {
-            itemImage.image = ObservationImage.image(observation: self.observation!);
+            itemImage.image = ObservationImage.image(imagePath: displayModel.iconPath);
         }
 
-        primaryField.text = observation.primaryFeedFieldText;
-        secondaryField.text = observation.secondaryFeedFieldText;
-        // we do not want the date to word break so we replace all spaces with a non word breaking spaces
-        var timeText = "";
-        if let itemDate: NSDate = observation.timestamp as NSDate? {
-            timeText = itemDate.formattedDisplay().uppercased().replacingOccurrences(of: " ", with: "\u{00a0}") ;
-        }
-        timestamp.text = "\(observation.user?.name?.uppercased() ?? "") \u{2022} \(timeText)";
+        primaryField.text = displayModel.primaryText;
+        secondaryField.text = displayModel.secondaryText;
+        timestamp.text = displayModel.timestampText;
         
-        if (observation.error != nil) {
-            self.syncBadge.isHidden = observation.hasValidationError;
-            self.errorBadge.isHidden = !observation.hasValidationError;
+        if (displayModel.hasError) {
+            self.syncBadge.isHidden = displayModel.hasValidationError;
+            self.errorBadge.isHidden = !displayModel.hasValidationError;
         } else {
             self.syncBadge.isHidden = true;
             self.errorBadge.isHidden = true;
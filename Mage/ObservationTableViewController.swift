@@ -146,10 +146,9 @@ class ObservationTableViewController: UITableViewController {
         self.tableView.reloadData();
     }
     
-    // This is all here so that we will purge old results from the list
+    // The update timer purges old results from the list
     // for example if the time filter is set to "Today" when the observations fall off of the list
-    // they will be purged from the view  TODO determine if there is a better way to do this, maybe just update far less
-    // often, like once every 10 minutes because the flash on the feed is annoying
+    // they are deleted from the view without fetching the list again
     override func viewWillDisappear(_ animated: Bool) {
         super.viewWillDisappear(animated);
         self.stopUpdateTimer();
@@ -169,7 +168,7 @@ class ObservationTableViewController: UITableViewController {
         }
         self.updateTimer = Timer(timeInterval: 60, target: self, selector: #selector(onUpdateTimerFire), userInfo: nil, repeats: true);
         RunLoop.main.add(self.updateTimer!, forMode: .default);
-        self.observationDataStore.updatePredicates();
+        self.observationDataStore.advanceTimeWindow();
     }
     
     func stopUpdateTimer() {
@@ -179,7 +178,7 @@ class ObservationTableViewController: UITableViewController {
     }
     
     @objc func onUpdateTimerFire() {
-        self.observationDataStore.updatePredicates();
+        self.observationDataStore.advanceTimeWindow();
     }
     
     func setNavBarTitle() {
@@ -9,6 +9,9 @@
 #import "TimeFilter.h"
 #import "MAGE-Swift.h"
 
+// observations are faulted in a screen or so at a time as the list scrolls
+static NSUInteger const ObservationsFetchBatchSize = 50;
+
 @implementation Observations
 
 + (BOOL) getImportantFilter {
@@ -52,8 +55,7 @@
     }
     
     if ([Observations getFavoritesFilter]) {
-        User *currentUser = [User fetchCurrentUserWithContext:[NSManagedObjectContext MR_defaultContext]];
-        [predicates addObject:[NSPredicate predicateWithFormat:@"favorites.favorite CONTAINS %@ AND favorites.userId CONTAINS %@", [NSNumber numberWithBool:YES], currentUser.remoteId]];
+        [predicates addObject:[ObservationCurrentUserFavorite predicate]];
     }
     
     return predicates;
@@ -67,9 +69,10 @@
 + (Observations *) observations {
     NSMutableArray *predicates = [Observations getPredicatesForObservations];
     NSFetchRequest *fetchRequest = [Observation MR_requestAllSortedBy:@"timestamp" ascending:NO withPredicate:[NSCompoundPredicate andPredicateWithSubpredicates:predicates]];
+    fetchRequest.fetchBatchSize = ObservationsFetchBatchSize;
     NSFetchedResultsController *fetchedResultsController = [[NSFetchedResultsController alloc] initWithFetchRequest:fetchRequest
                                                                                                managedObjectContext:[NSManagedObjectContext MR_defaultContext]
-                                                                                                 sectionNameKeyPath:@"dateSection"
+                                                                                                 sectionNameKeyPath:[ObservationDaySection sectionNameKeyPath]
                                                                                                           cacheName:nil];
     
     return [[Observations alloc] initWithFetchedResultsController:fetchedResultsController];
@@ -78,9 +81,10 @@
 + (Observations *) observationsForMap {
     NSMutableArray *predicates = [Observations getPredicatesForObservationsForMap];
     NSFetchRequest *fetchRequest = [Observation MR_requestAllSortedBy:@"timestamp" ascending:YES withPredicate:[NSCompoundPredicate andPredicateWithSubpredicates:predicates]];
+    fetchRequest.fetchBatchSize = ObservationsFetchBatchSize;
     NSFetchedResultsController *fetchedResultsController = [[NSFetchedResultsController alloc] initWithFetchRequest:fetchRequest
                                                                                                managedObjectContext:[NSManagedObjectContext MR_defaultContext]
-                                                                                                 sectionNameKeyPath:@"dateSection"
+                                                                                                 sectionNameKeyPath:[ObservationDaySection sectionNameKeyPath]
                                                                                                           cacheName:nil];
     
     return [[Observations alloc] initWithFetchedResultsController:fetchedResultsController];
@@ -88,9 +92,10 @@
 
 + (Observations *) hideObservations {
     NSFetchRequest *fetchRequest = [Observation MR_requestAllSortedBy:@"timestamp" ascending:NO withPredicate:[NSPredicate predicateWithValue:NO]];
+    fetchRequest.fetchBatchSize = ObservationsFetchBatchSize;
     NSFetchedResultsController *fetchedResultsController = [[NSFetchedResultsController alloc] initWithFetchRequest:fetchRequest
                                                                                                managedObjectContext:[NSManagedObjectContext MR_defaultContext]
-                                                                                                 sectionNameKeyPath:@"dateSection"
+                                                                                                 sectionNameKeyPath:[ObservationDaySection sectionNameKeyPath]
                                                                                                           cacheName:nil];
     
     return [[Observations alloc] initWithFetchedResultsController:fetchedResultsController];
@@ -98,6 +103,7 @@
 
 + (Observations *) observationsForUser:(User *) user {
     NSFetchRequest *fetchRequest = [Observation MR_requestAllSortedBy:@"dirty,timestamp" ascending:NO withPredicate:[NSPredicate predicateWithFormat:@"user == %@ AND eventId == %@", user, [Server currentEventId]]];
+    fetchRequest.fetchBatchSize = ObservationsFetchBatchSize;
     NSFetchedResultsController *fetchedResultsController = [[NSFetchedResultsController alloc] initWithFetchRequest:fetchRequest
                                                                                                managedObjectContext:[NSManagedObjectContext MR_defaultContext]
                                                                                                  sectionNameKeyPath:@"dirtySection"
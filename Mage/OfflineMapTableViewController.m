@@ -12,6 +12,7 @@
 #import "ChildCacheOverlayTableCell.h"
 #import "XYZDirectoryCacheOverlay.h"
 #import "GeoPackageCacheOverlay.h"
+#import "GeoPackageFeatureIndexer.h"
 @import GeoPackage;
 #import "ObservationTableHeaderView.h"
 #import "MAGE-Swift.h"
@@ -64,6 +65,7 @@ static NSString *PROCESSING_SECTION_NAME = @"Extracting Archives";
     [self.mapsFetchedResultsController performFetch:nil];
 
     [[NSNotificationCenter defaultCenter] addObserver:self selector:@selector(geoPackageImported:) name: GeoPackageImported object:nil];
+    [[NSNotificationCenter defaultCenter] addObserver:self selector:@selector(geoPackageIndexingProgress:) name: GeoPackageIndexingProgress object:nil];
     
     NSUserDefaults *defaults = [NSUserDefaults standardUserDefaults];
     self.selectedStaticLayers = [NSMutableSet setWithArray:[defaults valueForKeyPath:[NSString stringWithFormat: @"selectedStaticLayers.%@", [Server currentEventId]]]];
@@ -78,6 +80,11 @@ static NSString *PROCESSING_SECTION_NAME = @"Extracting Archives";
     [self.tableView performSelectorOnMainThread:@selector(reloadData) withObject:nil waitUntilDone:NO];
 }
 
+- (void) geoPackageIndexingProgress: (NSNotification *) notification {
+    // the feature table cells show the indexing progress
+    [self.tableView performSelectorOnMainThread:@selector(reloadData) withObject:nil waitUntilDone:NO];
+}
+
 - (IBAction)refreshLayers:(id)sender {
     self.refreshLayersButton.enabled = NO;
     [Layer refreshLayersWithEventId:[Server currentEventId]];
@@ -633,11 +640,16 @@ static NSString *PROCESSING_SECTION_NAME = @"Extracting Archives";
 
 -(void) deleteGeoPackageCacheOverlay: (GeoPackageCacheOverlay *) geoPackageCacheOverlay{
     
-    GPKGGeoPackageManager * manager = [GPKGGeoPackageFactory manager];
-    if(![manager delete:[geoPackageCacheOverlay getName]]){
-        NSLog(@"Error deleting GeoPackage cache file: %@", [geoPackageCacheOverlay getName]);
-    }
+    NSString *name = [geoPackageCacheOverlay getName];
     [self.cacheOverlays removeCacheOverlay:geoPackageCacheOverlay];
+    // indexing may still be writing to the GeoPackage, delete it once indexing has stopped
+    [[GeoPackageFeatureIndexer sharedIndexer] cancelIndexingGeoPackage:name completion:^{
+        [FeatureTileCache removeTilesWithGeoPackageName:name];
+        GPKGGeoPackageManager * manager = [GPKGGeoPackageFactory manager];
+        if(![manager delete:name]){
+            NSLog(@"Error deleting GeoPackage cache file: %@", name);
+        }
+    }];
 }
 
 @end
@@ -15,6 +15,11 @@ class PersonTableViewCell : UITableViewCell {
     private var constructed = false;
     private var location: Location?;
     private var user: User?;
+    
+    /// The location or user the cell shows
+    var rowObjectID: NSManagedObjectID? {
+        return location?.objectID ?? user?.objectID;
+    }
     private var didSetUpConstraints = false;
     private var actionsDelegate: UserActionsDelegate?;
     private var scheme: MDCContainerScheming?;
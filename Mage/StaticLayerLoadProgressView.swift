@@ -0,0 +1,95 @@
+//
+//  StaticLayerLoadProgressView.swift
+//  MAGE
+//
+//  Copyright © 2026 National Geospatial Intelligence Agency. All rights reserved.
+//
+
+import Foundation
+import PureLayout
+import UIKit
+import MapKit
+
+/// Banner shown above the map while static layers are built in the background.  It is hidden whenever
+/// no layer of its map is being built, so it takes no space in the map stack.
+class StaticLayerLoadProgressView: UIView {
+    weak var mapView: MKMapView?
+    var scheme: MDCContainerScheming?
+    /// progress of the layers being built, keyed by layer id
+    private(set) var layerProgress: [NSNumber: StaticLayerLoadProgressNotification] = [:]
+    /// the newest load of each layer, notifications from the loads it superseded are ignored
+    private var latestLoadIds: [NSNumber: Int] = [:]
+    private var progressObserver: Any?
+
+    let label: UILabel = UILabel(forAutoLayout: ())
+    let progressView: UIProgressView = UIProgressView(progressViewStyle: .default)
+
+    init(mapView: MKMapView?, scheme: MDCContainerScheming?) {
+        self.mapView = mapView
+        self.scheme = scheme
+        super.init(frame: .zero)
+        self.accessibilityLabel = "static layer load progress"
+        isHidden = true
+        progressView.translatesAutoresizingMaskIntoConstraints = false
+        label.font = scheme?.typographyScheme.body2
+        addSubview(label)
+        addSubview(progressView)
+        label.autoPinEdgesToSuperviewEdges(with: UIEdgeInsets(top: 8, left: 16, bottom: 0, right: 16), excludingEdge: .bottom)
+        progressView.autoPinEdge(.top, to: .bottom, of: label, withOffset: 8)
+        progressView.autoPinEdgesToSuperviewEdges(with: UIEdgeInsets(top: 0, left: 16, bottom: 8, right: 16), excludingEdge: .top)
+        applyTheme(withScheme: scheme)
+
+        progressObserver = NotificationCenter.default.addObserver(forName: .StaticLayerLoadProgress, object: nil, queue: .main) { [weak self] notification in
+            guard let progress = notification.object as? StaticLayerLoadProgressNotification, progress.mapView == self?.mapView else {
+                return
+            }
+            self?.update(progress: progress)
+        }
+    }
+
+    required init?(coder: NSCoder) {
+        fatalError("init(coder:) has not been implemented")
+    }
+
+    deinit {
+        if let progressObserver = progressObserver {
+            NotificationCenter.default.removeObserver(progressObserver, name: .StaticLayerLoadProgress, object: nil)
+        }
+    }
+
+    func applyTheme(withScheme scheme: MDCContainerScheming?) {
+        guard let scheme = scheme else {
+            return
+        }
+        self.scheme = scheme
+        backgroundColor = scheme.colorScheme.surfaceColor
+        label.textColor = scheme.colorScheme.onSurfaceColor.withAlphaComponent(0.87)
+        label.font = scheme.typographyScheme.body2
+        progressView.progressTintColor = scheme.colorScheme.primaryColor
+    }
+
+    func update(progress: StaticLayerLoadProgressNotification) {
+        if let latestLoadId = latestLoadIds[progress.layerId], progress.loadId < latestLoadId {
+            return
+        }
+        latestLoadIds[progress.layerId] = progress.loadId
+        if progress.finished {
+            layerProgress.removeValue(forKey: progress.layerId)
+        } else {
+            layerProgress[progress.layerId] = progress
+        }
+        guard !layerProgress.isEmpty else {
+            isHidden = true
+            return
+        }
+        let featuresBuilt = layerProgress.values.reduce(0) { $0 + $1.featuresBuilt }
+        let featureCount = layerProgress.values.reduce(0) { $0 + $1.featureCount }
+        if layerProgress.count == 1, let layer = layerProgress.values.first {
+            label.text = "Loading \(layer.layerName ?? "static layer") \(featuresBuilt) of \(featureCount) features"
+        } else {
+            label.text = "Loading \(layerProgress.count) static layers \(featuresBuilt) of \(featureCount) features"
+        }
+        progressView.progress = featureCount == 0 ? 0 : Float(featuresBuilt) / Float(featureCount)
+        isHidden = false
+    }
+}
@@ -0,0 +1,174 @@
+//
+//  StaticLayerShapes.swift
+//  MAGE
+//
+//  Copyright © 2026 National Geospatial Intelligence Agency. All rights reserved.
+//
+
+import Foundation
+import MapKit
+
+/// The map items for one static layer.  Points become annotations and polygons and lines which
+/// share a style are combined into a single overlay so the map view tracks a handful of overlays
+/// per layer instead of one per feature.  The individual shapes are kept for hit testing.
+/// Nothing here touches the map view so the shapes can be built off of the main thread.
+final class StaticLayerShapes {
+    /// number of features built between progress callbacks
+    static let progressInterval = 1000
+
+    struct Style: Hashable {
+        let lineColor: String
+        let lineOpacity: Double
+        let lineWidth: Double
+        let fillColor: String?
+        let fillOpacity: Double
+    }
+
+    private(set) var annotations: [StaticPointAnnotation] = []
+    /// every StyledPolygon and StyledPolyline in the layer, used for hit testing
+    private(set) var shapes: [MKOverlay] = []
+    /// what is added to the map, one overlay per style
+    private(set) var overlays: [MKOverlay] = []
+
+    private var polygonStyles: [Style] = []
+    private var polygonsByStyle: [Style: [StyledPolygon]] = [:]
+    private var polylineStyles: [Style] = []
+    private var polylinesByStyle: [Style: [StyledPolyline]] = [:]
+    private var colors: [String: UIColor] = [:]
+
+    /// Returns nil if isCancelled returns true before all of the features are built
+    static func build<Features: Sequence>(layerName: String?, features: Features, isCancelled: () -> Bool = { false }, progress: ((Int) -> Void)? = nil) -> StaticLayerShapes? where Features.Element == [AnyHashable: Any] {
+        let shapes = StaticLayerShapes()
+        var count = 0
+        for (index, feature) in features.enumerated() {
+            if index % progressInterval == 0 {
+                if isCancelled() {
+                    return nil
+                }
+                progress?(index)
+            }
+            autoreleasepool {
+                shapes.add(feature: feature, layerName: layerName)
+            }
+            count += 1
+        }
+        shapes.groupOverlays()
+        progress?(count)
+        return shapes
+    }
+
+    /// Simplifies the overlays added to the map, returns false if isCancelled returns true first
+    @discardableResult
+    func buildMultiResolutionShapes(isCancelled: () -> Bool = { false }) -> Bool {
+        for overlay in overlays {
+            if isCancelled() {
+                return false
+            }
+            (overlay as? MultiResolutionOverlay)?.buildMultiResolutionShape()
+        }
+        return true
+    }
+
+    private func add(feature: [AnyHashable: Any], layerName: String?) {
+        guard let featureType = StaticLayer.featureType(feature: feature) else {
+            return
+        }
+        if featureType == "Point" {
+            if let annotation = StaticPointAnnotation(feature: feature) {
+                annotation.layerName = layerName
+                annotation.title = StaticLayer.featureName(feature: feature)
+                annotation.subtitle = StaticLayer.featureDescription(feature: feature)
+                annotations.append(annotation)
+            }
+        } else if featureType == "Polygon" {
+            guard let coordinates = StaticLayer.featureCoordinates(feature: feature) as? [[[NSNumber]]], !coordinates.isEmpty else {
+                return
+            }
+            let style = Style(
+                lineColor: StaticLayer.featureLineColor(feature: feature),
+                lineOpacity: StaticLayer.featureLineOpacity(feature: feature),
+                lineWidth: StaticLayer.featureLineWidth(feature: feature),
+                fillColor: StaticLayer.featureFillColor(feature: feature),
+                fillOpacity: StaticLayer.featureFillOpacity(feature: feature))
+            let polygon = StyledPolygon.generate(coordinates: coordinates)
+            polygon.fillColor = color(hex: style.fillColor ?? "", opacity: style.fillOpacity) ?? polygon.fillColor
+            polygon.lineColor = color(hex: style.lineColor, opacity: style.lineOpacity) ?? polygon.lineColor
+            polygon.lineWidth = style.lineWidth
+            polygon.title = StaticLayer.featureName(feature: feature)
+            polygon.subtitle = StaticLayer.featureDescription(feature: feature)
+            shapes.append(polygon)
+            if polygonsByStyle[style] == nil {
+                polygonStyles.append(style)
+            }
+            polygonsByStyle[style, default: []].append(polygon)
+        } else if featureType == "LineString" {
+            guard let coordinates = StaticLayer.featureCoordinates(feature: feature) as? [[NSNumber]] else {
+                return
+            }
+            let style = Style(
+                lineColor: StaticLayer.featureLineColor(feature: feature),
+                lineOpacity: StaticLayer.featureLineOpacity(feature: feature),
+                lineWidth: StaticLayer.featureLineWidth(feature: feature),
+                fillColor: nil,
+                fillOpacity: 0)
+            let polyline = StyledPolyline.generate(path: coordinates)
+            polyline.lineColor = color(hex: style.lineColor, opacity: style.lineOpacity) ?? polyline.lineColor
+            polyline.lineWidth = style.lineWidth
+            polyline.title = StaticLayer.featureName(feature: feature)
+            polyline.subtitle = StaticLayer.featureDescription(feature: feature)
+            shapes.append(polyline)
+            if polylinesByStyle[style] == nil {
+                polylineStyles.append(style)
+            }
+            polylinesByStyle[style, default: []].append(polyline)
+        }
+    }
+
+    // a style used by a single shape keeps the shape itself
+    private func groupOverlays() {
+        for style in polygonStyles {
+            guard let polygons = polygonsByStyle[style], let first = polygons.first else {
+                continue
+            }
+            if polygons.count == 1 {
+                overlays.append(first)
+                continue
+            }
+            let multiPolygon = StyledMultiPolygon(polygons)
+            multiPolygon.fillColor = first.fillColor
+            multiPolygon.lineColor = first.lineColor
+            multiPolygon.lineWidth = first.lineWidth
+            overlays.append(multiPolygon)
+        }
+        for style in polylineStyles {
+            guard let polylines = polylinesByStyle[style], let first = polylines.first else {
+                continue
+            }
+            if polylines.count == 1 {
+                overlays.append(first)
+                continue
+            }
+            let multiPolyline = StyledMultiPolyline(polylines)
+            multiPolyline.lineColor = first.lineColor
+            multiPolyline.lineWidth = first.lineWidth
+            overlays.append(multiPolyline)
+        }
+        polygonStyles = []
+        polygonsByStyle = [:]
+        polylineStyles = []
+        polylinesByStyle = [:]
+    }
+
+    // opacities in static layers are 0-255
+    private func color(hex: String, opacity: Double) -> UIColor? {
+        let key = "\(hex)-\(opacity)"
+        if let color = colors[key] {
+            return color
+        }
+        guard let color = UIColor(hex: hex)?.withAlphaComponent(opacity / 255.0) else {
+            return nil
+        }
+        colors[key] = color
+        return color
+    }
+}
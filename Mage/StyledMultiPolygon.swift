@@ -0,0 +1,31 @@
+//
+//  StyledMultiPolygon.swift
+//  MAGE
+//
+//  Copyright © 2026 National Geospatial Intelligence Agency. All rights reserved.
+//
+
+import Foundation
+import MapKit
+
+/// Polygons which share a style drawn as a single overlay
+class StyledMultiPolygon: MKMultiPolygon, OverlayRenderable, MultiResolutionOverlay {
+    var renderer: MKOverlayRenderer {
+        get {
+            let renderer = MultiResolutionMultiPolygonRenderer(multiPolygon: self)
+            renderer.fillColor = fillColor
+            renderer.strokeColor = lineColor
+            renderer.lineWidth = lineWidth
+            return renderer
+        }
+    }
+
+    var lineColor: UIColor = .black
+    var lineWidth: CGFloat = 1.0
+    var fillColor: UIColor?
+    let multiResolution = MultiResolutionShapeStorage()
+
+    func buildMultiResolutionShape() {
+        multiResolution.build { MultiResolutionShape(polygons: polygons) }
+    }
+}
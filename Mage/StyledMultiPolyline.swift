@@ -0,0 +1,29 @@
+//
+//  StyledMultiPolyline.swift
+//  MAGE
+//
+//  Copyright © 2026 National Geospatial Intelligence Agency. All rights reserved.
+//
+
+import Foundation
+import MapKit
+
+/// Lines which share a style drawn as a single overlay
+class StyledMultiPolyline: MKMultiPolyline, OverlayRenderable, MultiResolutionOverlay {
+    var renderer: MKOverlayRenderer {
+        get {
+            let renderer = MultiResolutionMultiPolylineRenderer(multiPolyline: self)
+            renderer.strokeColor = lineColor
+            renderer.lineWidth = lineWidth
+            return renderer
+        }
+    }
+
+    var lineColor: UIColor = .black
+    var lineWidth: CGFloat = 1.0
+    let multiResolution = MultiResolutionShapeStorage()
+
+    func buildMultiResolutionShape() {
+        multiResolution.build { MultiResolutionShape(polylines: polylines) }
+    }
+}
@@ -7,10 +7,10 @@
 //
 //
 
-@objc class StyledPolygon: MKPolygon, OverlayRenderable {
+@objc class StyledPolygon: MKPolygon, OverlayRenderable, MultiResolutionOverlay {
     var renderer: MKOverlayRenderer {
         get {
-            let renderer = MKPolygonRenderer(polygon: self)
+            let renderer = MultiResolutionPolygonRenderer(polygon: self)
             renderer.fillColor = fillColor
             renderer.strokeColor = lineColor
             renderer.lineWidth = lineWidth
@@ -22,6 +22,8 @@
     @objc public var lineWidth: CGFloat = 1.0
     @objc public var fillColor: UIColor?
     @objc var observationRemoteId: String?
+    /// simplified rings per zoom band, built off of the main thread before or after the polygon is added to the map
+    let multiResolution = MultiResolutionShapeStorage()
     public var _observation: Observation?
     
     public var observation: Observation? {
@@ -80,4 +82,15 @@
         self.fillColor = UIColor(hex: hex)?.withAlphaComponent(alpha) ?? self.fillColor
     }
 
+    func buildMultiResolutionShape() {
+        multiResolution.build { MultiResolutionShape(polygon: self) }
+    }
+
+    /// renderers draw the full resolution shape until the bands are built
+    @objc func buildMultiResolutionShapeInBackground() {
+        MultiResolutionShapeStorage.queue.async { [weak self] in
+            self?.buildMultiResolutionShape()
+        }
+    }
+
 }
@@ -6,10 +6,10 @@
 
 import CoreLocation
 
-@objc class StyledPolyline : MKPolyline, OverlayRenderable {
+@objc class StyledPolyline : MKPolyline, OverlayRenderable, MultiResolutionOverlay {
     var renderer: MKOverlayRenderer {
         get {
-            let renderer = MKPolylineRenderer(polyline: self)
+            let renderer = MultiResolutionPolylineRenderer(polyline: self)
             renderer.strokeColor = lineColor
             renderer.lineWidth = lineWidth
             return renderer
@@ -19,6 +19,8 @@ import CoreLocation
     @objc public var lineColor: UIColor = .black
     @objc public var lineWidth: CGFloat = 1.0
     @objc var observationRemoteId: String?
+    /// simplified points per zoom band, built off of the main thread before or after the line is added to the map
+    let multiResolution = MultiResolutionShapeStorage()
     public var _observation: Observation?
     
     public var observation: Observation? {
@@ -58,4 +60,15 @@ import CoreLocation
         self.lineColor = UIColor(hex: hex)?.withAlphaComponent(alpha) ?? self.lineColor
     }
 
+    func buildMultiResolutionShape() {
+        multiResolution.build { MultiResolutionShape(polyline: self) }
+    }
+
+    /// renderers draw the full resolution shape until the bands are built
+    @objc func buildMultiResolutionShapeInBackground() {
+        MultiResolutionShapeStorage.queue.async { [weak self] in
+            self?.buildMultiResolutionShape()
+        }
+    }
+
 }
@@ -38,6 +38,11 @@ typedef NS_ENUM(NSUInteger, TimeUnit) {
 
 + (NSPredicate *) getObservationTimePredicateForField:(NSString *) timeField;
 
+/**
+ * The start of the observation time filter window right now, nil when observations are not filtered by time
+ */
++ (NSDate *) getObservationTimeFilterStartDate;
+
 + (TimeFilterType) getLocationTimeFilter;
 + (void) setLocationTimeFilter:(TimeFilterType) timeFilter;
 
@@ -51,4 +56,9 @@ typedef NS_ENUM(NSUInteger, TimeUnit) {
 
 + (NSPredicate *) getLocationTimePredicateForField:(NSString *) timeField;
 
+/**
+ * The start of the location time filter window right now, nil when locations are not filtered by time
+ */
++ (NSDate *) getLocationTimeFilterStartDate;
+
 @end
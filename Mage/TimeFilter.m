@@ -139,94 +139,52 @@
 }
 
 + (NSPredicate *) getLocationTimePredicateForField:(NSString *) field {
-    TimeFilterType timeFilter = [TimeFilter getLocationTimeFilter];
-    TimeUnit unit = [TimeFilter getLocationCustomTimeFilterUnit];
-    switch (timeFilter) {
-        case TimeFilterCustom: {
-            switch (unit) {
-                case Hours: {
-                    NSDate *date = [[NSDate date] dateByAddingTimeInterval:-60*60* [TimeFilter getLocationCustomTimeFilterNumber]];
-                    return [NSPredicate predicateWithFormat:@"%K >= %@", field, date];
-                }
-                case Days: {
-                    NSDate *date = [[NSDate date] dateByAddingTimeInterval:-24*60*60* [TimeFilter getLocationCustomTimeFilterNumber]];
-                    return [NSPredicate predicateWithFormat:@"%K >= %@", field, date];
-                }
-                case Months: {
-                    NSDateComponents *components = [[NSDateComponents alloc] init];
-                    components.month = -1*[TimeFilter getLocationCustomTimeFilterNumber];
-                    NSDate *date = [[NSCalendar currentCalendar] dateByAddingComponents:components toDate:[[NSCalendar currentCalendar] startOfDayForDate:[NSDate date]] options:NSCalendarMatchStrictly];
-                    
-                    return [NSPredicate predicateWithFormat:@"%K >= %@", field, date];
-                }
-            }
-        }
-        default:
-            return [TimeFilter getTimePredicateForField:field andTimeFilter:timeFilter];
-    }
-    return nil;
-
+    return [TimeFilter getTimePredicateForField:field andTimeFilter:[TimeFilter getLocationTimeFilter] fromDate:[TimeFilter getLocationTimeFilterStartDate]];
 }
 
 + (NSPredicate *) getObservationTimePredicateForField:(NSString *) field {
-    TimeFilterType timeFilter = [TimeFilter getObservationTimeFilter];
-    TimeUnit unit = [TimeFilter getObservationCustomTimeFilterUnit];
-    switch (timeFilter) {
-        case TimeFilterCustom: {
-            switch (unit) {
-                case Hours: {
-                    NSDate *date = [[NSDate date] dateByAddingTimeInterval:-60*60* [TimeFilter getObservationCustomTimeFilterNumber]];
-                    return [NSPredicate predicateWithFormat:@"%K >= %@", field, date];
-                }
-                case Days: {
-                    NSDate *date = [[NSDate date] dateByAddingTimeInterval:-24*60*60* [TimeFilter getObservationCustomTimeFilterNumber]];
-                    return [NSPredicate predicateWithFormat:@"%K >= %@", field, date];
-                }
-                case Months: {
-                    NSDateComponents *components = [[NSDateComponents alloc] init];
-                    components.month = -1*[TimeFilter getObservationCustomTimeFilterNumber];
-                    NSDate *date = [[NSCalendar currentCalendar] dateByAddingComponents:components toDate:[[NSCalendar currentCalendar] startOfDayForDate:[NSDate date]] options:NSCalendarMatchStrictly];
-                    
-                    return [NSPredicate predicateWithFormat:@"%K >= %@", field, date];
-                }
-            }
-        }
-        default:
-            return [TimeFilter getTimePredicateForField:field andTimeFilter:timeFilter];
-    }
-    return nil;
+    return [TimeFilter getTimePredicateForField:field andTimeFilter:[TimeFilter getObservationTimeFilter] fromDate:[TimeFilter getObservationTimeFilterStartDate]];
+}
+
++ (NSDate *) getLocationTimeFilterStartDate {
+    return [TimeFilter startDateForTimeFilter:[TimeFilter getLocationTimeFilter] withUnit:[TimeFilter getLocationCustomTimeFilterUnit] andNumber:[TimeFilter getLocationCustomTimeFilterNumber]];
+}
+
++ (NSDate *) getObservationTimeFilterStartDate {
+    return [TimeFilter startDateForTimeFilter:[TimeFilter getObservationTimeFilter] withUnit:[TimeFilter getObservationCustomTimeFilterUnit] andNumber:[TimeFilter getObservationCustomTimeFilterNumber]];
 }
 
-+ (NSPredicate *) getTimePredicateForField: (NSString *) field andTimeFilter: (TimeFilterType) timeFilter {
++ (NSDate *) startDateForTimeFilter: (TimeFilterType) timeFilter withUnit: (TimeUnit) unit andNumber: (NSInteger) number {
     switch (timeFilter) {
         case TimeFilterToday: {
-            NSDate *start = [[NSCalendar currentCalendar] startOfDayForDate:[NSDate date]];
-            
-            NSDateComponents *components = [[NSDateComponents alloc] init];
-            components.day = 1;
-            components.second = -1;
-            NSDate *end = [[NSCalendar currentCalendar] dateByAddingComponents:components toDate:[NSDate date] options:NSCalendarMatchStrictly];
-            
-            return [NSPredicate predicateWithFormat:@"%K >= %@ && %K <= %@", field, start, field, end];
+            return [[NSCalendar currentCalendar] startOfDayForDate:[NSDate date]];
         }
         case TimeFilterLast24Hours: {
-            NSDate *date = [[NSDate date] dateByAddingTimeInterval:-24*60*60];
-            return [NSPredicate predicateWithFormat:@"%K>= %@", field, date];
+            return [[NSDate date] dateByAddingTimeInterval:-24*60*60];
         }
         case TimeFilterLastWeek: {
             NSDate *start = [[NSCalendar currentCalendar] startOfDayForDate:[NSDate date]];
-            NSDate *date = [start dateByAddingTimeInterval:-7*24*60*60];
-            return [NSPredicate predicateWithFormat:@"%K >= %@", field, date];
+            return [start dateByAddingTimeInterval:-7*24*60*60];
         }
         case TimeFilterLastMonth: {
             NSDateComponents *components = [[NSDateComponents alloc] init];
             components.month = -1;
-            NSDate *date = [[NSCalendar currentCalendar] dateByAddingComponents:components toDate:[[NSCalendar currentCalendar] startOfDayForDate:[NSDate date]] options:NSCalendarMatchStrictly];
-            
-            return [NSPredicate predicateWithFormat:@"%K >= %@", field, date];
+            return [[NSCalendar currentCalendar] dateByAddingComponents:components toDate:[[NSCalendar currentCalendar] startOfDayForDate:[NSDate date]] options:NSCalendarMatchStrictly];
         }
         case TimeFilterCustom: {
-            // TODO
+            switch (unit) {
+                case Hours: {
+                    return [[NSDate date] dateByAddingTimeInterval:-60*60* number];
+                }
+                case Days: {
+                    return [[NSDate date] dateByAddingTimeInterval:-24*60*60* number];
+                }
+                case Months: {
+                    NSDateComponents *components = [[NSDateComponents alloc] init];
+                    components.month = -1*number;
+                    return [[NSCalendar currentCalendar] dateByAddingComponents:components toDate:[[NSCalendar currentCalendar] startOfDayForDate:[NSDate date]] options:NSCalendarMatchStrictly];
+                }
+            }
             return nil;
         }
         default: {
@@ -235,4 +193,19 @@
     }
 }
 
++ (NSPredicate *) getTimePredicateForField: (NSString *) field andTimeFilter: (TimeFilterType) timeFilter fromDate: (NSDate *) start {
+    if (start == nil) {
+        return nil;
+    }
+    if (timeFilter == TimeFilterToday) {
+        NSDateComponents *components = [[NSDateComponents alloc] init];
+        components.day = 1;
+        components.second = -1;
+        NSDate *end = [[NSCalendar currentCalendar] dateByAddingComponents:components toDate:[NSDate date] options:NSCalendarMatchStrictly];
+        
+        return [NSPredicate predicateWithFormat:@"%K >= %@ && %K <= %@", field, start, field, end];
+    }
+    return [NSPredicate predicateWithFormat:@"%K >= %@", field, start];
+}
+
 @end
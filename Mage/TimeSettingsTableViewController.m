@@ -11,6 +11,7 @@
 #import "NSDate+display.h"
 #import "ObservationTableHeaderView.h"
 #import "DisplaySettingsHeader.h"
+#import "MAGE-Swift.h"
 #import <MaterialComponents/MaterialContainerScheme.h>
 
 @interface TimeSettingsTableViewController ()
@@ -115,6 +116,8 @@ static NSInteger GMT_TIME_CELL_ROW = 1;
     }
     
     [defaults synchronize];
+    [ObservationDaySection updateInBackground];
+    [ObservationDisplayModelCache.shared removeAll];
     [tableView deselectRowAtIndexPath:indexPath animated:YES];
 }
 
@@ -0,0 +1,106 @@
+//
+//  TimeWindowedList.swift
+//  MAGE
+//
+//  Copyright © 2026 National Geospatial Intelligence Agency. All rights reserved.
+//
+
+import Foundation
+import CoreData
+
+/// Keeps a list fetched with a relative time filter current as time passes without fetching it again.
+/// The lists are sorted newest first so the rows which age out of the time window are always the last
+/// rows of the fetched results.  Each advance only looks at the rows which crossed the start of the
+/// window since the last advance and hides them, the table view is told to delete them.  The hidden
+/// rows stay in the fetched results controller until the next fetch, which is only needed when the
+/// filter itself changes.
+class TimeWindowedList {
+    let field: String
+    private(set) var windowStart: Date?
+    private(set) var hiddenCount = 0
+    // number of rows shown in each section which is shown
+    private var visibleCounts: [Int]?
+
+    init(field: String) {
+        self.field = field
+    }
+
+    /// Call after every fetch
+    func reset(windowStart: Date?) {
+        self.windowStart = windowStart
+        hiddenCount = 0
+        visibleCounts = nil
+    }
+
+    /// Call when the fetched results change
+    func invalidate() {
+        visibleCounts = nil
+    }
+
+    func numberOfSections(controller: NSFetchedResultsController<NSFetchRequestResult>?) -> Int {
+        return counts(controller: controller).count
+    }
+
+    func numberOfRows(inSection section: Int, controller: NSFetchedResultsController<NSFetchRequestResult>?) -> Int {
+        let counts = counts(controller: controller)
+        return section < counts.count ? counts[section] : 0
+    }
+
+    /// Hide the rows older than the new window start, returns the sections and rows the table view needs to delete
+    func advance(to newWindowStart: Date?, controller: NSFetchedResultsController<NSFetchRequestResult>?) -> (sections: IndexSet, rows: [IndexPath]) {
+        guard let controller = controller, let fetchedObjects = controller.fetchedObjects, let oldWindowStart = windowStart, let newWindowStart = newWindowStart, newWindowStart > oldWindowStart else {
+            return (IndexSet(), [])
+        }
+        windowStart = newWindowStart
+
+        // only the rows between the old and the new start of the window are looked at, a batched fetch faults in just those
+        var agedOut = 0
+        var index = fetchedObjects.count - hiddenCount - 1
+        while index >= 0, let date = (fetchedObjects[index] as? NSObject)?.value(forKey: field) as? Date, date < newWindowStart {
+            agedOut += 1
+            index -= 1
+        }
+        guard agedOut > 0 else {
+            return (IndexSet(), [])
+        }
+
+        var counts = self.counts(controller: controller)
+        var sections = IndexSet()
+        var rows: [IndexPath] = []
+        var remaining = agedOut
+        while remaining > 0, let section = counts.indices.last {
+            let count = counts[section]
+            if remaining >= count {
+                sections.insert(section)
+                counts.removeLast()
+                remaining -= count
+            } else {
+                rows.append(contentsOf: (count - remaining..<count).map { IndexPath(row: $0, section: section) })
+                counts[section] = count - remaining
+                remaining = 0
+            }
+        }
+        hiddenCount += agedOut
+        visibleCounts = counts
+        return (sections, rows)
+    }
+
+    private func counts(controller: NSFetchedResultsController<NSFetchRequestResult>?) -> [Int] {
+        if let visibleCounts = visibleCounts {
+            return visibleCounts
+        }
+        var counts = (controller?.sections ?? []).map { $0.numberOfObjects }
+        var remaining = hiddenCount
+        while remaining > 0, let count = counts.last {
+            if remaining >= count {
+                counts.removeLast()
+                remaining -= count
+            } else {
+                counts[counts.count - 1] = count - remaining
+                remaining = 0
+            }
+        }
+        visibleCounts = counts
+        return counts
+    }
+}
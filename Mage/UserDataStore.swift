@@ -15,6 +15,7 @@ class UserDataStore: NSObject {
     var fetchedResultsController: NSFetchedResultsController<NSFetchRequestResult>?;
     weak var actionsDelegate: UserActionsDelegate?;
     var userIds: [String]?;
+    let prefetchCoordinator = ListPrefetchCoordinator()
     
     public init(tableView: UITableView, userIds: [String]? = nil, actionsDelegate: UserActionsDelegate?, scheme: MDCContainerScheming?) {
         self.scheme = scheme;
@@ -24,6 +25,7 @@ class UserDataStore: NSObject {
         super.init();
         self.tableView.dataSource = self;
         self.tableView.delegate = self;
+        self.tableView.prefetchDataSource = self;
     }
     
     func applyTheme(withContainerScheme containerScheme: MDCContainerScheming?) {
@@ -31,6 +33,7 @@ class UserDataStore: NSObject {
     }
     
     func startFetchController(userIds: [String]? = nil) {
+        self.prefetchCoordinator.cancelAll();
         if (userIds == nil) {
             self.fetchedResultsController = User.mr_fetchAllSorted(by: "name", ascending: false, with: nil, groupBy: nil, delegate: self)
         } else {
@@ -70,8 +73,44 @@ extension UserDataStore: UITableViewDataSource {
     }
 }
 
+extension UserDataStore: UITableViewDataSourcePrefetching {
+    
+    /// The users of the rows which are still in the list
+    func users(at indexPaths: [IndexPath]) -> [User] {
+        guard let sections = self.fetchedResultsController?.sections else {
+            return [];
+        }
+        return indexPaths.compactMap { indexPath in
+            guard indexPath.section < sections.count, indexPath.row < sections[indexPath.section].numberOfObjects else {
+                return nil;
+            }
+            return self.fetchedResultsController?.object(at: indexPath) as? User;
+        }
+    }
+    
+    func tableView(_ tableView: UITableView, prefetchRowsAt indexPaths: [IndexPath]) {
+        let allowDownloads = DataConnectionUtilities.shouldFetchAvatars();
+        for user in users(at: indexPaths) {
+            prefetchCoordinator.request(objectIDs: [user.objectID]);
+            if let resource = ListPrefetchCoordinator.avatarResource(user: user) {
+                prefetchCoordinator.prefetch(objectID: user.objectID, resources: [resource], allowDownloads: allowDownloads);
+            }
+        }
+    }
+    
+    func tableView(_ tableView: UITableView, cancelPrefetchingForRowsAt indexPaths: [IndexPath]) {
+        prefetchCoordinator.cancel(objectIDs: users(at: indexPaths).map { $0.objectID });
+    }
+}
+
 extension UserDataStore: UITableViewDelegate {
     
+    func tableView(_ tableView: UITableView, didEndDisplaying cell: UITableViewCell, forRowAt indexPath: IndexPath) {
+        if let objectID = (cell as? PersonTableViewCell)?.rowObjectID {
+            prefetchCoordinator.cancel(objectIDs: [objectID]);
+        }
+    }
+    
     func tableView(_ tableView: UITableView, heightForFooterInSection section: Int) -> CGFloat {
         return CGFloat.leastNormalMagnitude;
     }
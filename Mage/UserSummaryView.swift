@@ -56,7 +56,7 @@ class UserSummaryView: CommonSummaryView<User, UserActionsDelegate> {
         } else {
             self.avatarImage.kf.indicatorType = .activity;
             (avatarImage as! UserAvatarUIImageView).setUser(user: item);
-            let cacheOnly = DataConnectionUtilities.shouldFetchAvatars();
+            let cacheOnly = !DataConnectionUtilities.shouldFetchAvatars();
             (avatarImage as! UserAvatarUIImageView).showImage(cacheOnly: cacheOnly);
         }
         
@@ -486,7 +486,7 @@ class LayerTests: KIFSpec {
                 expect(staticLayer.loaded).to(equal(NSNumber(floatLiteral:Layer.OFFLINE_LAYER_LOADED)))
                 expect(iconStubCalled).toEventually(beTrue());
                 
-                let staticLayerFeatures = staticLayer.data![LayerKey.features.key] as! [[AnyHashable : Any]];
+                let staticLayerFeatures = staticLayer.features!;
                 expect(staticLayerFeatures.count).to(equal(6));
                 let lastFeature = staticLayerFeatures[2];
                 let href = (((((lastFeature[StaticLayerKey.properties.key] as! [AnyHashable : Any])[StaticLayerKey.style.key] as! [AnyHashable : Any])[StaticLayerKey.iconStyle.key] as! [AnyHashable : Any])[StaticLayerKey.icon.key] as! [AnyHashable : Any])[StaticLayerKey.href.key] as! String)
@@ -572,8 +572,9 @@ class LayerTests: KIFSpec {
                 expect(staticLayer.loaded).to(equal(NSNumber(floatLiteral:Layer.OFFLINE_LAYER_LOADED)))
                 expect(iconStubCalled).toEventually(beTrue());
                 
-                let staticLayerFeatures = staticLayer.data![LayerKey.features.key] as! [[AnyHashable : Any]];
+                let staticLayerFeatures = staticLayer.features!;
                 expect(staticLayerFeatures.count).to(equal(6));
+                expect(StaticLayerFeature.mr_countOfEntities()).to(equal(6));
                 let lastFeature = staticLayerFeatures[2];
                 let href = (((((lastFeature[StaticLayerKey.properties.key] as! [AnyHashable : Any])[StaticLayerKey.style.key] as! [AnyHashable : Any])[StaticLayerKey.iconStyle.key] as! [AnyHashable : Any])[StaticLayerKey.icon.key] as! [AnyHashable : Any])[StaticLayerKey.href.key] as! String)
                 expect(href).to(equal("featureIcons/1/\(lastFeature[LayerKey.id.key] as! String)"))
@@ -583,6 +584,7 @@ class LayerTests: KIFSpec {
                 
                 let staticLayerWithDeletedData = StaticLayer.mr_findFirst(byAttribute: "eventId", withValue: 1, in: NSManagedObjectContext.mr_default())!
                 expect(staticLayerWithDeletedData.data).to(beNil());
+                expect(StaticLayerFeature.mr_countOfEntities()).to(equal(0));
                 expect(staticLayerWithDeletedData.loaded).to(equal(NSNumber(floatLiteral:Layer.OFFLINE_LAYER_NOT_DOWNLOADED)))
             }
             
@@ -683,7 +685,7 @@ class LayerTests: KIFSpec {
                 expect(staticLayer.name).to(equal("new name"))
                 expect(staticLayer.type).to(equal("Feature"))
                 expect(staticLayer.layerDescription).to(equal("new description"))
-                let staticLayerFeatures = staticLayer.data![LayerKey.features.key] as! [[AnyHashable : Any]];
+                let staticLayerFeatures = staticLayer.features!;
                 expect(staticLayerFeatures.count).to(equal(6));
                 let lastFeature = staticLayerFeatures[2];
                 let href = (((((lastFeature[StaticLayerKey.properties.key] as! [AnyHashable : Any])[StaticLayerKey.style.key] as! [AnyHashable : Any])[StaticLayerKey.iconStyle.key] as! [AnyHashable : Any])[StaticLayerKey.icon.key] as! [AnyHashable : Any])[StaticLayerKey.href.key] as! String)
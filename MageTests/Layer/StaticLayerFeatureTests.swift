@@ -0,0 +1,124 @@
+//
+//  StaticLayerFeatureTests.swift
+//  MAGETests
+//
+//  Copyright © 2026 National Geospatial Intelligence Agency. All rights reserved.
+//
+
+import Foundation
+import Quick
+import Nimble
+import MapKit
+import MagicalRecord
+
+@testable import MAGE
+
+class StaticLayerFeatureTests: KIFSpec {
+
+    override func spec() {
+
+        func lineFeature(id: String, name: String, longitude: Double) -> [AnyHashable: Any] {
+            return [
+                "id": id,
+                "type": "Feature",
+                "geometry": ["type": "LineString", "coordinates": [[longitude, 40.0], [longitude + 0.01, 40.01]]],
+                "properties": [
+                    "name": name,
+                    "description": "\(name) description",
+                    "extra": "only in the full properties",
+                    "count": 7,
+                    "style": ["lineStyle": ["color": ["rgb": "#ff0000", "opacity": 255], "width": 3]]
+                ]
+            ]
+        }
+
+        func createLayer(data: [AnyHashable: Any]?) {
+            MagicalRecord.save(blockAndWait: { localContext in
+                let staticLayer = StaticLayer.mr_createEntity(in: localContext)
+                staticLayer?.remoteId = 1
+                staticLayer?.eventId = 1
+                staticLayer?.name = "layer"
+                staticLayer?.data = data
+            })
+        }
+
+        describe("StaticLayerFeatureTests") {
+
+            beforeEach {
+                TestHelpers.clearAndSetUpStack()
+            }
+
+            afterEach {
+                GeometryCache.shared.removeAll()
+                TestHelpers.clearAndSetUpStack()
+            }
+
+            it("should move the features to rows when migrating") {
+                let features = [
+                    lineFeature(id: "a", name: "West", longitude: -105),
+                    lineFeature(id: "b", name: "East", longitude: 10)
+                ]
+                createLayer(data: ["type": "FeatureCollection", LayerKey.features.key: features])
+
+                StaticLayerFeatureMigration.migrateIfNeeded()
+
+                let context = NSManagedObjectContext.mr_default()
+                let staticLayer = StaticLayer.mr_findFirst(in: context)!
+                expect(staticLayer.data?[LayerKey.features.key]).to(beNil())
+                expect(staticLayer.data?["type"] as? String).to(equal("FeatureCollection"))
+                expect(staticLayer.staticFeatures?.count).to(equal(2))
+
+                let migrated = staticLayer.features!
+                expect(migrated.map { $0[StaticLayerKey.id.key] as? String }).to(equal(["a", "b"]))
+                expect(StaticLayer.featureName(feature: migrated[1])).to(equal("East"))
+                expect(StaticLayer.featureLineWidth(feature: migrated[1])).to(equal(3))
+                // every property survives the move to rows
+                let properties = migrated[1][StaticLayerKey.properties.key] as? [AnyHashable: Any]
+                expect(properties?["extra"] as? String).to(equal("only in the full properties"))
+                expect(properties?["count"] as? Int).to(equal(7))
+                expect(properties?["description"] as? String).to(equal("East description"))
+            }
+
+            it("should draw the features from the name, description and style only") {
+                createLayer(data: ["type": "FeatureCollection", LayerKey.features.key: [lineFeature(id: "a", name: "West", longitude: -105)]])
+                StaticLayerFeatureMigration.migrateIfNeeded()
+
+                let context = NSManagedObjectContext.mr_default()
+                let staticLayer = StaticLayer.mr_findFirst(in: context)!
+                let drawn = Array(staticLayer.featureSequence(drawingOnly: true)!.features)
+                expect(drawn.count).to(equal(1))
+                let properties = drawn[0][StaticLayerKey.properties.key] as? [AnyHashable: Any]
+                expect(properties?["extra"]).to(beNil())
+                expect(StaticLayer.featureName(feature: drawn[0])).to(equal("West"))
+                expect(StaticLayer.featureLineWidth(feature: drawn[0])).to(equal(3))
+
+                let row = StaticLayerFeature.mr_findFirst(byAttribute: "remoteId", withValue: "a", in: context)
+                expect(MagePropertiesCodec.isEncoded(row!.propertiesData!)).to(beTrue())
+                expect(row?.properties?["extra"] as? String).to(equal("only in the full properties"))
+            }
+
+            it("should fetch the features intersecting a map rect") {
+                createLayer(data: ["type": "FeatureCollection"])
+                MagicalRecord.save(blockAndWait: { localContext in
+                    let staticLayer = StaticLayer.mr_findFirst(in: localContext)!
+                    staticLayer.setFeatures([
+                        lineFeature(id: "a", name: "West", longitude: -105),
+                        lineFeature(id: "b", name: "East", longitude: 10)
+                    ], context: localContext)
+                })
+
+                let context = NSManagedObjectContext.mr_default()
+                let region = MKCoordinateRegion(center: CLLocationCoordinate2D(latitude: 40.005, longitude: -104.995), latitudinalMeters: 10000, longitudinalMeters: 10000)
+                let topLeft = MKMapPoint(CLLocationCoordinate2D(latitude: region.center.latitude + region.span.latitudeDelta / 2, longitude: region.center.longitude - region.span.longitudeDelta / 2))
+                let bottomRight = MKMapPoint(CLLocationCoordinate2D(latitude: region.center.latitude - region.span.latitudeDelta / 2, longitude: region.center.longitude + region.span.longitudeDelta / 2))
+                let mapRect = MKMapRect(x: topLeft.x, y: topLeft.y, width: bottomRight.x - topLeft.x, height: bottomRight.y - topLeft.y)
+
+                let features = StaticLayerFeature.fetchFeatures(intersecting: mapRect, layerIds: [1], eventId: 1, context: context)
+                expect(features.map { $0.name }).to(equal(["West"]))
+                expect(StaticLayerFeature.fetchFeatures(intersecting: mapRect, layerIds: [2], eventId: 1, context: context).count).to(equal(0))
+
+                expect(StaticLayerFeature.searchFeatures(text: "eas", layerIds: [1], eventId: 1, context: context).map { $0.name }).to(equal(["East"]))
+            }
+        }
+    }
+}
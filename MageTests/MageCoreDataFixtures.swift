@@ -240,7 +240,16 @@ class MageCoreDataFixtures {
             }, completion: completion);
         }
     }
-    
+
+    public static func addEventWithCurrentUser(eventId: NSNumber = 1, userId: String = "userabc", formsJsonFile: String = "oneForm") {
+        UserDefaults.standard.baseServerUrl = "https://magetest";
+        addEvent(remoteId: eventId, name: "Event", formsJsonFile: formsJsonFile)
+        addUser(userId: userId)
+        addUserToEvent(eventId: eventId, userId: userId)
+        Server.setCurrentEventId(eventId);
+        UserDefaults.standard.currentUserId = userId;
+    }
+
     @discardableResult
     public static func addObservationToCurrentEvent(observationJson: [AnyHashable : Any], completion: MRSaveCompletionHandler? = nil) -> Observation? {
         if (completion == nil){
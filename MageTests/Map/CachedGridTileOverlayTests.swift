@@ -0,0 +1,98 @@
+//
+//  CachedGridTileOverlayTests.swift
+//  MAGETests
+//
+//  Copyright © 2026 National Geospatial Intelligence Agency. All rights reserved.
+//
+
+import Foundation
+import Quick
+import Nimble
+import MapKit
+
+@testable import MAGE
+
+class CountingTileOverlay: MKTileOverlay {
+    var loads = 0
+
+    override func loadTile(at path: MKTileOverlayPath, result: @escaping (Data?, Error?) -> Void) {
+        loads += 1
+        result(Data([UInt8(path.z), UInt8(path.x), UInt8(path.y)]), nil)
+    }
+}
+
+class CachedGridTileOverlayTests: KIFSpec {
+
+    override func spec() {
+
+        describe("CachedGridTileOverlayTests") {
+
+            var gridOverlay: CountingTileOverlay!
+
+            func overlay(version: String = "1", userInterfaceStyle: UIUserInterfaceStyle = .light) -> CachedGridTileOverlay {
+                return CachedGridTileOverlay(gridOverlay: gridOverlay, gridType: "cachedGridTileOverlayTest", version: version, userInterfaceStyle: userInterfaceStyle)
+            }
+
+            func load(_ overlay: MKTileOverlay, x: Int, y: Int, z: Int, scale: CGFloat = 2) -> Data? {
+                var tile: Data?
+                overlay.loadTile(at: MKTileOverlayPath(x: x, y: y, z: z, contentScaleFactor: scale)) { data, _ in
+                    tile = data
+                }
+                return tile
+            }
+
+            func removeTiles() {
+                CachedGridTileOverlay.removeAll()
+                // table/style/theme/signature
+                let gridTypeDirectory = overlay().tileCache(scale: 2).directory
+                    .deletingLastPathComponent().deletingLastPathComponent().deletingLastPathComponent()
+                try? FileManager.default.removeItem(at: gridTypeDirectory)
+            }
+
+            beforeEach {
+                gridOverlay = CountingTileOverlay(urlTemplate: nil)
+                gridOverlay.maximumZ = 12
+                removeTiles()
+            }
+
+            afterEach {
+                removeTiles()
+            }
+
+            it("should only draw tiles once") {
+                expect(overlay().maximumZ).to(equal(12))
+                expect(load(overlay(), x: 1, y: 2, z: 3)).to(equal(Data([3, 1, 2])))
+                expect(load(overlay(), x: 1, y: 2, z: 3)).to(equal(Data([3, 1, 2])))
+                expect(gridOverlay.loads).to(equal(1))
+
+                // the tile is still on disk after the memory cache is emptied
+                CachedGridTileOverlay.removeAll()
+                expect(load(overlay(), x: 1, y: 2, z: 3)).to(equal(Data([3, 1, 2])))
+                expect(gridOverlay.loads).to(equal(1))
+
+                expect(load(overlay(), x: 2, y: 2, z: 3)).to(equal(Data([3, 2, 2])))
+                expect(gridOverlay.loads).to(equal(2))
+            }
+
+            it("should draw the tiles again for a new version") {
+                _ = load(overlay(), x: 1, y: 2, z: 3)
+                CachedGridTileOverlay.removeAll()
+                _ = load(overlay(version: "2"), x: 1, y: 2, z: 3)
+                expect(gridOverlay.loads).to(equal(2))
+            }
+
+            it("should keep tiles apart by interface style and scale") {
+                _ = load(overlay(), x: 1, y: 2, z: 3)
+                _ = load(overlay(userInterfaceStyle: .dark), x: 1, y: 2, z: 3)
+                _ = load(overlay(), x: 1, y: 2, z: 3, scale: 3)
+                expect(gridOverlay.loads).to(equal(3))
+
+                // an unspecified style draws light tiles
+                _ = load(overlay(userInterfaceStyle: .unspecified), x: 1, y: 2, z: 3)
+                expect(gridOverlay.loads).to(equal(3))
+                expect(overlay().tileCache(scale: 2).directory).toNot(equal(overlay(userInterfaceStyle: .dark).tileCache(scale: 2).directory))
+                expect(overlay().tileCache(scale: 2).directory).toNot(equal(overlay().tileCache(scale: 3).directory))
+            }
+        }
+    }
+}
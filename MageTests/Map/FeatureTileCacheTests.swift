@@ -0,0 +1,96 @@
+//
+//  FeatureTileCacheTests.swift
+//  MAGETests
+//
+//  Copyright © 2026 National Geospatial Intelligence Agency. All rights reserved.
+//
+
+import Foundation
+import Quick
+import Nimble
+import GeoPackage
+
+@testable import MAGE
+
+/// Fails to draw every tile
+class UndrawnFeatureOverlay: CachedFeatureOverlay {
+    override func renderTile(x: Int, y: Int, zoom: Int) -> Data? {
+        return nil
+    }
+}
+
+class FeatureTileCacheTests: KIFSpec {
+
+    override func spec() {
+
+        describe("FeatureTileCacheTests") {
+
+            var geoPackagePath: String!
+
+            func cache(theme: String? = nil) -> FeatureTileCache? {
+                return FeatureTileCache(geoPackagePath: geoPackagePath, geoPackageName: "featureTileCacheTest", table: "features", style: "max500", theme: theme)
+            }
+
+            beforeEach {
+                geoPackagePath = NSTemporaryDirectory().appending("featureTileCacheTest.gpkg")
+                FileManager.default.createFile(atPath: geoPackagePath, contents: Data([1, 2, 3]), attributes: nil)
+            }
+
+            afterEach {
+                FeatureTileCache.removeTiles(geoPackageName: "featureTileCacheTest")
+                try? FileManager.default.removeItem(atPath: geoPackagePath)
+            }
+
+            it("should store tiles") {
+                let tileCache = cache()
+                expect(tileCache?.tile(x: 1, y: 2, zoom: 3)).to(beNil())
+
+                tileCache?.setTile(Data([9, 9]), x: 1, y: 2, zoom: 3)
+                expect(tileCache?.tile(x: 1, y: 2, zoom: 3)).to(equal(Data([9, 9])))
+                expect(cache()?.tile(x: 1, y: 2, zoom: 3)).to(equal(Data([9, 9])))
+                expect(cache(theme: "dark")?.tile(x: 1, y: 2, zoom: 3)).to(beNil())
+
+                // tiles without features are remembered too
+                tileCache?.setTile(nil, x: 0, y: 0, zoom: 0)
+                expect(tileCache?.tile(x: 0, y: 0, zoom: 0)).to(equal(Data()))
+            }
+
+            it("should invalidate the tiles of a changed GeoPackage") {
+                cache()?.setTile(Data([9, 9]), x: 1, y: 2, zoom: 3)
+
+                try? Data([1, 2, 3, 4]).write(to: URL(fileURLWithPath: geoPackagePath))
+                expect(cache()?.tile(x: 1, y: 2, zoom: 3)).to(beNil())
+            }
+
+            it("should have no cache for a missing GeoPackage") {
+                expect(FeatureTileCache(geoPackagePath: nil, geoPackageName: "featureTileCacheTest", table: "features", style: "max500", theme: nil)).to(beNil())
+            }
+
+            it("should only remember tiles the index confirms have no features") {
+                let name = "featureTileCacheTest"
+                let manager = GPKGGeoPackageFactory.manager()!
+                // the bundled GeoPackage is indexed
+                expect(manager.importGeoPackage(fromPath: Bundle.main.path(forResource: "countries", ofType: "gpkg"), withName: name, andOverride: true, andMove: false)).to(beTrue())
+                let geoPackage = manager.open(name)!
+                let featureDao = geoPackage.featureDao(withTableName: "countries")
+                let featureTiles = GPKGFeatureTiles(geoPackage: geoPackage, andFeatureDao: featureDao)!
+                featureTiles.indexManager = GPKGFeatureIndexManager(geoPackage: geoPackage, andFeatureDao: featureDao)
+                let overlay = UndrawnFeatureOverlay(featureTiles: featureTiles)!
+                overlay.tileCache = FeatureTileCache(geoPackagePath: geoPackage.path, geoPackageName: name, table: "countries", style: "base", theme: nil)
+
+                // the whole world has features, a tile which was not drawn is not cached
+                expect(overlay.retrieveTileWith(x: 0, andY: 0, andZoom: 0)).to(beNil())
+                expect(overlay.tileCache?.tile(x: 0, y: 0, zoom: 0)).to(beNil())
+
+                // the middle of the South Pacific has none
+                expect(overlay.retrieveTileWith(x: 35, andY: 159, andZoom: 8)).to(beNil())
+                expect(overlay.tileCache?.tile(x: 35, y: 159, zoom: 8)).to(equal(Data()))
+
+                featureTiles.indexManager?.close()
+                geoPackage.close()
+                manager.delete(name)
+                manager.close()
+            }
+        }
+    }
+}
@@ -0,0 +1,151 @@
+//
+//  GeoPackageFeatureIndexerTests.m
+//  MAGETests
+//
+//  Copyright © 2026 National Geospatial Intelligence Agency. All rights reserved.
+//
+
+#import <XCTest/XCTest.h>
+#import "GeoPackageFeatureIndexer.h"
+#import "GeoPackageImporter.h"
+#import "GeoPackageCacheOverlay.h"
+#import "GeoPackageFeatureTableCacheOverlay.h"
+#import "CacheOverlays.h"
+#import "MageConstants.h"
+@import GeoPackage;
+
+@interface GeoPackageFeatureIndexerTests : XCTestCase
+
+@property (nonatomic, strong) NSString *name;
+
+@end
+
+@implementation GeoPackageFeatureIndexerTests
+
+- (void)setUp {
+    [super setUp];
+    self.name = [NSString stringWithFormat:@"countries_indexer_%@", [[NSUUID UUID] UUIDString]];
+    NSString *path = [[NSBundle mainBundle] pathForResource:@"countries" ofType:@"gpkg"];
+    GPKGGeoPackageManager *manager = [GPKGGeoPackageFactory manager];
+    @try {
+        XCTAssertTrue([manager importGeoPackageFromPath:path withName:self.name andOverride:YES andMove:NO]);
+        // the bundled GeoPackage is indexed, start from an unindexed copy
+        GPKGGeoPackage *geoPackage = [manager open:self.name];
+        GPKGFeatureIndexManager *indexer = [[GPKGFeatureIndexManager alloc] initWithGeoPackage:geoPackage andFeatureDao:[geoPackage featureDaoWithTableName:@"countries"]];
+        [indexer deleteAllIndexes];
+        XCTAssertFalse([indexer isIndexed]);
+        [indexer close];
+        [geoPackage close];
+    }
+    @finally {
+        [manager close];
+    }
+}
+
+- (void)tearDown {
+    XCTestExpectation *stopped = [self expectationWithDescription:@"indexing stopped"];
+    [[GeoPackageFeatureIndexer sharedIndexer] cancelIndexingGeoPackage:self.name completion:^{
+        [stopped fulfill];
+    }];
+    [self waitForExpectations:@[stopped] timeout:30];
+    [[CacheOverlays getInstance] removeByCacheName:self.name];
+    GPKGGeoPackageManager *manager = [GPKGGeoPackageFactory manager];
+    [manager delete:self.name];
+    [manager close];
+    [super tearDown];
+}
+
+- (BOOL) isIndexed {
+    BOOL indexed = NO;
+    GPKGGeoPackageManager *manager = [GPKGGeoPackageFactory manager];
+    @try {
+        GPKGGeoPackage *geoPackage = [manager open:self.name];
+        GPKGFeatureIndexManager *indexer = [[GPKGFeatureIndexManager alloc] initWithGeoPackage:geoPackage andFeatureDao:[geoPackage featureDaoWithTableName:@"countries"]];
+        indexed = [indexer isIndexed];
+        [indexer close];
+        [geoPackage close];
+    }
+    @finally {
+        [manager close];
+    }
+    return indexed;
+}
+
+- (void) testIndexingCreatesTheIndex {
+    XCTestExpectation *indexed = [self expectationWithDescription:@"indexed"];
+    NSString *expectedName = self.name;
+    [[GeoPackageFeatureIndexer sharedIndexer] indexGeoPackage:self.name completion:^(NSString *name) {
+        XCTAssertEqualObjects(name, expectedName);
+        XCTAssertTrue([NSThread isMainThread]);
+        [indexed fulfill];
+    }];
+    [self waitForExpectations:@[indexed] timeout:60];
+    XCTAssertTrue([self isIndexed]);
+    XCTAssertNil([[GeoPackageFeatureIndexer sharedIndexer] progressForGeoPackage:self.name andTable:@"countries"]);
+}
+
+- (void) testGeoPackageCanBeDeletedOnceCancelledIndexingStops {
+    NSString *name = self.name;
+    XCTestExpectation *deleted = [self expectationWithDescription:@"deleted"];
+    __block BOOL cancelled = NO;
+    id observer = [[NSNotificationCenter defaultCenter] addObserverForName:GeoPackageIndexingProgress object:nil queue:[NSOperationQueue mainQueue] usingBlock:^(NSNotification *notification) {
+        if(cancelled || ![[notification.userInfo objectForKey:@"geoPackage"] isEqualToString:name]){
+            return;
+        }
+        cancelled = YES;
+        [[GeoPackageFeatureIndexer sharedIndexer] cancelIndexingGeoPackage:name completion:^{
+            // the indexing operation has closed the GeoPackage
+            XCTAssertNil([[GeoPackageFeatureIndexer sharedIndexer] progressForGeoPackage:name andTable:@"countries"]);
+            GPKGGeoPackageManager *manager = [GPKGGeoPackageFactory manager];
+            XCTAssertTrue([manager delete:name]);
+            XCTAssertFalse([manager exists:name]);
+            [manager close];
+            [deleted fulfill];
+        }];
+    }];
+    [[GeoPackageFeatureIndexer sharedIndexer] indexGeoPackage:name completion:nil];
+    [self waitForExpectations:@[deleted] timeout:60];
+    [[NSNotificationCenter defaultCenter] removeObserver:observer];
+}
+
+- (void) testCancellingAGeoPackageWhichIsNotIndexingCompletes {
+    XCTestExpectation *completed = [self expectationWithDescription:@"completed"];
+    [[GeoPackageFeatureIndexer sharedIndexer] cancelIndexingGeoPackage:@"not_indexing" completion:^{
+        XCTAssertTrue([NSThread isMainThread]);
+        [completed fulfill];
+    }];
+    [self waitForExpectations:@[completed] timeout:5];
+}
+
+- (void) testIndexedOverlayReplacesTheOverlayAndKeepsEnabledTables {
+    CacheOverlays *cacheOverlays = [CacheOverlays getInstance];
+    GPKGGeoPackageManager *manager = [GPKGGeoPackageFactory manager];
+    GeoPackageCacheOverlay *overlay = nil;
+    @try {
+        // queues the unindexed table for indexing, the overlay is replaced once it is indexed
+        overlay = [[[GeoPackageImporter alloc] init] getGeoPackageCacheOverlayWithManager:manager andName:self.name];
+    }
+    @finally {
+        [manager close];
+    }
+    XCTAssertNotNil(overlay);
+    GeoPackageFeatureTableCacheOverlay *table = (GeoPackageFeatureTableCacheOverlay *)[[overlay getChildren] firstObject];
+    XCTAssertFalse([table getIndexed]);
+    [table setEnabled:YES];
+    [cacheOverlays addCacheOverlay:overlay];
+
+    NSPredicate *replaced = [NSPredicate predicateWithBlock:^BOOL(CacheOverlays *evaluatedObject, NSDictionary *bindings) {
+        CacheOverlay *current = [evaluatedObject getByCacheName:self.name];
+        return current != nil && current != overlay;
+    }];
+    [self waitForExpectations:@[[[XCTNSPredicateExpectation alloc] initWithPredicate:replaced object:cacheOverlays]] timeout:60];
+
+    CacheOverlay *current = [cacheOverlays getByCacheName:self.name];
+    XCTAssertEqual(current.replacedCacheOverlay, overlay);
+    GeoPackageFeatureTableCacheOverlay *indexedTable = (GeoPackageFeatureTableCacheOverlay *)[[current getChildren] firstObject];
+    XCTAssertEqualObjects([indexedTable getCacheName], [table getCacheName]);
+    XCTAssertTrue([indexedTable getIndexed]);
+    XCTAssertTrue(indexedTable.enabled);
+}
+
+@end
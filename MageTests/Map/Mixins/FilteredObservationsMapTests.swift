@@ -941,4 +941,33 @@ final class FilteredObservationsOverlayIdentityTests: XCTestCase {
         expect(self.overlayCount(of: StyledPolyline.self)).toEventually(equal(1))
         expect(self.filteredObservationsMapMixin.lineObservations.count).toEventually(equal(1))
     }
+
+    func testFilterChangeOnlyRemovesObservationsOutsideFilter() {
+        let longAgo = Date(timeIntervalSince1970: 1)
+        _ = Observation.create(geometry: SFPoint(x: 16, andY: 21), date: longAgo, accuracy: 4.5, provider: "gps", delta: 2, context: NSManagedObjectContext.mr_default())
+        let recent = Observation.create(geometry: SFPoint(x: 15, andY: 20), accuracy: 4.5, provider: "gps", delta: 2, context: NSManagedObjectContext.mr_default())
+        _ = Observation.create(geometry: polygonGeometry(centerLongitude: 16, centerLatitude: 21), date: longAgo, accuracy: 4.5, provider: "gps", delta: 2, context: NSManagedObjectContext.mr_default())
+        UserDefaults.standard.observationTimeFilterKey = .all
+
+        filteredObservationsMapMixin.setupMixin()
+        didSetupMixin = true
+        expect(self.mapTestImpl.mapView?.annotations.count).toEventually(equal(2))
+        expect(self.overlayCount(of: StyledPolygon.self)).toEventually(equal(1))
+
+        let recentAnnotation = mapTestImpl.mapView?.annotations.compactMap { $0 as? ObservationAnnotation }.first { $0.observation == recent }
+        XCTAssertNotNil(recentAnnotation)
+
+        UserDefaults.standard.observationTimeFilterKey = .lastWeek
+
+        expect(self.mapTestImpl.mapView?.annotations.count).toEventually(equal(1))
+        expect(self.overlayCount(of: StyledPolygon.self)).toEventually(equal(0))
+        // the observation still matching the filter keeps its original annotation
+        XCTAssertTrue((mapTestImpl.mapView?.annotations.first as? ObservationAnnotation) === recentAnnotation)
+
+        UserDefaults.standard.observationTimeFilterKey = .all
+
+        expect(self.mapTestImpl.mapView?.annotations.count).toEventually(equal(2))
+        expect(self.overlayCount(of: StyledPolygon.self)).toEventually(equal(1))
+        XCTAssertTrue(mapTestImpl.mapView?.annotations.contains { ($0 as? ObservationAnnotation) === recentAnnotation } ?? false)
+    }
 }
@@ -198,7 +198,7 @@ class StaticLayerMapTests: KIFSpec {
                 expect(staticLayer.loaded).to(equal(NSNumber(floatLiteral:Layer.OFFLINE_LAYER_LOADED)))
                 expect(iconStubCalled).toEventually(beTrue());
                 
-                let staticLayerFeatures = staticLayer.data![LayerKey.features.key] as! [[AnyHashable : Any]];
+                let staticLayerFeatures = staticLayer.features!;
                 expect(staticLayerFeatures.count).to(equal(6));
                 let lastFeature = staticLayerFeatures[2];
                 let href = (((((lastFeature[StaticLayerKey.properties.key] as! [AnyHashable : Any])[StaticLayerKey.style.key] as! [AnyHashable : Any])[StaticLayerKey.iconStyle.key] as! [AnyHashable : Any])[StaticLayerKey.icon.key] as! [AnyHashable : Any])[StaticLayerKey.href.key] as! String)
@@ -296,7 +296,7 @@ class StaticLayerMapTests: KIFSpec {
                 expect(staticLayer.loaded).to(equal(NSNumber(floatLiteral:Layer.OFFLINE_LAYER_LOADED)))
                 expect(iconStubCalled).toEventually(beTrue());
                 
-                let staticLayerFeatures = staticLayer.data![LayerKey.features.key] as! [[AnyHashable : Any]];
+                let staticLayerFeatures = staticLayer.features!;
                 expect(staticLayerFeatures.count).to(equal(6));
                 let lastFeature = staticLayerFeatures[2];
                 let href = (((((lastFeature[StaticLayerKey.properties.key] as! [AnyHashable : Any])[StaticLayerKey.style.key] as! [AnyHashable : Any])[StaticLayerKey.iconStyle.key] as! [AnyHashable : Any])[StaticLayerKey.icon.key] as! [AnyHashable : Any])[StaticLayerKey.href.key] as! String)
@@ -316,8 +316,8 @@ class StaticLayerMapTests: KIFSpec {
                     testimpl.mapView?.setRegion(region, animated: false)
                 }
                 
-                expect(testimpl.mapView?.overlays.count).to(equal(4))
-                expect(testimpl.mapView?.annotations.count).to(equal(2))
+                expect(testimpl.mapView?.overlays.count).toEventually(equal(4))
+                expect(testimpl.mapView?.annotations.count).toEventually(equal(2))
                 
                 var items = mixin.items(at: CLLocationCoordinate2D(latitude: 39.7, longitude: -104.75))
                 expect(items?.count).to(equal(1))
@@ -411,7 +411,7 @@ class StaticLayerMapTests: KIFSpec {
                 expect(staticLayer.loaded).to(equal(NSNumber(floatLiteral:Layer.OFFLINE_LAYER_LOADED)))
                 expect(iconStubCalled).toEventually(beTrue());
                 
-                let staticLayerFeatures = staticLayer.data![LayerKey.features.key] as! [[AnyHashable : Any]];
+                let staticLayerFeatures = staticLayer.features!;
                 expect(staticLayerFeatures.count).to(equal(6));
                 let lastFeature = staticLayerFeatures[2];
                 let href = (((((lastFeature[StaticLayerKey.properties.key] as! [AnyHashable : Any])[StaticLayerKey.style.key] as! [AnyHashable : Any])[StaticLayerKey.iconStyle.key] as! [AnyHashable : Any])[StaticLayerKey.icon.key] as! [AnyHashable : Any])[StaticLayerKey.href.key] as! String)
@@ -524,7 +524,7 @@ class StaticLayerMapTests: KIFSpec {
                 expect(staticLayer.loaded).to(equal(NSNumber(floatLiteral:Layer.OFFLINE_LAYER_LOADED)))
                 expect(iconStubCalled).toEventually(beTrue());
                 
-                let staticLayerFeatures = staticLayer.data![LayerKey.features.key] as! [[AnyHashable : Any]];
+                let staticLayerFeatures = staticLayer.features!;
                 expect(staticLayerFeatures.count).to(equal(6));
                 let lastFeature = staticLayerFeatures[2];
                 let href = (((((lastFeature[StaticLayerKey.properties.key] as! [AnyHashable : Any])[StaticLayerKey.style.key] as! [AnyHashable : Any])[StaticLayerKey.iconStyle.key] as! [AnyHashable : Any])[StaticLayerKey.icon.key] as! [AnyHashable : Any])[StaticLayerKey.href.key] as! String)
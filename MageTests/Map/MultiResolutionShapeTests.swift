@@ -0,0 +1,137 @@
+//
+//  MultiResolutionShapeTests.swift
+//  MAGETests
+//
+//  Copyright © 2026 National Geospatial Intelligence Agency. All rights reserved.
+//
+
+import Foundation
+import Quick
+import Nimble
+import MapKit
+
+@testable import MAGE
+
+class MultiResolutionShapeTests: KIFSpec {
+
+    override func spec() {
+
+        // a wiggly line with a vertex roughly every meter
+        func detailedCoordinates(count: Int, latitude: Double = 40) -> [CLLocationCoordinate2D] {
+            return (0..<count).map { index in
+                CLLocationCoordinate2D(latitude: latitude + sin(Double(index)) * 0.00001, longitude: -105 + Double(index) * 0.00001)
+            }
+        }
+
+        func circle(latitude: Double = 40) -> [CLLocationCoordinate2D] {
+            var coordinates = (0..<720).map { index -> CLLocationCoordinate2D in
+                let angle = Double(index) * .pi / 360
+                return CLLocationCoordinate2D(latitude: latitude + sin(angle) * 0.01, longitude: -105 + cos(angle) * 0.01)
+            }
+            coordinates.append(coordinates[0])
+            return coordinates
+        }
+
+        func zoomScale(zoom: Double) -> MKZoomScale {
+            return MKZoomScale(256.0 * pow(2.0, zoom) / MKMapSize.world.width)
+        }
+
+        describe("MultiResolutionShapeTests") {
+
+            it("should not simplify small shapes") {
+                let polyline = StyledPolyline(coordinates: detailedCoordinates(count: 10), count: 10)
+                polyline.buildMultiResolutionShape()
+                expect(polyline.multiResolutionShape).to(beNil())
+            }
+
+            it("should have fewer points in the coarse bands") {
+                let coordinates = detailedCoordinates(count: 5000)
+                let polyline = StyledPolyline(coordinates: coordinates, count: coordinates.count)
+                expect(polyline.renderer).to(beAKindOf(MultiResolutionPolylineRenderer.self))
+                // nothing is simplified while the renderer is created
+                expect(polyline.multiResolutionShape).to(beNil())
+                polyline.buildMultiResolutionShape()
+                guard let shape = polyline.multiResolutionShape else {
+                    fail("expected a multi resolution shape")
+                    return
+                }
+
+                var previousCount = coordinates.count
+                for band in 0..<MultiResolutionShape.zoomBands.count {
+                    let count = shape.pointCount(band: band)
+                    expect(count).to(beLessThanOrEqualTo(previousCount))
+                    expect(count).to(beGreaterThanOrEqualTo(2))
+                    previousCount = count
+                }
+                expect(shape.pointCount(band: MultiResolutionShape.zoomBands.count - 1)).to(beLessThan(10))
+                // the overlay keeps every vertex for hit testing
+                expect(polyline.pointCount).to(equal(coordinates.count))
+            }
+
+            it("should build the bands off of the main thread") {
+                let coordinates = detailedCoordinates(count: 5000)
+                let polyline = StyledPolyline(coordinates: coordinates, count: coordinates.count)
+                polyline.buildMultiResolutionShapeInBackground()
+                expect(polyline.multiResolutionShape).toEventuallyNot(beNil())
+            }
+
+            it("should select the coarsest accurate band") {
+                let coordinates = detailedCoordinates(count: 500)
+                let shape = MultiResolutionShape(polyline: MKPolyline(coordinates: coordinates, count: coordinates.count))!
+
+                expect(shape.band(zoomScale: zoomScale(zoom: 18))).to(beNil())
+                expect(shape.band(zoomScale: zoomScale(zoom: 16))).to(equal(0))
+                expect(shape.band(zoomScale: zoomScale(zoom: 14))).to(equal(0))
+                expect(shape.band(zoomScale: zoomScale(zoom: 10))).to(equal(1))
+                expect(shape.band(zoomScale: zoomScale(zoom: 2))).to(equal(3))
+            }
+
+            it("should keep simplified polygon rings closed") {
+                let coordinates = circle()
+                let polygon = StyledPolygon(coordinates: coordinates, count: coordinates.count)
+                expect(polygon.renderer).to(beAKindOf(MultiResolutionPolygonRenderer.self))
+                polygon.buildMultiResolutionShape()
+                guard let shape = polygon.multiResolutionShape else {
+                    fail("expected a multi resolution shape")
+                    return
+                }
+                for band in 0..<MultiResolutionShape.zoomBands.count {
+                    let ring = shape.rings(band: band)[0]
+                    expect(ring.count).to(beGreaterThanOrEqualTo(4))
+                    expect(ring.first?.x).to(equal(ring.last?.x))
+                    expect(ring.first?.y).to(equal(ring.last?.y))
+                }
+            }
+
+            it("should simplify every polygon of a multi polygon") {
+                let polygons = [circle(latitude: 40), circle(latitude: 41)].map { StyledPolygon(coordinates: $0, count: $0.count) }
+                let multiPolygon = StyledMultiPolygon(polygons)
+                expect(multiPolygon.renderer).to(beAKindOf(MultiResolutionMultiPolygonRenderer.self))
+                multiPolygon.buildMultiResolutionShape()
+                guard let shape = multiPolygon.multiResolutionShape else {
+                    fail("expected a multi resolution shape")
+                    return
+                }
+                let rings = shape.rings(band: MultiResolutionShape.zoomBands.count - 1)
+                expect(rings.count).to(equal(2))
+                for ring in rings {
+                    expect(ring.count).to(beLessThan(721))
+                    expect(ring.first?.x).to(equal(ring.last?.x))
+                }
+            }
+
+            it("should simplify every line of a multi polyline") {
+                let polylines = [detailedCoordinates(count: 500, latitude: 40), detailedCoordinates(count: 500, latitude: 41)].map { StyledPolyline(coordinates: $0, count: $0.count) }
+                let multiPolyline = StyledMultiPolyline(polylines)
+                expect(multiPolyline.renderer).to(beAKindOf(MultiResolutionMultiPolylineRenderer.self))
+                multiPolyline.buildMultiResolutionShape()
+                guard let shape = multiPolyline.multiResolutionShape else {
+                    fail("expected a multi resolution shape")
+                    return
+                }
+                expect(shape.rings(band: 0).count).to(equal(2))
+                expect(shape.pointCount(band: MultiResolutionShape.zoomBands.count - 1)).to(beLessThan(20))
+            }
+        }
+    }
+}
@@ -0,0 +1,76 @@
+//
+//  ObservationShapeStyleParserTests.swift
+//  MAGETests
+//
+//  Copyright © 2026 National Geospatial Intelligence Agency. All rights reserved.
+//
+
+import Foundation
+import Quick
+import Nimble
+
+@testable import MAGE
+
+class ObservationShapeStyleParserTests: KIFSpec {
+
+    override func spec() {
+
+        let formStyle: [AnyHashable: Any] = [
+            "fill": "#0000FF",
+            "stroke": "#0000FF",
+            "fillOpacity": 0.2,
+            "strokeOpacity": 1,
+            "strokeWidth": 2,
+            "Hi": [
+                "fill": "#00FF00",
+                "stroke": "#00FF00",
+                "fillOpacity": 0.2,
+                "strokeOpacity": 1,
+                "strokeWidth": 4,
+                "turtle": [
+                    "fill": "#FF0000",
+                    "stroke": "#FF0000",
+                    "fillOpacity": 0.2,
+                    "strokeOpacity": 1,
+                    "strokeWidth": 6
+                ]
+            ]
+        ]
+
+        func rgb(_ color: UIColor?) -> [CGFloat] {
+            var red: CGFloat = 0, green: CGFloat = 0, blue: CGFloat = 0, alpha: CGFloat = 0
+            color?.getRed(&red, green: &green, blue: &blue, alpha: &alpha)
+            return [red, green, blue]
+        }
+
+        describe("ObservationShapeStyleParserTests") {
+
+            beforeEach {
+                ObservationShapeStyleParser.clearCache()
+            }
+
+            it("should resolve the most specific style") {
+                let scale = UIScreen.main.scale
+                let formLevel = ObservationShapeStyleParser.style(ofFormStyle: formStyle, primary: "Bye", secondary: "turtle")
+                expect(formLevel?.lineWidth).to(equal(2 / scale))
+                expect(rgb(formLevel?.strokeColor)).to(equal([0, 0, 1]))
+
+                let typeLevel = ObservationShapeStyleParser.style(ofFormStyle: formStyle, primary: "Hi", secondary: "snake")
+                expect(typeLevel?.lineWidth).to(equal(4 / scale))
+                expect(rgb(typeLevel?.strokeColor)).to(equal([0, 1, 0]))
+
+                let variantLevel = ObservationShapeStyleParser.style(ofFormStyle: formStyle, primary: "Hi", secondary: "turtle")
+                expect(variantLevel?.lineWidth).to(equal(6 / scale))
+                expect(rgb(variantLevel?.strokeColor)).to(equal([1, 0, 0]))
+
+                expect(ObservationShapeStyleParser.style(ofFormStyle: formStyle, primary: nil, secondary: nil)?.lineWidth).to(equal(2 / scale))
+            }
+
+            it("should use the shared default style for a form without a style") {
+                let style = ObservationShapeStyleParser.style(ofFormStyle: nil, primary: "Hi", secondary: nil)
+                expect(style).toNot(beNil())
+                expect(style === ObservationShapeStyleParser.style(ofFormStyle: [:], primary: nil, secondary: nil)).to(beTrue())
+            }
+        }
+    }
+}
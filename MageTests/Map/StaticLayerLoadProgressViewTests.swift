@@ -0,0 +1,71 @@
+//
+//  StaticLayerLoadProgressViewTests.swift
+//  MAGETests
+//
+//  Copyright © 2026 National Geospatial Intelligence Agency. All rights reserved.
+//
+
+import Foundation
+import Quick
+import Nimble
+import MapKit
+
+@testable import MAGE
+
+class StaticLayerLoadProgressViewTests: KIFSpec {
+
+    override func spec() {
+
+        describe("StaticLayerLoadProgressViewTests") {
+
+            var mapView: MKMapView!
+            var progressView: StaticLayerLoadProgressView!
+
+            func post(layerId: NSNumber, loadId: Int, layerName: String? = nil, featuresBuilt: Int = 0, featureCount: Int = 0, mapView: MKMapView?, finished: Bool = false) {
+                NotificationCenter.default.post(name: .StaticLayerLoadProgress, object: StaticLayerLoadProgressNotification(layerId: layerId, loadId: loadId, layerName: layerName, featuresBuilt: featuresBuilt, featureCount: featureCount, mapView: mapView, finished: finished))
+            }
+
+            beforeEach {
+                mapView = MKMapView()
+                progressView = StaticLayerLoadProgressView(mapView: mapView, scheme: MAGEScheme.scheme())
+            }
+
+            afterEach {
+                progressView = nil
+                mapView = nil
+            }
+
+            it("should show the banner while a layer of its map is built") {
+                expect(progressView.isHidden).to(beTrue())
+
+                post(layerId: 1, loadId: 1, layerName: "Roads", featuresBuilt: 1000, featureCount: 4000, mapView: mapView)
+                expect(progressView.isHidden).to(beFalse())
+                expect(progressView.label.text).to(equal("Loading Roads 1000 of 4000 features"))
+                expect(progressView.progressView.progress).to(beCloseTo(0.25, within: 0.001))
+
+                // another map's layers are not shown
+                post(layerId: 2, loadId: 2, layerName: "Rivers", featureCount: 100, mapView: MKMapView())
+                expect(progressView.layerProgress.count).to(equal(1))
+
+                post(layerId: 1, loadId: 1, mapView: mapView, finished: true)
+                expect(progressView.isHidden).to(beTrue())
+            }
+
+            it("should ignore a superseded load of a layer") {
+                post(layerId: 1, loadId: 1, layerName: "Roads", featuresBuilt: 1000, featureCount: 4000, mapView: mapView)
+                post(layerId: 1, loadId: 2, layerName: "Roads", featuresBuilt: 500, featureCount: 4000, mapView: mapView)
+
+                // the cancelled first load finishing does not clear the progress of the second
+                post(layerId: 1, loadId: 1, mapView: mapView, finished: true)
+                expect(progressView.isHidden).to(beFalse())
+                expect(progressView.label.text).to(equal("Loading Roads 500 of 4000 features"))
+
+                post(layerId: 1, loadId: 1, layerName: "Roads", featuresBuilt: 2000, featureCount: 4000, mapView: mapView)
+                expect(progressView.label.text).to(equal("Loading Roads 500 of 4000 features"))
+
+                post(layerId: 1, loadId: 2, mapView: mapView, finished: true)
+                expect(progressView.isHidden).to(beTrue())
+            }
+        }
+    }
+}
@@ -0,0 +1,97 @@
+//
+//  StaticLayerShapesTests.swift
+//  MAGETests
+//
+//  Copyright © 2026 National Geospatial Intelligence Agency. All rights reserved.
+//
+
+import Foundation
+import Quick
+import Nimble
+import MapKit
+
+@testable import MAGE
+
+class StaticLayerShapesTests: KIFSpec {
+
+    override func spec() {
+
+        func polygonFeature(index: Int, fill: String) -> [AnyHashable: Any] {
+            let longitude = -105.0 + Double(index) * 0.01
+            return [
+                "geometry": [
+                    "type": "Polygon",
+                    "coordinates": [[[longitude, 40.0], [longitude + 0.005, 40.0], [longitude + 0.005, 40.005], [longitude, 40.0]]]
+                ],
+                "properties": [
+                    "name": "Polygon \(index)",
+                    "style": [
+                        "polyStyle": ["color": ["rgb": fill, "opacity": 128]],
+                        "lineStyle": ["color": ["rgb": "#000000", "opacity": 255], "width": "2"]
+                    ]
+                ]
+            ]
+        }
+
+        func lineFeature(index: Int) -> [AnyHashable: Any] {
+            let longitude = -105.0 + Double(index) * 0.01
+            return [
+                "geometry": [
+                    "type": "LineString",
+                    "coordinates": [[longitude, 41.0], [longitude + 0.005, 41.005]]
+                ],
+                "properties": [
+                    "name": "Line \(index)",
+                    "style": ["lineStyle": ["color": ["rgb": "#ff0000", "opacity": 255], "width": 3]]
+                ]
+            ]
+        }
+
+        func pointFeature(index: Int) -> [AnyHashable: Any] {
+            return [
+                "geometry": ["type": "Point", "coordinates": [-105.0 + Double(index) * 0.01, 42.0]],
+                "properties": ["name": "Point \(index)"]
+            ]
+        }
+
+        describe("StaticLayerShapesTests") {
+
+            it("should combine shapes which share a style into one overlay") {
+                var features: [[AnyHashable: Any]] = []
+                for index in 0..<10 {
+                    features.append(polygonFeature(index: index, fill: index % 2 == 0 ? "#00ffff" : "#ff00ff"))
+                    features.append(lineFeature(index: index))
+                    features.append(pointFeature(index: index))
+                }
+                features.append(polygonFeature(index: 20, fill: "#00ff00"))
+
+                guard let shapes = StaticLayerShapes.build(layerName: "layer", features: features) else {
+                    fail("expected shapes")
+                    return
+                }
+                expect(shapes.annotations.count).to(equal(10))
+                expect(shapes.annotations.first?.layerName).to(equal("layer"))
+                expect(shapes.shapes.count).to(equal(21))
+                // two polygon styles, one line style and a single polygon which is not combined
+                expect(shapes.overlays.count).to(equal(4))
+                expect(shapes.overlays.filter { $0 is StyledMultiPolygon }.count).to(equal(2))
+                expect(shapes.overlays.filter { $0 is StyledMultiPolyline }.count).to(equal(1))
+                expect(shapes.overlays.filter { $0 is StyledPolygon }.count).to(equal(1))
+
+                let multiPolyline = shapes.overlays.compactMap { $0 as? StyledMultiPolyline }.first
+                expect(multiPolyline?.polylines.count).to(equal(10))
+                expect(multiPolyline?.lineWidth).to(equal(3))
+
+                // polygons with the same style share the parsed color
+                let polygons = shapes.shapes.compactMap { $0 as? StyledPolygon }
+                expect(polygons[0].fillColor === polygons[2].fillColor).to(beTrue())
+                expect(polygons[0].title).to(equal("Polygon 0"))
+            }
+
+            it("should return nil for a cancelled build") {
+                let features = (0..<10).map { pointFeature(index: $0) }
+                expect(StaticLayerShapes.build(layerName: nil, features: features, isCancelled: { true })).to(beNil())
+            }
+        }
+    }
+}
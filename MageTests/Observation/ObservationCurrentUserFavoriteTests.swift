@@ -0,0 +1,106 @@
+//
+//  ObservationCurrentUserFavoriteTests.swift
+//  MAGETests
+//
+//  Copyright © 2026 National Geospatial Intelligence Agency. All rights reserved.
+//
+
+import Foundation
+import Quick
+import Nimble
+import CoreData
+import MagicalRecord
+
+@testable import MAGE
+
+class ObservationCurrentUserFavoriteTests: KIFSpec {
+
+    override func spec() {
+
+        func createObservation(remoteId: String, favoriteUserIds: [String]) {
+            MagicalRecord.save(blockAndWait: { localContext in
+                let observation = Observation.mr_createEntity(in: localContext)!
+                observation.remoteId = remoteId
+                observation.eventId = 1
+                observation.timestamp = Date()
+                for userId in favoriteUserIds {
+                    if let favorite = ObservationFavorite.favorite(userId: userId, context: localContext) {
+                        favorite.observation = observation
+                        observation.addToFavorites(favorite)
+                    }
+                }
+            })
+        }
+
+        func observation(_ remoteId: String) -> Observation? {
+            let context = NSManagedObjectContext.mr_default()
+            context.reset()
+            return Observation.mr_findFirst(byAttribute: "remoteId", withValue: remoteId, in: context)
+        }
+
+        func favoriteRemoteIds() -> [String] {
+            let fetchRequest = Observation.fetchRequest()
+            fetchRequest.predicate = ObservationCurrentUserFavorite.predicate()
+            fetchRequest.sortDescriptors = [NSSortDescriptor(key: "remoteId", ascending: true)]
+            return ((try? NSManagedObjectContext.mr_default().fetch(fetchRequest)) ?? []).compactMap { $0.remoteId }
+        }
+
+        describe("ObservationCurrentUserFavoriteTests") {
+
+            beforeEach {
+                TestHelpers.clearAndSetUpStack()
+                UserDefaults.standard.currentUserId = "me"
+                Server.setCurrentEventId(1)
+            }
+
+            afterEach {
+                TestHelpers.clearAndSetUpStack()
+            }
+
+            it("should maintain the flag when saving") {
+                createObservation(remoteId: "mine", favoriteUserIds: ["me", "other"])
+                createObservation(remoteId: "theirs", favoriteUserIds: ["other"])
+                expect(observation("mine")?.currentUserFavorite).to(equal(true))
+                expect(observation("theirs")?.currentUserFavorite).to(equal(false))
+
+                // a favorite changed without touching the observation
+                MagicalRecord.save(blockAndWait: { localContext in
+                    let observation = Observation.mr_findFirst(byAttribute: "remoteId", withValue: "mine", in: localContext)
+                    observation?.favoritesMap["me"]?.favorite = false
+                })
+                expect(observation("mine")?.currentUserFavorite).to(equal(false))
+            }
+
+            it("should recompute the flags when the user switches") {
+                createObservation(remoteId: "mine", favoriteUserIds: ["me"])
+                createObservation(remoteId: "theirs", favoriteUserIds: ["other"])
+                ObservationCurrentUserFavorite.updateIfNeeded()
+                expect(ObservationCurrentUserFavorite.isCurrent).to(beTrue())
+                expect(ObservationCurrentUserFavorite.predicate().predicateFormat).to(equal("currentUserFavorite == 1"))
+                expect(favoriteRemoteIds()).to(equal(["mine"]))
+
+                UserDefaults.standard.currentUserId = "other"
+                expect(ObservationCurrentUserFavorite.isCurrent).to(beFalse())
+                // until the flags are recomputed the favorites are searched
+                expect(favoriteRemoteIds()).to(equal(["theirs"]))
+
+                ObservationCurrentUserFavorite.updateIfNeeded()
+                expect(ObservationCurrentUserFavorite.isCurrent).to(beTrue())
+                expect(observation("mine")?.currentUserFavorite).to(equal(false))
+                expect(observation("theirs")?.currentUserFavorite).to(equal(true))
+                expect(favoriteRemoteIds()).to(equal(["theirs"]))
+            }
+
+            it("should tie the favorite to the same user when searching") {
+                // favorited by someone else and unfavorited by the current user
+                createObservation(remoteId: "unfavorited", favoriteUserIds: ["me", "other"])
+                MagicalRecord.save(blockAndWait: { localContext in
+                    let observation = Observation.mr_findFirst(byAttribute: "remoteId", withValue: "unfavorited", in: localContext)
+                    observation?.favoritesMap["me"]?.favorite = false
+                })
+                expect(ObservationCurrentUserFavorite.isCurrent).to(beFalse())
+                expect(favoriteRemoteIds()).to(beEmpty())
+            }
+        }
+    }
+}
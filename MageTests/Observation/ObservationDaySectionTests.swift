@@ -0,0 +1,136 @@
+//
+//  ObservationDaySectionTests.swift
+//  MAGETests
+//
+//  Copyright © 2026 National Geospatial Intelligence Agency. All rights reserved.
+//
+
+import Foundation
+import Quick
+import Nimble
+import CoreData
+import MagicalRecord
+
+@testable import MAGE
+
+class ObservationDaySectionTests: KIFSpec {
+
+    override func spec() {
+
+        // 2020-01-01 02:00 GMT
+        let date = Date(timeIntervalSince1970: 1577844000)
+
+        func createObservations(count: Int, start: Date) {
+            let chunkSize = 5000
+            for chunkStart in stride(from: 0, to: count, by: chunkSize) {
+                autoreleasepool {
+                    MagicalRecord.save(blockAndWait: { localContext in
+                        for index in chunkStart..<min(chunkStart + chunkSize, count) {
+                            let observation = Observation.mr_createEntity(in: localContext)
+                            observation?.remoteId = "observation\(index)"
+                            observation?.eventId = 1
+                            observation?.dirty = false
+                            // about a hundred observations a day
+                            observation?.timestamp = start.addingTimeInterval(-Double(index) * 864)
+                        }
+                    })
+                }
+            }
+        }
+
+        func measureListOpen() {
+            let options = XCTMeasureOptions()
+            options.iterationCount = 3
+            QuickSpec.current.measure(options: options) {
+                NSManagedObjectContext.mr_default().reset()
+                let observations = Observations.list()
+                try? observations.fetchedResultsController.performFetch()
+                // what the first screen of the list touches
+                _ = observations.fetchedResultsController.sections?.first?.name
+                for row in 0..<min(20, observations.fetchedResultsController.sections?.first?.numberOfObjects ?? 0) {
+                    _ = observations.fetchedResultsController.object(at: IndexPath(row: row, section: 0))
+                }
+            }
+        }
+
+        describe("ObservationDaySectionTests") {
+
+            beforeEach {
+                TestHelpers.clearAndSetUpStack()
+                Server.setCurrentEventId(1)
+                NSDate.setDisplayGMT(true)
+            }
+
+            afterEach {
+                TestHelpers.clearAndSetUpStack()
+            }
+
+            it("should key by the day in the display time zone") {
+                expect(ObservationDaySection.key(date: date)).to(equal("2020-01-01"))
+                expect(ObservationDaySection.key(date: date, timeZone: TimeZone(secondsFromGMT: -5 * 3600)!)).to(equal("2019-12-31"))
+                expect(ObservationDaySection.key(date: nil)).to(beNil())
+                let formatter = DateFormatter()
+                formatter.dateStyle = .long
+                formatter.timeZone = TimeZone(secondsFromGMT: 0)
+                expect(ObservationDaySection.title(sectionName: "2020-01-01")).to(equal(formatter.string(from: date)))
+                expect(ObservationDaySection.title(sectionName: "January 1, 2020")).to(equal("January 1, 2020"))
+            }
+
+            it("should maintain the day section when saving") {
+                createObservations(count: 1, start: date)
+                let context = NSManagedObjectContext.mr_default()
+                expect(Observation.mr_findFirst(in: context)?.daySection).to(equal("2020-01-01"))
+
+                MagicalRecord.save(blockAndWait: { localContext in
+                    Observation.mr_findFirst(in: localContext)?.timestamp = date.addingTimeInterval(86400)
+                })
+                expect(Observation.mr_findFirst(in: context)?.daySection).to(equal("2020-01-02"))
+            }
+
+            it("should rewrite the day sections for a new time zone") {
+                createObservations(count: 3, start: date)
+                expect(ObservationDaySection.isCurrent).to(beFalse())
+                expect(ObservationDaySection.sectionNameKeyPath).to(equal("dateSection"))
+
+                ObservationDaySection.updateIfNeeded()
+                expect(ObservationDaySection.isCurrent).to(beTrue())
+                expect(ObservationDaySection.sectionNameKeyPath).to(equal("daySection"))
+
+                NSDate.setDisplayGMT(false)
+                expect(ObservationDaySection.isCurrent).to(equal(TimeZone.current.identifier == "GMT"))
+                ObservationDaySection.updateIfNeeded()
+                expect(ObservationDaySection.isCurrent).to(beTrue())
+                let context = NSManagedObjectContext.mr_default()
+                context.reset()
+                for observation in Observation.mr_findAll(in: context) as? [Observation] ?? [] {
+                    expect(observation.daySection).to(equal(ObservationDaySection.key(date: observation.timestamp, timeZone: TimeZone.current)))
+                }
+            }
+
+            it("should section the list by day") {
+                createObservations(count: 300, start: date)
+                ObservationDaySection.updateIfNeeded()
+
+                let observations = Observations.list()
+                try? observations.fetchedResultsController.performFetch()
+                expect(observations.fetchedResultsController.fetchRequest.fetchBatchSize).to(equal(50))
+                expect(observations.fetchedResultsController.sections?.first?.name).to(equal("2020-01-01"))
+                expect(observations.fetchedResultsController.sections?.count).to(equal(4))
+                expect(observations.fetchedResultsController.fetchedObjects?.count).to(equal(300))
+            }
+
+            it("should measure opening a list of 100k with computed sections") {
+                createObservations(count: 100_000, start: date)
+                expect(Observations.list().fetchedResultsController.sectionNameKeyPath).to(equal("dateSection"))
+                measureListOpen()
+            }
+
+            it("should measure opening a list of 100k with persisted sections") {
+                createObservations(count: 100_000, start: date)
+                ObservationDaySection.updateIfNeeded()
+                expect(Observations.list().fetchedResultsController.sectionNameKeyPath).to(equal("daySection"))
+                measureListOpen()
+            }
+        }
+    }
+}
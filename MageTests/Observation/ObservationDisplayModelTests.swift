@@ -0,0 +1,200 @@
+//
+//  ObservationDisplayModelTests.swift
+//  MAGETests
+//
+//  Copyright © 2026 National Geospatial Intelligence Agency. All rights reserved.
+//
+
+import Foundation
+import Quick
+import Nimble
+import CoreData
+import MagicalRecord
+
+@testable import MAGE
+
+class ObservationDisplayModelTests: KIFSpec {
+
+    override func spec() {
+
+        func createObservations(count: Int) {
+            MagicalRecord.save(blockAndWait: { localContext in
+                let user = User.mr_findFirst(byAttribute: "remoteId", withValue: "userabc", in: localContext)
+                for index in 0..<count {
+                    let observation = Observation.mr_createEntity(in: localContext)
+                    observation?.remoteId = "observation\(index)"
+                    observation?.eventId = 1
+                    observation?.timestamp = Date(timeIntervalSince1970: 1_700_000_000 + Double(index) * 60)
+                    observation?.user = user
+                    observation?.properties = ["forms": [["formId": 26, "type": "Turtle", "notes": "Sighting \(index)"]]]
+                }
+            })
+        }
+
+        func observation(_ remoteId: String) -> Observation? {
+            return Observation.mr_findFirst(byAttribute: "remoteId", withValue: remoteId, in: NSManagedObjectContext.mr_default())
+        }
+
+        describe("ObservationDisplayModelTests") {
+
+            beforeEach {
+                TestHelpers.clearAndSetUpStack()
+                ObservationDisplayModelCache.shared.removeAll()
+                NSDate.setDisplayGMT(true)
+                UserDefaults.standard.currentUserId = "userabc"
+                MageCoreDataFixtures.addEventFromJson(remoteId: 1, name: "Event", formsJson: [[
+                    "id": 26,
+                    "name": "Animals",
+                    "primaryFeedField": "type",
+                    "secondaryFeedField": "notes",
+                    "fields": [
+                        ["id": 1, "name": "type", "title": "Type", "type": "dropdown"],
+                        ["id": 2, "name": "notes", "title": "Notes", "type": "textarea"]
+                    ]
+                ]])
+                MageCoreDataFixtures.addUser(userId: "userabc")
+            }
+
+            afterEach {
+                ObservationDisplayModelCache.shared.waitUntilWarmed()
+                ObservationDisplayModelCache.shared.removeAll()
+                NSDate.setDisplayGMT(false)
+                TestHelpers.clearAndSetUpStack()
+            }
+
+            it("should hold what the card shows") {
+                createObservations(count: 1)
+                guard let observation = observation("observation0") else {
+                    fail("No observation")
+                    return
+                }
+                let model = ObservationDisplayModelCache.shared.model(for: observation)
+
+                expect(model.primaryText).to(equal("Turtle"))
+                expect(model.secondaryText).to(equal("Sighting 0"))
+                expect(model.primaryText).to(equal(observation.primaryFeedFieldText))
+                expect(model.iconPath).to(equal(ObservationImage.imageName(observation: observation)))
+                let timeText = (observation.timestamp! as NSDate).formattedDisplay().uppercased().replacingOccurrences(of: " ", with: "\u{00a0}")
+                expect(model.timestampText).to(equal("\(observation.user?.name?.uppercased() ?? "") \u{2022} \(timeText)"))
+                expect(model.isImportant).to(beFalse())
+                expect(model.hasError).to(beFalse())
+                expect(model.favoriteCount).to(equal(0))
+                expect(model.attachmentCount).to(equal(0))
+            }
+
+            it("should cache the model until the observation is saved") {
+                createObservations(count: 1)
+                guard let observation = observation("observation0") else {
+                    fail("No observation")
+                    return
+                }
+                let cache = ObservationDisplayModelCache.shared
+                let model = cache.model(for: observation)
+                expect(cache.model(for: observation) === model).to(beTrue())
+
+                MagicalRecord.save(blockAndWait: { localContext in
+                    let observation = Observation.mr_findFirst(byAttribute: "remoteId", withValue: "observation0", in: localContext)
+                    observation?.properties = ["forms": [["formId": 26, "type": "Heron"]]]
+                })
+                expect(cache.cachedModel(for: observation.objectID)).to(beNil())
+                expect(cache.model(for: observation).primaryText).to(equal("Heron"))
+            }
+
+            it("should invalidate the observation when a favorite is saved") {
+                createObservations(count: 1)
+                guard let observation = observation("observation0") else {
+                    fail("No observation")
+                    return
+                }
+                let cache = ObservationDisplayModelCache.shared
+                expect(cache.model(for: observation).currentUserFavorited).to(beFalse())
+
+                MagicalRecord.save(blockAndWait: { localContext in
+                    let favorite = ObservationFavorite.favorite(userId: "userabc", context: localContext)
+                    favorite?.observation = Observation.mr_findFirst(byAttribute: "remoteId", withValue: "observation0", in: localContext)
+                })
+                expect(cache.cachedModel(for: observation.objectID)).to(beNil())
+                let model = cache.model(for: observation)
+                expect(model.currentUserFavorited).to(beTrue())
+                expect(model.favoriteCount).to(equal(1))
+            }
+
+            it("should empty the cache when a form is saved") {
+                createObservations(count: 1)
+                guard let observation = observation("observation0") else {
+                    fail("No observation")
+                    return
+                }
+                let cache = ObservationDisplayModelCache.shared
+                _ = cache.model(for: observation)
+                expect(cache.cachedModel(for: observation.objectID)).toNot(beNil())
+
+                MagicalRecord.save(blockAndWait: { localContext in
+                    let form = Form.mr_findFirst(byAttribute: "formId", withValue: 26, in: localContext)
+                    form?.order = 5
+                })
+                expect(cache.cachedModel(for: observation.objectID)).to(beNil())
+            }
+
+            it("should never repeat a version") {
+                createObservations(count: 2)
+                guard let first = observation("observation0")?.objectID, let second = observation("observation1")?.objectID else {
+                    fail("No observations")
+                    return
+                }
+                let cache = ObservationDisplayModelCache(countLimit: 10)
+                var seen: Set<Int> = [cache.version(of: first)]
+                func expectNewVersion(_ objectID: NSManagedObjectID, file: FileString = #file, line: UInt = #line) {
+                    expect(seen.insert(cache.version(of: objectID)).inserted, file: file, line: line).to(beTrue())
+                }
+
+                cache.invalidate(objectIDs: [first])
+                expectNewVersion(first)
+                cache.invalidate(objectIDs: [first])
+                expectNewVersion(first)
+                cache.removeAll()
+                expectNewVersion(first)
+                cache.invalidate(objectIDs: [first])
+                expectNewVersion(first)
+                cache.invalidate(objectIDs: [second])
+                expectNewVersion(second)
+                cache.removeAll()
+                expectNewVersion(second)
+            }
+
+            it("should make the models off of the main thread when warming") {
+                createObservations(count: 50)
+                let objectIDs = (Observation.mr_findAll(in: NSManagedObjectContext.mr_default()) as? [Observation] ?? []).map { $0.objectID }
+                let cache = ObservationDisplayModelCache.shared
+                expect(objectIDs.allSatisfy { cache.cachedModel(for: $0) == nil }).to(beTrue())
+
+                cache.warm(objectIDs: objectIDs)
+                cache.waitUntilWarmed()
+                expect(objectIDs.allSatisfy { cache.cachedModel(for: $0) != nil }).to(beTrue())
+                guard let first = observation("observation0") else {
+                    fail("No observation")
+                    return
+                }
+                expect(cache.cachedModel(for: first.objectID)?.secondaryText).to(equal("Sighting 0"))
+            }
+
+            it("should measure binding cached models") {
+                createObservations(count: 2000)
+                let observations = (Observation.mr_findAll(in: NSManagedObjectContext.mr_default()) as? [Observation] ?? [])
+                let cache = ObservationDisplayModelCache.shared
+                cache.warm(objectIDs: observations.map { $0.objectID })
+                cache.waitUntilWarmed()
+                let cell = ObservationListCardCell(style: .default, reuseIdentifier: nil)
+
+                let options = XCTMeasureOptions()
+                options.iterationCount = 3
+                QuickSpec.current.measure(options: options) {
+                    for observation in observations {
+                        cell.configure(observation: observation, scheme: nil, actionsDelegate: nil, attachmentSelectionDelegate: nil)
+                    }
+                }
+                expect(cache.cachedModel(for: observations[0].objectID)?.objectID).to(equal(observations[0].objectID))
+            }
+        }
+    }
+}
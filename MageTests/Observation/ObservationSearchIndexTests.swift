@@ -0,0 +1,207 @@
+//
+//  ObservationSearchIndexTests.swift
+//  MAGETests
+//
+//  Copyright © 2026 National Geospatial Intelligence Agency. All rights reserved.
+//
+
+import Foundation
+import Quick
+import Nimble
+import CoreData
+import MagicalRecord
+
+@testable import MAGE
+
+class ObservationSearchIndexTests: KIFSpec {
+
+    override func spec() {
+
+        func indexPendingChanges() {
+            PersistentHistoryChangeProcessor.shared.processPendingChanges()
+            ObservationSearchIndex.shared.waitUntilIndexed()
+        }
+
+        func createObservation(remoteId: String, eventId: NSNumber = 1, userName: String = "Jane Smith", form: [String: Any]) {
+            MagicalRecord.save(blockAndWait: { localContext in
+                let user = User.mr_findFirst(byAttribute: "name", withValue: userName, in: localContext) ?? User.mr_createEntity(in: localContext)
+                user?.name = userName
+                let observation = Observation.mr_createEntity(in: localContext)
+                observation?.remoteId = remoteId
+                observation?.eventId = eventId
+                observation?.timestamp = Date()
+                observation?.user = user
+                var observationForm = form
+                observationForm["formId"] = 26
+                observation?.properties = ["forms": [observationForm]]
+            })
+        }
+
+        func remoteIds(_ objectIds: [NSManagedObjectID]) -> [String] {
+            let context = NSManagedObjectContext.mr_default()
+            return objectIds.compactMap { (try? context.existingObject(with: $0) as? Observation)?.remoteId }
+        }
+
+        describe("ObservationSearchIndexTests") {
+
+            beforeEach {
+                TestHelpers.clearAndSetUpStack()
+                MageCoreDataFixtures.addEventFromJson(remoteId: 1, name: "Event", formsJson: [[
+                    "id": 26,
+                    "name": "Animals",
+                    "primaryField": "type",
+                    "variantField": "variant",
+                    "fields": [
+                        ["id": 1, "name": "type", "title": "Type", "type": "dropdown"],
+                        ["id": 2, "name": "variant", "title": "Variant", "type": "textfield"],
+                        ["id": 3, "name": "notes", "title": "Notes", "type": "textarea"],
+                        ["id": 4, "name": "secret", "title": "Secret", "type": "password"]
+                    ]
+                ]])
+                indexPendingChanges()
+            }
+
+            afterEach {
+                TestHelpers.clearAndSetUpStack()
+                indexPendingChanges()
+            }
+
+            it("should only match words by prefix") {
+                expect(ObservationSearchIndex.matchExpression(text: "Tur\" OR bank*")).to(equal("\"tur\"* \"or\"* \"bank\"*"))
+                expect(ObservationSearchIndex.matchExpression(text: " * \" ")).to(beNil())
+            }
+
+            it("should search form values by prefix") {
+                createObservation(remoteId: "turtle", form: ["type": "Turtle", "variant": "Box", "notes": "Found near the river bank", "secret": "hunter2"])
+                indexPendingChanges()
+
+                let index = ObservationSearchIndex.shared
+                expect(remoteIds(index.search(text: "turt", eventId: 1))).to(equal(["turtle"]))
+                expect(remoteIds(index.search(text: "riv ban", eventId: 1))).to(equal(["turtle"]))
+                expect(remoteIds(index.search(text: "jane", eventId: nil))).to(equal(["turtle"]))
+                expect(index.search(text: "river lake", eventId: 1)).to(beEmpty())
+                expect(index.search(text: "turtle", eventId: 2)).to(beEmpty())
+                // passwords are never indexed
+                expect(index.search(text: "hunter2", eventId: nil)).to(beEmpty())
+            }
+
+            it("should rank the primary field first") {
+                createObservation(remoteId: "notes", form: ["type": "Fish", "notes": "A turtle swam past"])
+                createObservation(remoteId: "primary", form: ["type": "Turtle"])
+                createObservation(remoteId: "variant", form: ["type": "Fish", "variant": "Turtle"])
+                indexPendingChanges()
+
+                expect(remoteIds(ObservationSearchIndex.shared.search(text: "turtle", eventId: 1))).to(equal(["primary", "variant", "notes"]))
+            }
+
+            it("should index edits and deletes") {
+                createObservation(remoteId: "edited", form: ["type": "Turtle"])
+                indexPendingChanges()
+
+                MagicalRecord.save(blockAndWait: { localContext in
+                    let observation = Observation.mr_findFirst(byAttribute: "remoteId", withValue: "edited", in: localContext)
+                    observation?.properties = ["forms": [["formId": 26, "type": "Heron"]]]
+                })
+                indexPendingChanges()
+                let index = ObservationSearchIndex.shared
+                expect(index.search(text: "turtle", eventId: 1)).to(beEmpty())
+                expect(remoteIds(index.search(text: "heron", eventId: 1))).to(equal(["edited"]))
+
+                MagicalRecord.save(blockAndWait: { localContext in
+                    Observation.mr_findFirst(byAttribute: "remoteId", withValue: "edited", in: localContext)?.mr_deleteEntity(in: localContext)
+                })
+                indexPendingChanges()
+                expect(index.search(text: "heron", eventId: 1)).to(beEmpty())
+            }
+
+            it("should catch up on the changes saved while it was stopped") {
+                let index = ObservationSearchIndex.shared
+                createObservation(remoteId: "turtle", form: ["type": "Turtle"])
+                indexPendingChanges()
+
+                index.stop()
+                createObservation(remoteId: "heron", form: ["type": "Heron"])
+                // replayed from the token kept in the index
+                index.start()
+                indexPendingChanges()
+                expect(remoteIds(index.search(text: "heron", eventId: 1))).to(equal(["heron"]))
+                expect(remoteIds(index.search(text: "turtle", eventId: 1))).to(equal(["turtle"]))
+            }
+
+            it("should rebuild when the history it missed was purged") {
+                let index = ObservationSearchIndex.shared
+                createObservation(remoteId: "turtle", form: ["type": "Turtle"])
+                indexPendingChanges()
+
+                index.stop()
+                createObservation(remoteId: "heron", form: ["type": "Heron"])
+                PersistentHistoryChangeProcessor.shared.processPendingChanges()
+                let context = NSManagedObjectContext.mr_default()
+                context.performAndWait {
+                    _ = try? context.execute(NSPersistentHistoryChangeRequest.deleteHistory(before: context.persistentStoreCoordinator?.currentPersistentHistoryToken(fromStores: nil)))
+                }
+
+                index.start()
+                indexPendingChanges()
+                expect(remoteIds(index.search(text: "heron", eventId: 1))).to(equal(["heron"]))
+                expect(remoteIds(index.search(text: "turtle", eventId: 1))).to(equal(["turtle"]))
+            }
+
+            it("should remove a deleted index from disk") {
+                createObservation(remoteId: "turtle", form: ["type": "Turtle"])
+                indexPendingChanges()
+                let index = ObservationSearchIndex.shared
+                expect(FileManager.default.fileExists(atPath: ObservationSearchIndex.databasePath)).to(beTrue())
+
+                index.delete()
+                for path in ObservationSearchIndex.databaseFiles {
+                    expect(FileManager.default.fileExists(atPath: path)).to(beFalse(), description: path)
+                }
+                expect(index.search(text: "turtle", eventId: 1)).to(beEmpty())
+
+                // rebuilt from the store when started again
+                index.start()
+                indexPendingChanges()
+                expect(remoteIds(index.search(text: "turtle", eventId: 1))).to(equal(["turtle"]))
+            }
+
+            it("should delete the index when the server data is cleared") {
+                createObservation(remoteId: "turtle", form: ["type": "Turtle"])
+                indexPendingChanges()
+
+                MageInitializer.clearServerSpecificData()
+                indexPendingChanges()
+                let index = ObservationSearchIndex.shared
+                expect(index.search(text: "turtle", eventId: 1)).to(beEmpty())
+
+                createObservation(remoteId: "heron", form: ["type": "Heron"])
+                indexPendingChanges()
+                expect(remoteIds(index.search(text: "heron", eventId: 1))).to(equal(["heron"]))
+            }
+
+            it("should measure searching 20k observations") {
+                let types = ["Turtle", "Heron", "Fish", "Beaver", "Otter"]
+                for chunkStart in stride(from: 0, to: 20_000, by: 5000) {
+                    autoreleasepool {
+                        MagicalRecord.save(blockAndWait: { localContext in
+                            for index in chunkStart..<chunkStart + 5000 {
+                                let observation = Observation.mr_createEntity(in: localContext)
+                                observation?.remoteId = "observation\(index)"
+                                observation?.eventId = 1
+                                observation?.timestamp = Date()
+                                observation?.properties = ["forms": [["formId": 26, "type": types[index % types.count], "notes": "Sighting number \(index) near marker \(index % 100)"]]]
+                            }
+                        })
+                    }
+                }
+                indexPendingChanges()
+
+                let options = XCTMeasureOptions()
+                options.iterationCount = 3
+                QuickSpec.current.measure(options: options) {
+                    expect(ObservationSearchIndex.shared.search(text: "otter mark", eventId: 1, limit: 100).count).to(equal(100))
+                }
+            }
+        }
+    }
+}
@@ -0,0 +1,91 @@
+//
+//  TimeWindowedListTests.swift
+//  MAGETests
+//
+//  Copyright © 2026 National Geospatial Intelligence Agency. All rights reserved.
+//
+
+import Foundation
+import Quick
+import Nimble
+import CoreData
+import MagicalRecord
+
+@testable import MAGE
+
+class TimeWindowedListTests: KIFSpec {
+
+    override func spec() {
+
+        // 2020-01-03 12:00 GMT
+        let now = Date(timeIntervalSince1970: 1578052800)
+
+        describe("TimeWindowedListTests") {
+
+            var controller: NSFetchedResultsController<NSFetchRequestResult>!
+
+            beforeEach {
+                TestHelpers.clearAndSetUpStack()
+                NSDate.setDisplayGMT(true)
+                // two observations each day for three days, newest first
+                MagicalRecord.save(blockAndWait: { localContext in
+                    for index in 0..<6 {
+                        let observation = Observation.mr_createEntity(in: localContext)
+                        observation?.remoteId = "observation\(index)"
+                        observation?.eventId = 1
+                        observation?.timestamp = now.addingTimeInterval(-Double(index) * 12 * 60 * 60)
+                    }
+                })
+                let fetchRequest = NSFetchRequest<NSFetchRequestResult>(entityName: "Observation")
+                fetchRequest.predicate = NSPredicate(format: "timestamp >= %@", now.addingTimeInterval(-3 * 24 * 60 * 60) as NSDate)
+                fetchRequest.sortDescriptors = [NSSortDescriptor(key: "timestamp", ascending: false)]
+                fetchRequest.fetchBatchSize = 2
+                controller = NSFetchedResultsController(fetchRequest: fetchRequest, managedObjectContext: NSManagedObjectContext.mr_default(), sectionNameKeyPath: "daySection", cacheName: nil)
+                try? controller.performFetch()
+            }
+
+            afterEach {
+                controller = nil
+                TestHelpers.clearAndSetUpStack()
+            }
+
+            it("should hide the rows which aged out when advancing") {
+                let timeWindow = TimeWindowedList(field: "timestamp")
+                timeWindow.reset(windowStart: now.addingTimeInterval(-3 * 24 * 60 * 60))
+                expect(timeWindow.numberOfSections(controller: controller)).to(equal(3))
+                expect(timeWindow.numberOfRows(inSection: 2, controller: controller)).to(equal(2))
+
+                // the oldest observation, 2020-01-01 00:00
+                var changes = timeWindow.advance(to: now.addingTimeInterval(-2 * 24 * 60 * 60 - 1), controller: controller)
+                expect(changes.sections).to(equal(IndexSet()))
+                expect(changes.rows).to(equal([IndexPath(row: 1, section: 2)]))
+                expect(timeWindow.numberOfRows(inSection: 2, controller: controller)).to(equal(1))
+
+                // the rest of 2020-01-01 and the first observation of 2020-01-02
+                changes = timeWindow.advance(to: now.addingTimeInterval(-24 * 60 * 60 - 1), controller: controller)
+                expect(changes.sections).to(equal(IndexSet(integer: 2)))
+                expect(changes.rows).to(equal([IndexPath(row: 1, section: 1)]))
+                expect(timeWindow.hiddenCount).to(equal(3))
+                expect(timeWindow.numberOfSections(controller: controller)).to(equal(2))
+                expect(timeWindow.numberOfRows(inSection: 1, controller: controller)).to(equal(1))
+
+                // counts are worked out again from the controller after it changes
+                timeWindow.invalidate()
+                expect(timeWindow.numberOfSections(controller: controller)).to(equal(2))
+                expect(timeWindow.numberOfRows(inSection: 0, controller: controller)).to(equal(2))
+                expect(timeWindow.numberOfRows(inSection: 1, controller: controller)).to(equal(1))
+
+                // nothing else aged out
+                expect(timeWindow.advance(to: now.addingTimeInterval(-24 * 60 * 60), controller: controller).rows.isEmpty).to(beTrue())
+            }
+
+            it("should show every row without a time filter") {
+                let timeWindow = TimeWindowedList(field: "timestamp")
+                timeWindow.reset(windowStart: nil)
+                let changes = timeWindow.advance(to: now, controller: controller)
+                expect(changes.sections.isEmpty && changes.rows.isEmpty).to(beTrue())
+                expect(timeWindow.numberOfSections(controller: controller)).to(equal(3))
+            }
+        }
+    }
+}
@@ -0,0 +1,83 @@
+//
+//  AnnotationImageCacheTests.swift
+//  MAGETests
+//
+//  Copyright © 2026 National Geospatial Intelligence Agency. All rights reserved.
+//
+
+import Foundation
+import Quick
+import Nimble
+
+@testable import MAGE
+
+class AnnotationImageCacheTests: KIFSpec {
+
+    override func spec() {
+
+        describe("AnnotationImageCacheTests") {
+
+            var imagePath: String!
+
+            beforeEach {
+                TestHelpers.clearDocuments()
+                let image = UIGraphicsImageRenderer(size: CGSize(width: 100, height: 200)).image { context in
+                    UIColor.red.setFill()
+                    context.fill(CGRect(x: 0, y: 0, width: 100, height: 200))
+                }
+                imagePath = "\(ObservationImage.getDocumentsDirectory())/annotationImageCacheTest.png"
+                FileManager.default.createFile(atPath: imagePath, contents: image.pngData(), attributes: nil)
+            }
+
+            afterEach {
+                TestHelpers.clearDocuments()
+            }
+
+            it("should scale the image to the width") {
+                let cache = AnnotationImageCache()
+                let image = cache.image(path: imagePath, width: 35)
+                expect(image?.size.width ?? 0).to(beCloseTo(35, within: 0.001))
+                expect(image?.size.height ?? 0).to(beCloseTo(70, within: 0.001))
+                expect(image?.scale).to(equal(UIScreen.main.scale))
+                expect(cache.image(path: "\(imagePath!).missing", width: 35)).to(beNil())
+            }
+
+            it("should return the cached image") {
+                let cache = AnnotationImageCache()
+                let image = cache.image(path: imagePath, width: 35)
+                expect(image === cache.image(path: imagePath, width: 35)).to(beTrue())
+                expect(image === cache.image(path: imagePath, width: 40)).to(beFalse())
+            }
+
+            it("should make the tint part of the key") {
+                let cache = AnnotationImageCache()
+                let source = UIImage(contentsOfFile: imagePath)!
+                let red = cache.image(named: "test", image: source, width: 35, tint: .red)
+                let blue = cache.image(named: "test", image: source, width: 35, tint: .blue)
+                expect(red === blue).to(beFalse())
+                expect(red === cache.image(named: "test", image: source, width: 35, tint: .red)).to(beTrue())
+            }
+
+            it("should empty the cache on a memory warning") {
+                let cache = AnnotationImageCache()
+                let image = cache.image(path: imagePath, width: 35)!
+                let key = AnnotationImageCache.key(source: imagePath, width: 35)
+                expect(cache.image(forKey: key) === image).to(beTrue())
+
+                NotificationCenter.default.post(name: UIApplication.didReceiveMemoryWarningNotification, object: nil)
+                expect(cache.image(forKey: key)).to(beNil())
+            }
+
+            it("should evict images over the cost limit") {
+                let image = UIImage(contentsOfFile: imagePath)!
+                let scaled = AnnotationImageCache.scale(image: image, width: 35)
+                // room for a single image
+                let cache = AnnotationImageCache(totalCostLimit: AnnotationImageCache.cost(image: scaled) + 1)
+                cache.setImage(scaled, forKey: "first")
+                cache.setImage(scaled, forKey: "second")
+                expect(cache.image(forKey: "first")).to(beNil())
+                expect(cache.image(forKey: "second")).toNot(beNil())
+            }
+        }
+    }
+}
@@ -0,0 +1,263 @@
+//
+//  FetchIndexQueryPlanTests.swift
+//  MAGETests
+//
+//  Copyright © 2026 National Geospatial Intelligence Agency. All rights reserved.
+//
+
+import Foundation
+import Quick
+import Nimble
+import CoreData
+import MagicalRecord
+import SQLite3
+import OSLog
+
+@testable import MAGE
+
+/// Runs the hot fetches the app makes against a large store and asks SQLite how it plans the SQL Core Data
+/// ran for them, failing when a query scans a whole table or sorts without an index.  SQLDebug is turned on
+/// before the store is built so Core Data logs its SQL, which is read back from the unified log of this process.
+class FetchIndexQueryPlanTests: KIFSpec {
+
+    static let observationCount = 50_000
+    static let locationCount = 20_000
+    static let userCount = 1_000
+    static let sqlDebugKey = "com.apple.CoreData.SQLDebug"
+
+    // the fixture takes a while to build, every test shares it
+    override class func setUp() {
+        super.setUp()
+        UserDefaults.standard.set(1, forKey: sqlDebugKey)
+        TestHelpers.clearAndSetUpStack()
+        createFixture()
+    }
+
+    override class func tearDown() {
+        TestHelpers.clearAndSetUpStack()
+        UserDefaults.standard.removeObject(forKey: sqlDebugKey)
+        super.tearDown()
+    }
+
+    private static func createFixture() {
+        let chunkSize = 5000
+        for chunkStart in stride(from: 0, to: FetchIndexQueryPlanTests.observationCount, by: chunkSize) {
+            autoreleasepool {
+                MagicalRecord.save(blockAndWait: { localContext in
+                    for index in chunkStart..<chunkStart + chunkSize {
+                        let observation = Observation.mr_createEntity(in: localContext)!
+                        observation.remoteId = "observation\(index)"
+                        observation.eventId = NSNumber(value: index % 5)
+                        observation.timestamp = Date(timeIntervalSince1970: Double(index) * 60)
+                        observation.dirty = index % 100 == 0
+                        if index % 10 == 0, let attachment = Attachment.mr_createEntity(in: localContext) {
+                            attachment.remoteId = "attachment\(index)"
+                            attachment.dirty = index % 1000 == 0
+                            attachment.observation = observation
+                        }
+                        if index % 20 == 0, let favorite = ObservationFavorite.favorite(userId: "user\(index % FetchIndexQueryPlanTests.userCount)", context: localContext) {
+                            favorite.observation = observation
+                            favorite.dirty = index % 1000 == 0
+                        }
+                        if index % 50 == 0, let important = ObservationImportant.mr_createEntity(in: localContext) {
+                            important.important = true
+                            important.dirty = index % 1000 == 0
+                            important.observation = observation
+                        }
+                    }
+                })
+            }
+        }
+        for chunkStart in stride(from: 0, to: FetchIndexQueryPlanTests.locationCount, by: chunkSize) {
+            autoreleasepool {
+                MagicalRecord.save(blockAndWait: { localContext in
+                    for index in chunkStart..<chunkStart + chunkSize {
+                        let location = Location.mr_createEntity(in: localContext)!
+                        location.remoteId = "location\(index)"
+                        location.eventId = NSNumber(value: index % 5)
+                        location.timestamp = Date(timeIntervalSince1970: Double(index) * 60)
+                    }
+                })
+            }
+        }
+        MagicalRecord.save(blockAndWait: { localContext in
+            for index in 0..<FetchIndexQueryPlanTests.userCount {
+                let user = User.mr_createEntity(in: localContext)
+                user?.remoteId = "user\(index)"
+                user?.name = "User \(index)"
+            }
+            for index in 0..<100 {
+                let event = Event.mr_createEntity(in: localContext)
+                event?.remoteId = NSNumber(value: index)
+                for layerIndex in 0..<4 {
+                    let layer = (layerIndex % 2 == 0 ? StaticLayer.mr_createEntity(in: localContext) : Layer.mr_createEntity(in: localContext))
+                    layer?.eventId = NSNumber(value: index)
+                    layer?.remoteId = NSNumber(value: index * 4 + layerIndex)
+                }
+                for formIndex in 0..<4 {
+                    let form = Form.mr_createEntity(in: localContext)
+                    form?.eventId = NSNumber(value: index)
+                    form?.formId = NSNumber(value: index * 4 + formIndex)
+                }
+                let feed = Feed.mr_createEntity(in: localContext)
+                feed?.eventId = NSNumber(value: index)
+                feed?.remoteId = "feed\(index)"
+            }
+        })
+    }
+
+    override func spec() {
+
+        var storeURL: URL? {
+            return NSManagedObjectContext.mr_default().persistentStoreCoordinator?.persistentStores.first?.url
+        }
+
+        /// The SQL Core Data logged since the date
+        func loggedSQL(since date: Date) throws -> [String] {
+            let store = try OSLogStore(scope: .currentProcessIdentifier)
+            let entries = try store.getEntries(at: store.position(date: date), matching: NSPredicate(format: "subsystem == %@", "com.apple.coredata"))
+            return entries.compactMap { entry in
+                guard let log = entry as? OSLogEntryLog else {
+                    return nil
+                }
+                var message = Substring(log.composedMessage)
+                for prefix in ["CoreData: ", "sql: "] where message.hasPrefix(prefix) {
+                    message = message.dropFirst(prefix.count)
+                }
+                return message.hasPrefix("SELECT") ? String(message) : nil
+            }
+        }
+
+        /// The details of the query plan, one line per step
+        func queryPlan(_ sql: String) -> [String] {
+            guard let storeURL = storeURL else {
+                fail("No store")
+                return []
+            }
+            var db: OpaquePointer?
+            guard sqlite3_open_v2(storeURL.path, &db, SQLITE_OPEN_READONLY, nil) == SQLITE_OK else {
+                fail("Could not open \(storeURL.path)")
+                return []
+            }
+            defer { sqlite3_close(db) }
+            var statement: OpaquePointer?
+            guard sqlite3_prepare_v2(db, "EXPLAIN QUERY PLAN \(sql)", -1, &statement, nil) == SQLITE_OK else {
+                fail("Could not explain \(sql): \(String(cString: sqlite3_errmsg(db)))")
+                return []
+            }
+            defer { sqlite3_finalize(statement) }
+            var details: [String] = []
+            while sqlite3_step(statement) == SQLITE_ROW {
+                if let detail = sqlite3_column_text(statement, 3) {
+                    details.append(String(cString: detail))
+                }
+            }
+            return details
+        }
+
+        /// Run the fetch and check the plan of every query Core Data ran against the table.  Batched fetches fault
+        /// their rows in by primary key from a temporary id table, scanning that table is expected.
+        func expectIndexed(_ name: String, table: String, file: FileString = #file, line: UInt = #line, fetch: @escaping () throws -> Void) {
+            let start = Date()
+            expect(file, line: line) { try fetch() }.toNot(throwError(), description: name)
+            let elapsed = -start.timeIntervalSinceNow
+            guard let logged = try? loggedSQL(since: start) else {
+                fail("\(name): could not read the log", file: file, line: line)
+                return
+            }
+            let statements = logged.filter { $0.contains(" FROM \(table) ") }
+            expect(statements.isEmpty, file: file, line: line).to(beFalse(), description: "\(name): no SQL logged for \(table), is \(FetchIndexQueryPlanTests.sqlDebugKey) set?")
+            for sql in statements {
+                let plan = queryPlan(sql)
+                NSLog("QUERY PLAN \(name) in \(elapsed) seconds: \(sql) => \(plan.joined(separator: " | "))")
+                expect(plan.isEmpty, file: file, line: line).to(beFalse(), description: name)
+                for detail in plan where !detail.contains("_Z_intarray") {
+                    expect(detail.hasPrefix("SCAN"), file: file, line: line).to(beFalse(), description: "\(name) scans: \(detail) in \(sql)")
+                    expect(detail.contains("TEMP B-TREE"), file: file, line: line).to(beFalse(), description: "\(name) sorts without an index: \(detail) in \(sql)")
+                }
+            }
+        }
+
+        describe("FetchIndexQueryPlanTests") {
+
+            afterEach {
+                Observations.setFavoritesFilter(false)
+            }
+
+            it("should use indexes for the observation list") {
+                UserDefaults.standard.currentEventId = 1
+                expectIndexed("observation list", table: "ZOBSERVATION") {
+                    try Observations.list().fetchedResultsController.performFetch()
+                }
+                Observations.setFavoritesFilter(true)
+                expectIndexed("favorite observation list", table: "ZOBSERVATION") {
+                    try Observations.list().fetchedResultsController.performFetch()
+                }
+            }
+
+            it("should use indexes for the push service fetches") {
+                let context = NSManagedObjectContext.mr_default()
+                expectIndexed("dirty observations", table: "ZOBSERVATION") {
+                    _ = ObservationPushService.dirtyObservations(context: context)
+                }
+                expectIndexed("dirty favorites", table: "ZOBSERVATIONFAVORITE") {
+                    _ = ObservationPushService.dirtyFavorites(context: context)
+                }
+                expectIndexed("dirty importants", table: "ZOBSERVATIONIMPORTANT") {
+                    _ = ObservationPushService.dirtyImportants(context: context)
+                }
+                expectIndexed("dirty attachments", table: "ZATTACHMENT") {
+                    _ = Attachment.dirtyAttachments(context: context)
+                }
+            }
+
+            it("should use indexes for the location list") {
+                UserDefaults.standard.currentEventId = 1
+                expectIndexed("location list", table: "ZLOCATION") {
+                    try Locations.forAllUsers().fetchedResultsController.performFetch()
+                }
+                expectIndexed("location by remote id", table: "ZLOCATION") {
+                    _ = Location.mr_findFirst(byAttribute: "remoteId", withValue: "location10", in: NSManagedObjectContext.mr_default())
+                }
+            }
+
+            it("should use an index for an observation by remote id") {
+                expectIndexed("observation by remote id", table: "ZOBSERVATION") {
+                    _ = Observation.mr_findFirst(byAttribute: "remoteId", withValue: "observation10", in: NSManagedObjectContext.mr_default())
+                }
+            }
+
+            it("should use indexes for the event scoped fetches") {
+                let context = NSManagedObjectContext.mr_default()
+                // static layers share the layer table, the same lookups as StaticLayerMap, CacheOverlays and FeedItemRetriever
+                expectIndexed("static layer in event", table: "ZLAYER") {
+                    _ = StaticLayer.mr_findFirst(with: NSPredicate(format: "remoteId == %@ AND eventId == %@", NSNumber(value: 4), NSNumber(value: 1)), in: context)
+                }
+                expectIndexed("layer in event", table: "ZLAYER") {
+                    _ = Layer.mr_countOfEntities(with: NSPredicate(format: "eventId == %@ AND remoteId == %ld", NSNumber(value: 1), 5), in: context)
+                }
+                expectIndexed("feed in event", table: "ZFEED") {
+                    _ = Feed.mr_findFirst(with: NSPredicate(format: "remoteId == %@ AND eventId == %@", "feed1", NSNumber(value: 1)), in: context)
+                }
+                let event = Event.mr_findFirst(byAttribute: "remoteId", withValue: NSNumber(value: 1), in: context)
+                expect(event).toNot(beNil())
+                expectIndexed("form in event", table: "ZFORM") {
+                    _ = event?.form(id: NSNumber(value: 5))
+                }
+                expectIndexed("recent events", table: "ZEVENT") {
+                    _ = Event.mr_findAll(with: NSPredicate(format: "(remoteId IN %@)", [1, 2, 3]), in: context)
+                }
+            }
+
+            it("should use indexes for the user fetches") {
+                let context = NSManagedObjectContext.mr_default()
+                expectIndexed("users by remote id", table: "ZUSER") {
+                    _ = User.mr_findAll(with: NSPredicate(format: "remoteId IN %@", ["user1", "user2", "user3"]), in: context)
+                }
+                expectIndexed("user by remote id", table: "ZUSER") {
+                    _ = User.mr_findFirst(byAttribute: "remoteId", withValue: "user1", in: context)
+                }
+            }
+        }
+    }
+}
@@ -0,0 +1,90 @@
+//
+//  GeometryCacheTests.swift
+//  MAGETests
+//
+//  Copyright © 2026 National Geospatial Intelligence Agency. All rights reserved.
+//
+
+import Foundation
+import Quick
+import Nimble
+import SimpleFeatures
+import MagicalRecord
+
+@testable import MAGE
+
+class GeometryCacheTests: KIFSpec {
+
+    override func spec() {
+
+        func savedObservation(geometry: SFGeometry) -> Observation {
+            let context = NSManagedObjectContext.mr_default()
+            let observation = Observation.create(geometry: geometry, accuracy: 4.5, provider: "gps", delta: 2, context: context)
+            try? context.obtainPermanentIDs(for: [observation])
+            context.mr_saveToPersistentStoreAndWait()
+            GeometryCache.shared.removeAll()
+            return observation
+        }
+
+        describe("GeometryCacheTests") {
+
+            beforeEach {
+                TestHelpers.clearAndSetUpStack()
+                MageCoreDataFixtures.addEventWithCurrentUser()
+            }
+
+            afterEach {
+                GeometryCache.shared.removeAll()
+                TestHelpers.clearAndSetUpStack()
+            }
+
+            it("should hit the cache on repeated access") {
+                let observation = savedObservation(geometry: SFPoint(x: 15, andY: 20))
+
+                expect(observation.geometry).to(equal(SFPoint(x: 15, andY: 20)))
+                // the centroid is read through the cache too, one read of the location is one hit
+                let location = observation.location
+                expect(location?.coordinate.latitude).to(equal(20))
+                expect(location?.coordinate.longitude).to(equal(15))
+                _ = observation.geometry
+
+                expect(GeometryCache.shared.misses).to(equal(1))
+                expect(GeometryCache.shared.hits).to(equal(2))
+            }
+
+            it("should let the returned geometry be mutated without affecting the cache") {
+                let observation = savedObservation(geometry: SFPoint(x: 15, andY: 20))
+
+                let point = observation.geometry as? SFPoint
+                point?.x = 40
+
+                expect(observation.geometry).to(equal(SFPoint(x: 15, andY: 20)))
+            }
+
+            it("should not serve a changed geometry from the cache") {
+                let observation = savedObservation(geometry: SFPoint(x: 15, andY: 20))
+                _ = observation.geometry
+
+                observation.geometry = SFPoint(x: 30, andY: 40)
+
+                expect(observation.geometry).to(equal(SFPoint(x: 30, andY: 40)))
+                expect(observation.location?.coordinate.latitude).to(equal(40))
+            }
+
+            it("should invalidate the entry on a save in another context") {
+                let observation = savedObservation(geometry: SFPoint(x: 15, andY: 20))
+                _ = observation.geometry
+                expect(GeometryCache.shared.misses).to(equal(1))
+
+                MagicalRecord.save(blockAndWait: { localContext in
+                    let localObservation = observation.mr_(in: localContext)
+                    localObservation?.geometry = SFPoint(x: 30, andY: 40)
+                })
+                NSManagedObjectContext.mr_default().refresh(observation, mergeChanges: false)
+
+                expect(observation.geometry).to(equal(SFPoint(x: 30, andY: 40)))
+                expect(GeometryCache.shared.misses).to(equal(2))
+            }
+        }
+    }
+}
@@ -0,0 +1,118 @@
+//
+//  GeometryDataTransformerTests.swift
+//  MAGETests
+//
+//  Copyright © 2026 National Geospatial Intelligence Agency. All rights reserved.
+//
+
+import Foundation
+import Quick
+import Nimble
+import SimpleFeatures
+import MagicalRecord
+
+@testable import MAGE
+
+class GeometryDataTransformerTests: KIFSpec {
+
+    override func spec() {
+
+        func polygon(index: Int) -> SFPolygon {
+            let longitude = Double(index % 360) - 180
+            let latitude = Double(index % 170) - 85
+            return SFPolygon(ring: SFLineString(points: [
+                SFPoint(xValue: longitude, andYValue: latitude) as Any,
+                SFPoint(xValue: longitude + 0.1, andYValue: latitude) as Any,
+                SFPoint(xValue: longitude + 0.1, andYValue: latitude + 0.1) as Any,
+                SFPoint(xValue: longitude, andYValue: latitude + 0.1) as Any,
+                SFPoint(xValue: longitude, andYValue: latitude) as Any
+            ]))
+        }
+
+        // 100k geometries, nine points for every polygon, roughly what a large event contains
+        func fixtureGeometries() -> [SFGeometry] {
+            return (0..<100_000).map { index in
+                if index % 10 == 0 {
+                    return polygon(index: index)
+                }
+                return SFPoint(xValue: Double(index % 360) - 180, andYValue: Double(index % 170) - 85)
+            }
+        }
+
+        describe("GeometryDataTransformerTests") {
+
+            beforeEach {
+                TestHelpers.clearAndSetUpStack()
+                MageCoreDataFixtures.addEventWithCurrentUser()
+            }
+
+            afterEach {
+                GeometryCache.shared.removeAll()
+                TestHelpers.clearAndSetUpStack()
+            }
+
+            it("should round trip geometries through well known binary") {
+                let point = SFPoint(x: 15, andY: 20)
+                let data = GeometryDataTransformer.encode(point)
+                expect(data).toNot(beNil())
+                expect(GeometryDataTransformer.isKeyedArchive(data!)).to(beFalse())
+                expect(GeometryDataTransformer.decode(data!)).to(equal(point))
+
+                let polygon = polygon(index: 10)
+                expect(GeometryDataTransformer.encode(polygon).flatMap { GeometryDataTransformer.decode($0) }).to(equal(polygon))
+            }
+
+            it("should read legacy keyed archives") {
+                let point = SFPoint(x: 15, andY: 20)
+                let legacy = SFGeometryUtils.encode(point)!
+                expect(GeometryDataTransformer.isKeyedArchive(legacy)).to(beTrue())
+                expect(GeometryDataTransformer.decode(legacy)).to(equal(point))
+            }
+
+            it("should rewrite legacy rows when migrating") {
+                let context = NSManagedObjectContext.mr_default()
+                let observation = Observation.create(geometry: SFPoint(x: 15, andY: 20), accuracy: 4.5, provider: "gps", delta: 2, context: context)
+                observation.geometryData = SFGeometryUtils.encode(SFPoint(x: 15, andY: 20))
+                context.mr_saveToPersistentStoreAndWait()
+
+                expect(GeometryStorageMigration.migrate(entityName: "Observation")).to(equal(1))
+                // the entity is marked complete and not scanned again
+                expect(GeometryStorageMigration.migrate(entityName: "Observation")).to(equal(0))
+
+                context.refresh(observation, mergeChanges: false)
+                expect(GeometryDataTransformer.isKeyedArchive(observation.geometryData!)).to(beFalse())
+                expect(observation.geometry).to(equal(SFPoint(x: 15, andY: 20)))
+            }
+
+            it("should store 100k geometries in fewer bytes than keyed archives") {
+                let geometries = fixtureGeometries()
+                let keyedArchiveBytes = geometries.reduce(0) { $0 + (SFGeometryUtils.encode($1)?.count ?? 0) }
+                let wkbBytes = geometries.reduce(0) { $0 + (GeometryDataTransformer.encode($1)?.count ?? 0) }
+                NSLog("BENCHMARK geometry storage keyed archive: \(keyedArchiveBytes) bytes well known binary: \(wkbBytes) bytes")
+                expect(wkbBytes).to(beLessThan(keyedArchiveBytes))
+            }
+
+            it("should measure decoding keyed archives") {
+                let encoded = fixtureGeometries().compactMap { SFGeometryUtils.encode($0) }
+                let options = XCTMeasureOptions()
+                options.iterationCount = 3
+                QuickSpec.current.measure(options: options) {
+                    for data in encoded {
+                        _ = SFGeometryUtils.decodeGeometry(data)
+                    }
+                }
+            }
+
+            it("should measure decoding well known binary") {
+                let encoded = fixtureGeometries().compactMap { GeometryDataTransformer.encode($0) }
+                let options = XCTMeasureOptions()
+                options.iterationCount = 3
+                QuickSpec.current.measure(options: options) {
+                    for data in encoded {
+                        _ = GeometryDataTransformer.decode(data)
+                    }
+                }
+            }
+        }
+    }
+}
@@ -0,0 +1,135 @@
+//
+//  GeometryEnvelopeTests.swift
+//  MAGETests
+//
+//  Copyright © 2026 National Geospatial Intelligence Agency. All rights reserved.
+//
+
+import Foundation
+import Quick
+import Nimble
+import MapKit
+import SimpleFeatures
+import MagicalRecord
+
+@testable import MAGE
+
+class GeometryEnvelopeTests: KIFSpec {
+
+    override func spec() {
+
+        func mapRect(west: Double, south: Double, east: Double, north: Double) -> MKMapRect {
+            let northWest = MKMapPoint(CLLocationCoordinate2D(latitude: north, longitude: west))
+            let southEast = MKMapPoint(CLLocationCoordinate2D(latitude: south, longitude: east))
+            return MKMapRect(x: northWest.x, y: northWest.y, width: southEast.x - northWest.x, height: southEast.y - northWest.y)
+        }
+
+        describe("GeometryEnvelopeTests") {
+
+            beforeEach {
+                TestHelpers.clearAndSetUpStack()
+                MageCoreDataFixtures.addEventWithCurrentUser()
+            }
+
+            afterEach {
+                TestHelpers.clearAndSetUpStack()
+            }
+
+            it("should maintain the envelope when the geometry is set") {
+                let observation = Observation.create(geometry: SFLineString(points: [
+                    SFPoint(xValue: 10, andYValue: 20) as Any,
+                    SFPoint(xValue: 12, andYValue: 25) as Any
+                ]), accuracy: 4.5, provider: "gps", delta: 2, context: NSManagedObjectContext.mr_default())
+
+                expect(observation.minLongitude?.doubleValue).to(equal(10))
+                expect(observation.maxLongitude?.doubleValue).to(equal(12))
+                expect(observation.minLatitude?.doubleValue).to(equal(20))
+                expect(observation.maxLatitude?.doubleValue).to(equal(25))
+
+                observation.geometry = SFPoint(x: -5, andY: -6)
+                expect(observation.minLongitude?.doubleValue).to(equal(-5))
+                expect(observation.maxLatitude?.doubleValue).to(equal(-6))
+
+                observation.geometry = nil
+                expect(observation.minLatitude).to(beNil())
+            }
+
+            it("should fetch observations intersecting a map rect") {
+                let context = NSManagedObjectContext.mr_default()
+                let inside = Observation.create(geometry: SFPoint(x: 15, andY: 20), accuracy: 4.5, provider: "gps", delta: 2, context: context)
+                _ = Observation.create(geometry: SFPoint(x: -100, andY: 40), accuracy: 4.5, provider: "gps", delta: 2, context: context)
+                // a line which crosses the rect without having a vertex in it
+                let crossing = Observation.create(geometry: SFLineString(points: [
+                    SFPoint(xValue: 0, andYValue: 21) as Any,
+                    SFPoint(xValue: 30, andYValue: 21) as Any
+                ]), accuracy: 4.5, provider: "gps", delta: 2, context: context)
+
+                let observations = Observation.fetchObservations(intersecting: mapRect(west: 10, south: 15, east: 20, north: 25), context: context)
+                expect(Set(observations)).to(equal(Set([inside, crossing])))
+            }
+
+            it("should fetch observations across the antimeridian") {
+                let context = NSManagedObjectContext.mr_default()
+                let east = Observation.create(geometry: SFPoint(x: 179, andY: 0), accuracy: 4.5, provider: "gps", delta: 2, context: context)
+                let west = Observation.create(geometry: SFPoint(x: -179, andY: 0), accuracy: 4.5, provider: "gps", delta: 2, context: context)
+                _ = Observation.create(geometry: SFPoint(x: 0, andY: 0), accuracy: 4.5, provider: "gps", delta: 2, context: context)
+
+                var rect = mapRect(west: 170, south: -5, east: 180, north: 5)
+                rect.size.width *= 2
+                let observations = Observation.fetchObservations(intersecting: rect, context: context)
+                expect(Set(observations)).to(equal(Set([east, west])))
+            }
+
+            it("should fetch observations with a rect which wraps to the west") {
+                let context = NSManagedObjectContext.mr_default()
+                let east = Observation.create(geometry: SFPoint(x: 179, andY: 0), accuracy: 4.5, provider: "gps", delta: 2, context: context)
+                let west = Observation.create(geometry: SFPoint(x: -179, andY: 0), accuracy: 4.5, provider: "gps", delta: 2, context: context)
+                _ = Observation.create(geometry: SFPoint(x: 0, andY: 0), accuracy: 4.5, provider: "gps", delta: 2, context: context)
+
+                // from 170 east across the antimeridian to 170 west, starting one world to the west
+                var rect = mapRect(west: -180, south: -5, east: -170, north: 5)
+                rect.origin.x -= rect.size.width
+                rect.size.width *= 2
+                expect(rect.minX).to(beLessThan(MKMapRect.world.minX))
+                let observations = Observation.fetchObservations(intersecting: rect, context: context)
+                expect(Set(observations)).to(equal(Set([east, west])))
+            }
+
+            it("should not backfill geometries without an envelope again") {
+                let context = NSManagedObjectContext.mr_default()
+                let observation = Observation.create(geometry: SFGeometryCollection(), accuracy: 4.5, provider: "gps", delta: 2, context: context)
+                expect(observation.geometryData).toNot(beNil())
+                expect(observation.minLatitude?.doubleValue).to(equal(91))
+
+                observation.minLatitude = nil
+                observation.maxLatitude = nil
+                observation.minLongitude = nil
+                observation.maxLongitude = nil
+                context.mr_saveToPersistentStoreAndWait()
+
+                expect(GeometryEnvelopeBackfill.backfill(Observation.self)).to(equal(1))
+                expect(GeometryEnvelopeBackfill.backfill(Observation.self)).to(equal(0))
+                context.refresh(observation, mergeChanges: false)
+                expect(observation.minLatitude?.doubleValue).to(equal(91))
+                // the empty envelope matches no map rect
+                expect(Observation.fetchObservations(intersecting: MKMapRect.world, context: context)).to(beEmpty())
+            }
+
+            it("should backfill missing envelopes") {
+                let observation = Observation.create(geometry: SFPoint(x: 15, andY: 20), accuracy: 4.5, provider: "gps", delta: 2, context: NSManagedObjectContext.mr_default())
+                observation.minLatitude = nil
+                observation.maxLatitude = nil
+                observation.minLongitude = nil
+                observation.maxLongitude = nil
+                NSManagedObjectContext.mr_default().mr_saveToPersistentStoreAndWait()
+
+                expect(GeometryEnvelopeBackfill.backfill(Observation.self)).to(equal(1))
+                expect(GeometryEnvelopeBackfill.backfill(Observation.self)).to(equal(0))
+
+                NSManagedObjectContext.mr_default().refresh(observation, mergeChanges: false)
+                expect(observation.minLatitude?.doubleValue).to(equal(20))
+                expect(observation.minLongitude?.doubleValue).to(equal(15))
+            }
+        }
+    }
+}
@@ -0,0 +1,142 @@
+//
+//  ListPrefetchCoordinatorTests.swift
+//  MAGETests
+//
+//  Copyright © 2026 National Geospatial Intelligence Agency. All rights reserved.
+//
+
+import Foundation
+import Quick
+import Nimble
+import CoreData
+import Kingfisher
+import MagicalRecord
+
+@testable import MAGE
+
+class ListPrefetchCoordinatorTests: KIFSpec {
+
+    override func spec() {
+
+        describe("ListPrefetchCoordinatorTests") {
+
+            let attachmentUrl = "https://magetest/api/events/1/observations/observationabc/attachments/attachmentabc"
+
+            func user() -> User? {
+                return User.mr_findFirst(byAttribute: "remoteId", withValue: "userabc", in: NSManagedObjectContext.mr_default())
+            }
+
+            beforeEach {
+                TestHelpers.clearAndSetUpStack()
+                ImageCache.default.clearMemoryCache()
+                ImageCache.default.clearDiskCache()
+                MageCoreDataFixtures.addUser(userId: "userabc")
+            }
+
+            afterEach {
+                ImageCache.default.clearMemoryCache()
+                ImageCache.default.clearDiskCache()
+                TestHelpers.clearAndSetUpStack()
+            }
+
+            it("should use the attachment view key for thumbnails") {
+                guard let resource = ListPrefetchCoordinator.thumbnailResource(attachmentUrl: attachmentUrl, size: 750) else {
+                    fail("expected a thumbnail resource")
+                    return
+                }
+                expect(resource.cacheKey).to(equal("\(attachmentUrl)_thumbnail"))
+                expect(resource.downloadURL.absoluteString).to(equal("\(attachmentUrl)?size=750"))
+            }
+
+            it("should skip the thumbnail when any size is cached") {
+                ImageCache.default.store(UIImage(systemName: "paperclip")!, forKey: "\(attachmentUrl)_large", toDisk: false)
+                expect(ListPrefetchCoordinator.thumbnailResource(attachmentUrl: attachmentUrl, size: 750)).to(beNil())
+            }
+
+            it("should only prefetch requested rows") {
+                guard let user = user(), let resource = ListPrefetchCoordinator.thumbnailResource(attachmentUrl: attachmentUrl, size: 750) else {
+                    fail("expected a user and a thumbnail resource")
+                    return
+                }
+                let coordinator = ListPrefetchCoordinator()
+
+                coordinator.prefetch(objectID: user.objectID, resources: [resource], allowDownloads: true)
+                expect(coordinator.isPrefetching(user.objectID)).to(beFalse())
+
+                coordinator.request(objectIDs: [user.objectID])
+                coordinator.prefetch(objectID: user.objectID, resources: [resource], allowDownloads: true)
+                expect(coordinator.isPrefetching(user.objectID)).to(beTrue())
+
+                coordinator.cancel(objectIDs: [user.objectID])
+                expect(coordinator.isRequested(user.objectID)).to(beFalse())
+                expect(coordinator.isPrefetching(user.objectID)).to(beFalse())
+            }
+
+            it("should share the download limit between the rows") {
+                for index in 0..<5 {
+                    MageCoreDataFixtures.addUser(userId: "user\(index)")
+                }
+                let users = (0..<5).compactMap { index in
+                    User.mr_findFirst(byAttribute: "remoteId", withValue: "user\(index)", in: NSManagedObjectContext.mr_default())
+                }
+                expect(users.count).to(equal(5))
+                let objectIDs = users.map { $0.objectID }
+                let coordinator = ListPrefetchCoordinator()
+                coordinator.request(objectIDs: objectIDs)
+
+                for (index, objectID) in objectIDs.enumerated() {
+                    let resources = (0..<2).compactMap { image in
+                        ListPrefetchCoordinator.thumbnailResource(attachmentUrl: "\(attachmentUrl)\(index)-\(image)", size: 750)
+                    }
+                    coordinator.prefetch(objectID: objectID, resources: resources, allowDownloads: true)
+                }
+                // one image at a time for at most maxConcurrentDownloads rows
+                expect(objectIDs.filter { coordinator.isPrefetching($0) }.count).to(equal(5))
+                expect(objectIDs.filter { coordinator.isWaiting($0) }).to(equal([objectIDs[4]]))
+
+                // a cancelled row hands its slot to the next one waiting
+                coordinator.cancel(objectIDs: [objectIDs[0]])
+                expect(coordinator.isWaiting(objectIDs[4])).to(beFalse())
+                expect(coordinator.isPrefetching(objectIDs[4])).to(beTrue())
+
+                coordinator.cancelAll()
+                expect(objectIDs.filter { coordinator.isPrefetching($0) }).to(beEmpty())
+            }
+
+            it("should download nothing when the network policy does not allow it") {
+                guard let user = user(), let resource = ListPrefetchCoordinator.thumbnailResource(attachmentUrl: attachmentUrl, size: 750) else {
+                    fail("expected a user and a thumbnail resource")
+                    return
+                }
+                let coordinator = ListPrefetchCoordinator()
+                coordinator.request(objectIDs: [user.objectID])
+
+                // not on disk, there is nothing to load
+                coordinator.prefetch(objectID: user.objectID, resources: [resource], allowDownloads: false)
+                expect(coordinator.isPrefetching(user.objectID)).to(beFalse())
+
+                waitUntil { done in
+                    ImageCache.default.store(UIImage(systemName: "paperclip")!, forKey: resource.cacheKey, toDisk: true) { _ in
+                        done()
+                    }
+                }
+                ImageCache.default.clearMemoryCache()
+
+                coordinator.prefetch(objectID: user.objectID, resources: [resource], allowDownloads: false)
+                expect(coordinator.isPrefetching(user.objectID)).to(beTrue())
+                coordinator.cancelAll()
+                expect(coordinator.isPrefetching(user.objectID)).to(beFalse())
+            }
+
+            it("should use the cache avatar url for avatars") {
+                guard let user = user() else {
+                    fail("expected a user")
+                    return
+                }
+                user.avatarUrl = "https://magetest/api/users/userabc/avatar"
+                expect(ListPrefetchCoordinator.avatarResource(user: user)?.cacheKey).to(equal(user.cacheAvatarUrl))
+                expect(ListPrefetchCoordinator.avatarResource(user: nil)).to(beNil())
+            }
+        }
+    }
+}
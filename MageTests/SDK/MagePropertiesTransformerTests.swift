@@ -0,0 +1,253 @@
+//
+//  MagePropertiesTransformerTests.swift
+//  MAGETests
+//
+//  Copyright © 2026 National Geospatial Intelligence Agency. All rights reserved.
+//
+
+import Foundation
+import Quick
+import Nimble
+import CoreData
+import SimpleFeatures
+import MagicalRecord
+import SQLite3
+
+@testable import MAGE
+
+class MagePropertiesTransformerTests: KIFSpec {
+
+    override func spec() {
+
+        let transformer = MagePropertiesTransformer()
+
+        /// What an observation with two forms holds once it has been pulled from the server
+        func observationProperties(index: Int) -> [String: Any] {
+            return [
+                "timestamp": "2026-03-\(String(format: "%02d", index % 28 + 1))T17:\(String(format: "%02d", index % 60)):41.000Z",
+                "accuracy": Double(index % 50) + 0.5,
+                "provider": index % 2 == 0 ? "gps" : "manual",
+                "delta": index % 1000,
+                "forms": [
+                    [
+                        "id": "form\(index)",
+                        "formId": 26,
+                        "type": ["Turtle", "Heron", "Fish", "Beaver", "Otter"][index % 5],
+                        "variant": "Variant \(index % 7)",
+                        "notes": "Sighting number \(index) seen near the river bank while walking the northern trail",
+                        "count": index % 12,
+                        "confirmed": index % 3 == 0,
+                        "observed": "2026-03-01T12:00:00.000Z",
+                        "habitat": ["Wetland", "Forest"],
+                        "location": SFPoint(xValue: Double(index % 360) - 180, andYValue: Double(index % 170) - 85) as Any,
+                        "reporter": NSNull()
+                    ],
+                    [
+                        "id": "form\(index)b",
+                        "formId": 27,
+                        "weather": "Overcast",
+                        "temperature": -3
+                    ]
+                ]
+            ]
+        }
+
+        func fixtureProperties() -> [[String: Any]] {
+            return (0..<10_000).map { observationProperties(index: $0) }
+        }
+
+        var storeURL: URL? {
+            return NSManagedObjectContext.mr_default().persistentStoreCoordinator?.persistentStores.first?.url
+        }
+
+        func storedProperties() -> [Data] {
+            var db: OpaquePointer?
+            var statement: OpaquePointer?
+            guard let storeURL = storeURL, sqlite3_open_v2(storeURL.path, &db, SQLITE_OPEN_READONLY, nil) == SQLITE_OK else {
+                fail("Could not open the store")
+                return []
+            }
+            defer { sqlite3_close(db) }
+            guard sqlite3_prepare_v2(db, "SELECT ZPROPERTIES FROM ZOBSERVATION", -1, &statement, nil) == SQLITE_OK else {
+                fail("Could not read the observations")
+                return []
+            }
+            defer { sqlite3_finalize(statement) }
+            var stored: [Data] = []
+            while sqlite3_step(statement) == SQLITE_ROW {
+                if let bytes = sqlite3_column_blob(statement, 0) {
+                    stored.append(Data(bytes: bytes, count: Int(sqlite3_column_bytes(statement, 0))))
+                }
+            }
+            return stored
+        }
+
+        func storeLegacyProperties(_ data: Data, remoteId: String) {
+            var db: OpaquePointer?
+            var statement: OpaquePointer?
+            guard let storeURL = storeURL, sqlite3_open(storeURL.path, &db) == SQLITE_OK else {
+                fail("Could not open the store")
+                return
+            }
+            defer { sqlite3_close(db) }
+            expect(sqlite3_prepare_v2(db, "UPDATE ZOBSERVATION SET ZPROPERTIES = ? WHERE ZREMOTEID = ?", -1, &statement, nil)).to(equal(SQLITE_OK))
+            // SQLite copies the values
+            let transient = unsafeBitCast(-1, to: sqlite3_destructor_type.self)
+            _ = data.withUnsafeBytes { bytes in
+                sqlite3_bind_blob(statement, 1, bytes.baseAddress, Int32(data.count), transient)
+            }
+            sqlite3_bind_text(statement, 2, remoteId, -1, transient)
+            expect(sqlite3_step(statement)).to(equal(SQLITE_DONE))
+            sqlite3_finalize(statement)
+        }
+
+        describe("MagePropertiesTransformerTests") {
+
+            beforeEach {
+                TestHelpers.clearAndSetUpStack()
+                UserDefaults.standard.removeObject(forKey: PropertiesStorageMigration.completedKey)
+            }
+
+            afterEach {
+                UserDefaults.standard.removeObject(forKey: PropertiesStorageMigration.completedKey)
+                TestHelpers.clearAndSetUpStack()
+            }
+
+            it("should round trip properties") {
+                let properties = observationProperties(index: 3)
+                guard let data = transformer.transformedValue(properties) as? Data else {
+                    fail("not transformed")
+                    return
+                }
+                expect(MagePropertiesCodec.isEncoded(data)).to(beTrue())
+
+                guard let decoded = transformer.reverseTransformedValue(data) as? [String: Any], let form = (decoded["forms"] as? [[String: Any]])?.first else {
+                    fail("not decoded")
+                    return
+                }
+                expect(decoded as NSDictionary).to(equal(properties as NSDictionary))
+                // booleans stay booleans and whole numbers stay whole
+                expect(form["confirmed"] as? Bool == true).to(beTrue())
+                expect(CFGetTypeID(form["confirmed"] as CFTypeRef)).to(equal(CFBooleanGetTypeID()))
+                expect(CFNumberIsFloatType(form["count"] as! NSNumber)).to(beFalse())
+                expect(CFNumberIsFloatType(decoded["accuracy"] as! NSNumber)).to(beTrue())
+                expect(form["reporter"] is NSNull).to(beTrue())
+                expect(form["location"] as? SFPoint).to(equal(SFPoint(xValue: -177, andYValue: -82)))
+                expect((decoded["forms"] as? [[String: Any]])?.last?["temperature"] as? Int).to(equal(-3))
+            }
+
+            it("should read legacy keyed archives") {
+                let properties = observationProperties(index: 3)
+                let legacy = try! NSKeyedArchiver.archivedData(withRootObject: properties, requiringSecureCoding: true)
+                expect(MagePropertiesCodec.isEncoded(legacy)).to(beFalse())
+                expect(transformer.reverseTransformedValue(legacy) as? NSDictionary).to(equal(properties as NSDictionary))
+            }
+
+            it("should decode only the requested keys") {
+                guard let data = MagePropertiesCodec.encode(observationProperties(index: 3)), let decoded = MagePropertiesCodec.decode(data, keys: ["timestamp", "provider"]) else {
+                    fail("not decoded")
+                    return
+                }
+                expect(Set(decoded.keys)).to(equal(["timestamp", "provider"]))
+                expect(decoded["provider"] as? String).to(equal("manual"))
+            }
+
+            it("should archive values the codec cannot write") {
+                let properties: [String: Any] = ["url": URL(string: "https://magetest")! as Any]
+                guard let data = transformer.transformedValue(properties) as? Data else {
+                    fail("not transformed")
+                    return
+                }
+                expect(MagePropertiesCodec.isEncoded(data)).to(beFalse())
+                expect(transformer.reverseTransformedValue(data) as? NSDictionary).to(equal(properties as NSDictionary))
+            }
+
+            it("should not decode truncated data") {
+                // five keys promised and none written
+                expect(MagePropertiesCodec.decode(Data(MagePropertiesCodec.magic + [0x05]))).to(beNil())
+            }
+
+            it("should rewrite only the legacy rows when migrating") {
+                let properties = observationProperties(index: 3)
+                MagicalRecord.save(blockAndWait: { localContext in
+                    for remoteId in ["legacy", "encoded"] {
+                        let observation = Observation.mr_createEntity(in: localContext)
+                        observation?.remoteId = remoteId
+                        observation?.eventId = 1
+                        observation?.timestamp = Date()
+                        observation?.properties = properties
+                    }
+                })
+                PersistentHistoryChangeProcessor.shared.processPendingChanges()
+                storeLegacyProperties(try! NSKeyedArchiver.archivedData(withRootObject: properties, requiringSecureCoding: true), remoteId: "legacy")
+                expect(storedProperties().filter { MagePropertiesCodec.isEncoded($0) }.count).to(equal(1))
+                NSManagedObjectContext.mr_default().reset()
+
+                var updated: [EntityChangeSet] = []
+                let subscription = PersistentHistoryChangeProcessor.shared.subscribe(entityNames: ["Observation"], keys: nil, queue: .main) { changeSets in
+                    updated.append(contentsOf: changeSets)
+                }
+                expect(PropertiesStorageMigration.migrate(entityName: "Observation")).to(equal(1))
+                // the entity is marked complete and not scanned again
+                expect(PropertiesStorageMigration.migrate(entityName: "Observation")).to(equal(0))
+                PropertiesStorageMigration.migrateIfNeeded()
+                expect(PropertiesStorageMigration.isNeeded).to(beFalse())
+
+                // the rewrite did not change anything subscribers care about
+                PersistentHistoryChangeProcessor.shared.processPendingChanges()
+                waitUntil { done in
+                    DispatchQueue.main.async {
+                        done()
+                    }
+                }
+                subscription.cancel()
+                expect(updated.isEmpty).to(beTrue())
+
+                expect(storedProperties().filter { MagePropertiesCodec.isEncoded($0) }.count).to(equal(2))
+                let observation = Observation.mr_findFirst(byAttribute: "remoteId", withValue: "legacy", in: NSManagedObjectContext.mr_default())
+                expect(observation?.properties as NSDictionary?).to(equal(properties as NSDictionary))
+            }
+
+            it("should store 10k observation properties in fewer bytes than keyed archives") {
+                let fixture = fixtureProperties()
+                let keyedArchiveBytes = fixture.reduce(0) { $0 + ((try? NSKeyedArchiver.archivedData(withRootObject: $1, requiringSecureCoding: true))?.count ?? 0) }
+                let codecBytes = fixture.reduce(0) { $0 + (MagePropertiesCodec.encode($1)?.count ?? 0) }
+                NSLog("BENCHMARK properties storage keyed archive: \(keyedArchiveBytes) bytes properties codec: \(codecBytes) bytes")
+                expect(codecBytes).to(beLessThan(keyedArchiveBytes))
+            }
+
+            it("should measure decoding keyed archives") {
+                let encoded = fixtureProperties().compactMap { try? NSKeyedArchiver.archivedData(withRootObject: $0, requiringSecureCoding: true) }
+                let options = XCTMeasureOptions()
+                options.iterationCount = 3
+                QuickSpec.current.measure(options: options) {
+                    for data in encoded {
+                        _ = transformer.reverseTransformedValue(data)
+                    }
+                }
+            }
+
+            it("should measure decoding the properties codec") {
+                let encoded = fixtureProperties().compactMap { MagePropertiesCodec.encode($0) }
+                let options = XCTMeasureOptions()
+                options.iterationCount = 3
+                QuickSpec.current.measure(options: options) {
+                    for data in encoded {
+                        _ = transformer.reverseTransformedValue(data)
+                    }
+                }
+            }
+
+            it("should measure decoding only the timestamp with the properties codec") {
+                let encoded = fixtureProperties().compactMap { MagePropertiesCodec.encode($0) }
+                let options = XCTMeasureOptions()
+                options.iterationCount = 3
+                QuickSpec.current.measure(options: options) {
+                    for data in encoded {
+                        _ = MagePropertiesCodec.decode(data, keys: ["timestamp"])
+                    }
+                }
+            }
+        }
+    }
+}
@@ -0,0 +1,84 @@
+//
+//  ObservationIconResolverTests.swift
+//  MAGETests
+//
+//  Copyright © 2026 National Geospatial Intelligence Agency. All rights reserved.
+//
+
+import Foundation
+import Quick
+import Nimble
+
+@testable import MAGE
+
+class ObservationIconResolverTests: KIFSpec {
+
+    override func spec() {
+
+        @discardableResult
+        func createIcon(_ relativePath: String) -> String {
+            let iconPath = "\(ObservationIconResolver.iconFolder(eventId: 1))/\(relativePath)"
+            try? FileManager.default.createDirectory(at: URL(fileURLWithPath: iconPath).deletingLastPathComponent(), withIntermediateDirectories: true, attributes: nil)
+            FileManager.default.createFile(atPath: iconPath, contents: Data([0]), attributes: nil)
+            return iconPath
+        }
+
+        describe("ObservationIconResolverTests") {
+
+            beforeEach {
+                TestHelpers.clearDocuments()
+            }
+
+            afterEach {
+                TestHelpers.clearDocuments()
+            }
+
+            it("should resolve the most specific icon") {
+                let rootIcon = createIcon("icon.png")
+                let formIcon = createIcon("26/icon.png")
+                let primaryIcon = createIcon("26/Hi/icon.png")
+                let secondaryIcon = createIcon("26/Hi/turtle/icon.png")
+                createIcon("26/Hi/turtle/notanicon.png")
+
+                let resolver = ObservationIconResolver()
+                expect(resolver.iconPath(eventId: 1, iconProperties: ["26", "Hi", "turtle"])).to(equal(secondaryIcon))
+                expect(resolver.iconPath(eventId: 1, iconProperties: ["26", "Hi", "snake"])).to(equal(primaryIcon))
+                expect(resolver.iconPath(eventId: 1, iconProperties: ["26", "Bye", "turtle"])).to(equal(formIcon))
+                expect(resolver.iconPath(eventId: 1, iconProperties: ["27"])).to(equal(rootIcon))
+                expect(resolver.iconPath(eventId: 1, iconProperties: [])).to(equal(rootIcon))
+                expect(resolver.iconPath(eventId: 2, iconProperties: ["26"])).to(beNil())
+            }
+
+            it("should fall back past folders without an icon") {
+                let formIcon = createIcon("26/icon.png")
+                try? FileManager.default.createDirectory(atPath: "\(ObservationIconResolver.iconFolder(eventId: 1))/26/Hi", withIntermediateDirectories: true, attributes: nil)
+
+                let resolver = ObservationIconResolver()
+                expect(resolver.iconPath(eventId: 1, iconProperties: ["26", "Hi"])).to(equal(formIcon))
+            }
+
+            it("should treat values with slashes as nested folders") {
+                let icon = createIcon("26/a/b/icon.png")
+
+                let resolver = ObservationIconResolver()
+                expect(resolver.iconPath(eventId: 1, iconProperties: ["26", "a/b"])).to(equal(icon))
+            }
+
+            it("should only update the index when invalidated") {
+                let formIcon = createIcon("26/icon.png")
+                let resolver = ObservationIconResolver()
+                expect(resolver.iconPath(eventId: 1, iconProperties: ["26", "Hi"])).to(equal(formIcon))
+
+                let primaryIcon = createIcon("26/Hi/icon.png")
+                expect(resolver.iconPath(eventId: 1, iconProperties: ["26", "Hi"])).to(equal(formIcon))
+
+                resolver.invalidate(eventId: 1)
+                expect(resolver.iconPath(eventId: 1, iconProperties: ["26", "Hi"])).to(equal(primaryIcon))
+
+                try? FileManager.default.removeItem(atPath: primaryIcon)
+                resolver.rebuild(eventId: 1)
+                expect(resolver.iconPath(eventId: 1, iconProperties: ["26", "Hi"])).to(equal(formIcon))
+            }
+        }
+    }
+}
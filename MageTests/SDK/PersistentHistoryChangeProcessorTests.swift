@@ -0,0 +1,201 @@
+//
+//  PersistentHistoryChangeProcessorTests.swift
+//  MAGETests
+//
+//  Copyright © 2026 National Geospatial Intelligence Agency. All rights reserved.
+//
+
+import Foundation
+import Quick
+import Nimble
+import CoreData
+import MagicalRecord
+
+@testable import MAGE
+
+class PersistentHistoryChangeProcessorTests: KIFSpec {
+
+    override func spec() {
+
+        func createObservations(count: Int, prefix: String = "observation") {
+            MagicalRecord.save(blockAndWait: { localContext in
+                for index in 0..<count {
+                    let observation = Observation.mr_createEntity(in: localContext)
+                    observation?.remoteId = "\(prefix)\(index)"
+                    observation?.eventId = 1
+                    observation?.timestamp = Date()
+                    observation?.dirty = false
+                }
+            })
+        }
+
+        // process the history and let the handlers on the main queue run
+        func processAndWait() {
+            PersistentHistoryChangeProcessor.shared.processPendingChanges()
+            waitUntil { done in
+                DispatchQueue.main.async {
+                    done()
+                }
+            }
+        }
+
+        func currentToken() -> NSPersistentHistoryToken? {
+            return NSManagedObjectContext.mr_default().persistentStoreCoordinator?.currentPersistentHistoryToken(fromStores: nil)
+        }
+
+        describe("PersistentHistoryChangeProcessorTests") {
+
+            var subscriptions: [PersistentHistorySubscription] = []
+
+            func subscribe(entityNames: [String], keys: [String]? = nil, handler: @escaping ([EntityChangeSet]) -> Void) {
+                subscriptions.append(PersistentHistoryChangeProcessor.shared.subscribe(entityNames: entityNames, keys: keys, queue: .main, handler: handler))
+            }
+
+            beforeEach {
+                TestHelpers.clearAndSetUpStack()
+                // deliver the changes from clearing the stack before anything subscribes
+                PersistentHistoryChangeProcessor.shared.processPendingChanges()
+            }
+
+            afterEach {
+                for subscription in subscriptions {
+                    subscription.cancel()
+                }
+                subscriptions.removeAll()
+                TestHelpers.clearAndSetUpStack()
+            }
+
+            it("should deliver the changes once per pass") {
+                var deliveries: [[EntityChangeSet]] = []
+                subscribe(entityNames: ["Observation"]) { changeSets in
+                    deliveries.append(changeSets)
+                }
+
+                // a sync chunk is one delivery however many observations it saves
+                createObservations(count: 250)
+                processAndWait()
+
+                expect(deliveries.count).to(equal(1))
+                expect(deliveries.first?.first?.entityName).to(equal("Observation"))
+                expect(deliveries.first?.first?.inserted.count).to(equal(250))
+                expect(deliveries.first?.first?.updated.count).to(equal(0))
+            }
+
+            it("should filter updates by key") {
+                createObservations(count: 2)
+                PersistentHistoryChangeProcessor.shared.processPendingChanges()
+
+                var errorChanges: [EntityChangeSet] = []
+                var allChanges: [EntityChangeSet] = []
+                subscribe(entityNames: ["Observation"], keys: ["error"]) { changeSets in
+                    errorChanges.append(contentsOf: changeSets)
+                }
+                subscribe(entityNames: ["Observation"]) { changeSets in
+                    allChanges.append(contentsOf: changeSets)
+                }
+
+                MagicalRecord.save(blockAndWait: { localContext in
+                    let observations = Observation.mr_findAllSorted(by: "remoteId", ascending: true, in: localContext) as? [Observation] ?? []
+                    observations[0].dirty = true
+                    observations[1].error = ["errorDescription": "failed"]
+                })
+                processAndWait()
+
+                guard let erroredID = Observation.mr_findFirst(byAttribute: "remoteId", withValue: "observation1", in: NSManagedObjectContext.mr_default())?.objectID else {
+                    fail("No observation")
+                    return
+                }
+                expect(allChanges.first?.updated.count).to(equal(2))
+                expect(errorChanges.count).to(equal(1))
+                expect(errorChanges.first?.updated).to(equal([erroredID]))
+                expect(errorChanges.first?.changedKeys[erroredID]?.contains("error")).to(equal(true))
+            }
+
+            it("should deliver subentities to their parent entity") {
+                var changes: [EntityChangeSet] = []
+                subscribe(entityNames: ["Layer"]) { changeSets in
+                    changes.append(contentsOf: changeSets)
+                }
+
+                MagicalRecord.save(blockAndWait: { localContext in
+                    let layer = StaticLayer.mr_createEntity(in: localContext)
+                    layer?.remoteId = 1
+                    layer?.eventId = 1
+                })
+                processAndWait()
+
+                expect(changes.count).to(equal(1))
+                expect(changes.first?.entityName).to(equal("StaticLayer"))
+                expect(changes.first?.inserted.count).to(equal(1))
+            }
+
+            it("should narrow the changes off of the main context") {
+                createObservations(count: 10)
+                MagicalRecord.save(blockAndWait: { localContext in
+                    Observation.mr_findFirst(byAttribute: "remoteId", withValue: "observation3", in: localContext)?.dirty = true
+                })
+                let context = NSManagedObjectContext.mr_default()
+                let all = Set((Observation.mr_findAll(in: context) as? [Observation] ?? []).map { $0.objectID })
+                let dirty = PersistentHistoryChangeProcessor.shared.objectIDs(entityName: "Observation", matching: NSPredicate(format: "dirty == true"), among: all)
+                expect(dirty).to(equal([Observation.mr_findFirst(byAttribute: "remoteId", withValue: "observation3", in: context)?.objectID].compactMap { $0 }))
+                expect(PersistentHistoryChangeProcessor.shared.count(entityName: "Observation", matching: NSPredicate(format: "dirty == false"))).to(equal(9))
+            }
+
+            it("should keep the history a subscriber has not acknowledged") {
+                let token = currentToken()
+                expect(token).toNot(beNil())
+
+                // a subscriber whose handler has not run yet
+                let busyQueue = DispatchQueue(label: "persistentHistoryChangeProcessorTests")
+                busyQueue.suspend()
+                subscriptions.append(PersistentHistoryChangeProcessor.shared.subscribe(entityNames: ["Observation"], keys: nil, queue: busyQueue) { _ in })
+
+                createObservations(count: 10)
+                processAndWait()
+                createObservations(count: 5, prefix: "later")
+                processAndWait()
+
+                var replayed: [EntityChangeSet] = []
+                var replayedToken: NSPersistentHistoryToken?
+                subscriptions.append(PersistentHistoryChangeProcessor.shared.subscribe(entityNames: ["Observation"], keys: nil, after: token, queue: .main, expired: {
+                    fail("The history was purged")
+                }) { changeSets, token in
+                    replayed.append(contentsOf: changeSets)
+                    replayedToken = token
+                })
+                processAndWait()
+                busyQueue.resume()
+
+                expect(replayed.map { $0.inserted.count }.reduce(0, +)).to(equal(15))
+                expect(replayedToken).to(equal(currentToken()))
+            }
+
+            it("should tell a subscriber the history after its token was purged") {
+                let token = currentToken()
+                createObservations(count: 10)
+                PersistentHistoryChangeProcessor.shared.processPendingChanges()
+                let context = NSManagedObjectContext.mr_default()
+                context.performAndWait {
+                    _ = try? context.execute(NSPersistentHistoryChangeRequest.deleteHistory(before: currentToken()))
+                }
+
+                var expired = false
+                var replayed: [EntityChangeSet] = []
+                subscriptions.append(PersistentHistoryChangeProcessor.shared.subscribe(entityNames: ["Observation"], keys: nil, after: token, queue: .main, expired: {
+                    expired = true
+                }) { changeSets, _ in
+                    replayed.append(contentsOf: changeSets)
+                })
+                processAndWait()
+
+                expect(expired).to(beTrue())
+                expect(replayed).to(beEmpty())
+
+                // new changes are still delivered
+                createObservations(count: 1, prefix: "new")
+                processAndWait()
+                expect(replayed.first?.inserted.count).to(equal(1))
+            }
+        }
+    }
+}
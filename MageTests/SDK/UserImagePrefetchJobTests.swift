@@ -0,0 +1,143 @@
+//
+//  UserImagePrefetchJobTests.swift
+//  MAGETests
+//
+//  Copyright © 2026 National Geospatial Intelligence Agency. All rights reserved.
+//
+
+import Foundation
+import Quick
+import Nimble
+import CoreData
+import Kingfisher
+import MagicalRecord
+
+@testable import MAGE
+
+class UserImagePrefetchJobTests: KIFSpec {
+
+    override func spec() {
+
+        func createUsers(count: Int) -> [User] {
+            MagicalRecord.save(blockAndWait: { localContext in
+                for index in 0..<count {
+                    let user = User.mr_createEntity(in: localContext)
+                    user?.remoteId = "user\(index)"
+                    user?.iconUrl = "https://magetest/api/users/user\(index)/icon"
+                    user?.avatarUrl = "https://magetest/api/users/user\(index)/avatar"
+                    user?.lastUpdated = Date(timeIntervalSince1970: 1_700_000_000)
+                }
+            })
+            return (User.mr_findAllSorted(by: "remoteId", ascending: true, in: NSManagedObjectContext.mr_default()) as? [User]) ?? []
+        }
+
+        describe("UserImagePrefetchJobTests") {
+
+            beforeEach {
+                TestHelpers.clearAndSetUpStack()
+                ImageCache.default.clearMemoryCache()
+                ImageCache.default.clearDiskCache()
+            }
+
+            afterEach {
+                ImageCache.default.clearMemoryCache()
+                ImageCache.default.clearDiskCache()
+                TestHelpers.clearAndSetUpStack()
+            }
+
+            it("should hold the images of the whole batch in one job") {
+                let users = createUsers(count: 500)
+                let job = UserImagePrefetchJob(users: users)
+                expect(job.icons.count).to(equal(500))
+                expect(job.avatars.count).to(equal(500))
+                expect(job.icons.first?.cacheKey).to(equal(users.first?.cacheIconUrl))
+            }
+
+            it("should skip cached and repeated urls") {
+                let users = createUsers(count: 2)
+                guard let cachedIcon = users[0].cacheIconUrl else {
+                    fail("expected an icon url")
+                    return
+                }
+                ImageCache.default.store(UIImage(systemName: "person")!, forKey: cachedIcon, toDisk: false)
+
+                let job = UserImagePrefetchJob(users: users + users)
+                expect(job.icons.map { $0.cacheKey }).to(equal([users[1].cacheIconUrl]))
+                expect(job.avatars.count).to(equal(2))
+            }
+
+            it("should complete a job with nothing to download right away") {
+                let job = UserImagePrefetchJob(users: [])
+                expect(job.isEmpty).to(beTrue())
+                var completed = false
+                job.start {
+                    completed = true
+                }
+                expect(completed).to(beTrue())
+                expect(UserImagePrefetchJob.runningCount).to(equal(0))
+            }
+
+            it("should report the byte budget once") {
+                let budget = UserImagePrefetchJob.ByteBudget(limit: 1000)
+                var exceededCount = 0
+                budget.onExceeded = {
+                    exceededCount += 1
+                }
+                budget.add(600)
+                budget.add(600)
+                budget.add(600)
+                expect(exceededCount).toEventually(equal(1))
+                // anything reported later was queued behind the first report
+                waitUntil { done in
+                    DispatchQueue.main.async {
+                        done()
+                    }
+                }
+                expect(exceededCount).to(equal(1))
+                expect(budget.receivedBytes).to(equal(1800))
+            }
+
+            it("should release a stopped job") {
+                let job = UserImagePrefetchJob(users: createUsers(count: 3))
+                var completed = false
+                job.start {
+                    completed = true
+                }
+                expect(UserImagePrefetchJob.runningCount).to(equal(1))
+                job.stop()
+                expect(completed).to(beTrue())
+                expect(UserImagePrefetchJob.runningCount).to(equal(0))
+            }
+
+            describe("access token") {
+
+                var previousToken: String?
+
+                beforeEach {
+                    previousToken = StoredPassword.retrieveStoredToken()
+                }
+
+                afterEach {
+                    if let previousToken = previousToken {
+                        StoredPassword.persistToken(toKeyChain: previousToken)
+                    } else {
+                        StoredPassword.clearToken()
+                    }
+                }
+
+                it("should drop the token when it changes") {
+                    let provider = ImageCacheProvider.shared
+                    StoredPassword.persistToken(toKeyChain: "tokenone")
+                    expect(provider.accessToken).to(equal("tokenone"))
+                    StoredPassword.persistToken(toKeyChain: "tokentwo")
+                    expect(provider.accessToken).to(equal("tokentwo"))
+                    StoredPassword.clearToken()
+                    expect(provider.accessToken).to(beNil())
+                    // the missing token is remembered until it changes
+                    StoredPassword.persistToken(toKeyChain: "tokenthree")
+                    expect(provider.accessToken).to(equal("tokenthree"))
+                }
+            }
+        }
+    }
+}
@@ -101,6 +101,8 @@ class TestHelpers {
             } catch {
                 print("Failed to remove events directory.  Moving on.")
             }
+            ObservationIconResolver.shared.invalidateAll()
+            AnnotationImageCache.shared.removeAll()
             
             do {
                 try FileManager.default.removeItem(at: geopackagesDirectory);
@@ -113,6 +115,7 @@ class TestHelpers {
     
     @discardableResult
     public static func clearAndSetUpStack() -> [String: Bool] {
+        ObservationShapeStyleParser.clearCache();
         TestHelpers.clearDocuments();
         TestHelpers.clearImageCache();
         TestHelpers.resetUserDefaults();
@@ -0,0 +1,128 @@
+//
+//  AnnotationImageCache.swift
+//  mage-ios-sdk
+//
+//  Copyright © 2026 National Geospatial-Intelligence Agency. All rights reserved.
+//
+
+import Foundation
+import UIKit
+
+/// Annotation images already scaled to the size they are drawn at for the screen scale and
+/// decoded, keyed by the source of the image, the size and the tint.  The cache is bounded by
+/// the decoded size of the images rather than how many there are, and is emptied on memory warnings.
+@objc public class AnnotationImageCache: NSObject {
+
+    @objc public static let shared = AnnotationImageCache()
+
+    static let defaultTotalCostLimit = 32 * 1024 * 1024
+
+    private let cache = NSCache<NSString, UIImage>()
+    private let warmQueue = DispatchQueue(label: "mil.nga.giat.mage.annotationImageCache.warm", qos: .utility)
+    private var memoryWarningObserver: AnyObject?
+
+    init(totalCostLimit: Int = AnnotationImageCache.defaultTotalCostLimit) {
+        super.init()
+        cache.totalCostLimit = totalCostLimit
+        memoryWarningObserver = NotificationCenter.default.addObserver(forName: UIApplication.didReceiveMemoryWarningNotification, object: nil, queue: nil) { [weak self] _ in
+            self?.removeAll()
+        }
+    }
+
+    deinit {
+        if let memoryWarningObserver = memoryWarningObserver {
+            NotificationCenter.default.removeObserver(memoryWarningObserver)
+        }
+    }
+
+    static func key(source: String, width: CGFloat, tint: UIColor? = nil) -> NSString {
+        var key = "\(source)|\(width)"
+        if let tint = tint {
+            var red: CGFloat = 0, green: CGFloat = 0, blue: CGFloat = 0, alpha: CGFloat = 0
+            tint.getRed(&red, green: &green, blue: &blue, alpha: &alpha)
+            key += "|\(red),\(green),\(blue),\(alpha)"
+        }
+        return key as NSString
+    }
+
+    /// The decoded size of the image in bytes
+    static func cost(image: UIImage) -> Int {
+        if let cgImage = image.cgImage {
+            return cgImage.bytesPerRow * cgImage.height
+        }
+        return Int(image.size.width * image.scale * image.size.height * image.scale * 4)
+    }
+
+    func image(forKey key: NSString) -> UIImage? {
+        return cache.object(forKey: key)
+    }
+
+    func setImage(_ image: UIImage, forKey key: NSString) {
+        cache.setObject(image, forKey: key, cost: AnnotationImageCache.cost(image: image))
+    }
+
+    /// The cached image for the key, otherwise the image made by prepare which is then cached
+    func image(forKey key: NSString, prepare: () -> UIImage?) -> UIImage? {
+        if let image = cache.object(forKey: key) {
+            return image
+        }
+        guard let image = prepare() else {
+            return nil
+        }
+        setImage(image, forKey: key)
+        return image
+    }
+
+    /// The image file scaled to width points wide for the screen scale
+    @objc public func image(path: String, width: CGFloat) -> UIImage? {
+        return image(forKey: AnnotationImageCache.key(source: path, width: width)) {
+            guard let image = UIImage(contentsOfFile: path) else {
+                return nil
+            }
+            return AnnotationImageCache.scale(image: image, width: width)
+        }
+    }
+
+    /// The image tinted and scaled to width points wide, the image name identifies the image in the cache
+    @objc public func image(named name: String, image: UIImage, width: CGFloat, tint: UIColor?) -> UIImage {
+        return self.image(forKey: AnnotationImageCache.key(source: name, width: width, tint: tint)) {
+            let scaled = AnnotationImageCache.scale(image: image, width: width)
+            guard let tint = tint else {
+                return scaled
+            }
+            return UIGraphicsImageRenderer(size: scaled.size, format: scaled.imageRendererFormat).image { _ in
+                scaled.withRenderingMode(.alwaysTemplate).withTintColor(tint).draw(at: .zero)
+            }
+        } ?? image
+    }
+
+    /// Drawing into a renderer both resamples the image and decodes it so it is not decoded again when it is displayed
+    static func scale(image: UIImage, width: CGFloat) -> UIImage {
+        guard image.size.width > 0 else {
+            return image
+        }
+        let size = CGSize(width: width, height: image.size.height * width / image.size.width)
+        // the preferred format is at the main screen scale
+        return UIGraphicsImageRenderer(size: size, format: UIGraphicsImageRendererFormat.preferred()).image { _ in
+            image.draw(in: CGRect(origin: .zero, size: size))
+        }
+    }
+
+    /// Prepare every observation icon of the event in the background
+    @objc public func warm(eventId: NSNumber) {
+        warmQueue.async { [weak self] in
+            let start = Date()
+            let iconPaths = ObservationIconResolver.shared.iconPaths(eventId: eventId)
+            for iconPath in iconPaths {
+                autoreleasepool {
+                    _ = self?.image(path: iconPath, width: CGFloat(ObservationImage.annotationScaleWidth))
+                }
+            }
+            NSLog("TIMING Warmed \(iconPaths.count) observation icons for event \(eventId). Elapsed: \(start.timeIntervalSinceNow) seconds")
+        }
+    }
+
+    @objc public func removeAll() {
+        cache.removeAllObjects()
+    }
+}
@@ -14,10 +14,10 @@
 NSString * const kAttachmentPushFrequencyKey = @"attachmentPushFrequency";
 NSString * const kAttachmentBackgroundSessionIdentifier = @"mil.nga.mage.background.attachment";
 
-@interface AttachmentPushService () <NSFetchedResultsControllerDelegate>
+@interface AttachmentPushService ()
 @property (nonatomic) NSTimeInterval interval;
 @property (nonatomic, strong) NSTimer* attachmentPushTimer;
-@property (nonatomic, strong) NSFetchedResultsController *fetchedResultsController;
+@property (nonatomic, strong) PersistentHistorySubscription *subscription;
 @property (nonatomic, strong) NSMutableArray *pushTasks;
 @property (nonatomic, strong) NSMutableDictionary *pushData;
 @end
@@ -56,18 +56,15 @@ NSString * const kAttachmentBackgroundSessionIdentifier = @"mil.nga.mage.backgro
 - (void) start {
     [self.requestSerializer setValue:[NSString stringWithFormat:@"Bearer %@", [StoredPassword retrieveStoredToken]] forHTTPHeaderField:@"Authorization"];
     
-    self.fetchedResultsController = [Attachment MR_fetchAllSortedBy:@"lastModified"
-                                                          ascending:NO
-                                                      withPredicate:[NSPredicate predicateWithFormat:@"observationRemoteId != nil && dirty == YES"]
-                                                            groupBy:nil
-                                                           delegate:self
-                                                          inContext:[NSManagedObjectContext MR_defaultContext]];
     __weak typeof(self) weakSelf = self;
+    self.subscription = [[PersistentHistoryChangeProcessor shared] subscribeWithEntityNames:@[@"Attachment"] keys:nil queue:dispatch_get_global_queue(QOS_CLASS_UTILITY, 0) handler:^(NSArray<EntityChangeSet *> *changeSets) {
+        [weakSelf pushChanges:changeSets];
+    }];
     [self.session getTasksWithCompletionHandler:^(NSArray *dataTasks, NSArray *uploadTasks, NSArray *downloadTasks) {
         dispatch_async(dispatch_get_main_queue(), ^{
             weakSelf.pushTasks = [NSMutableArray arrayWithArray:[uploadTasks valueForKeyPath:@"taskIdentifier"]];
             
-            [weakSelf pushAttachments:weakSelf.fetchedResultsController.fetchedObjects];
+            [weakSelf pushAttachments:[Attachment dirtyAttachmentsWithContext:[NSManagedObjectContext MR_defaultContext]]];
             [weakSelf scheduleTimer];
         });
     }];
@@ -83,7 +80,8 @@ NSString * const kAttachmentBackgroundSessionIdentifier = @"mil.nga.mage.backgro
         }
     });
     
-    self.fetchedResultsController = nil;
+    [self.subscription cancel];
+    self.subscription = nil;
     self.started = false;
 }
 
@@ -99,24 +97,32 @@ NSString * const kAttachmentBackgroundSessionIdentifier = @"mil.nga.mage.backgro
 - (void) onTimerFire {
     if (![[UserUtility singleton] isTokenExpired]) {
         NSLog(@"ATTACHMENT - push timer fired, checking if any attachments need to be pushed");
-        [Attachment MR_performFetch:self.fetchedResultsController];
-        [self pushAttachments:self.fetchedResultsController.fetchedObjects];
+        [self pushAttachments:[Attachment dirtyAttachmentsWithContext:[NSManagedObjectContext MR_defaultContext]]];
     }
 }
 
-- (void)controller:(NSFetchedResultsController *)controller didChangeObject:(id) anObject atIndexPath:(NSIndexPath *) indexPath forChangeType:(NSFetchedResultsChangeType)type newIndexPath:(NSIndexPath *) newIndexPath {
-    switch(type) {
-        case NSFetchedResultsChangeInsert:
-            NSLog(@"ATTACHMENT - attachment inserted, push em");
-            [self pushAttachments:@[anObject]];
-            break;
-        case NSFetchedResultsChangeUpdate:
-            NSLog(@"ATTACHMENT - attachment updated, push em");
-            [self pushAttachments:@[anObject]];
-            break;
-        default:
-            break;
+// called off of the main thread with the attachment changes from the store history
+- (void) pushChanges:(NSArray<EntityChangeSet *> *) changeSets {
+    NSMutableArray<NSManagedObjectID *> *attachmentIds = [NSMutableArray array];
+    for (EntityChangeSet *changeSet in changeSets) {
+        [attachmentIds addObjectsFromArray:[[PersistentHistoryChangeProcessor shared] objectIDsWithEntityName:changeSet.entityName matching:[Attachment dirtyPredicate] among:changeSet.insertedOrUpdated]];
     }
+    if (attachmentIds.count == 0) return;
+
+    __weak typeof(self) weakSelf = self;
+    dispatch_async(dispatch_get_main_queue(), ^{
+        if (!weakSelf.started) return;
+        NSLog(@"ATTACHMENT - %lu attachments changed, push em", (unsigned long)attachmentIds.count);
+        NSManagedObjectContext *context = [NSManagedObjectContext MR_defaultContext];
+        NSMutableArray *attachments = [NSMutableArray array];
+        for (NSManagedObjectID *attachmentId in attachmentIds) {
+            NSManagedObject *attachment = [context existingObjectWithID:attachmentId error:nil];
+            if (attachment) {
+                [attachments addObject:attachment];
+            }
+        }
+        [weakSelf pushAttachments:attachments];
+    });
 }
 
 - (void) pushAttachments:(NSArray *) attachments {
@@ -0,0 +1,162 @@
+//
+//  GeometryCache.swift
+//  mage-ios-sdk
+//
+//  Copyright © 2026 National Geospatial-Intelligence Agency. All rights reserved.
+//
+
+import Foundation
+import CoreData
+import CoreLocation
+import UIKit
+import SimpleFeatures
+
+/// Holds decoded geometries along with their centroid and envelope keyed by managed object id.
+/// Entries are only returned while the stored geometryData still matches the data they were
+/// decoded from, and are dropped when any context saves a change to the object.
+@objc public class GeometryCache: NSObject {
+
+    @objc public static let shared = GeometryCache()
+
+    private class Entry {
+        let data: Data
+        let geometry: SFGeometry
+        let centroid: CLLocationCoordinate2D?
+        let envelope: SFGeometryEnvelope?
+
+        init(data: Data, geometry: SFGeometry) {
+            self.data = data
+            self.geometry = geometry
+            if let centroid = SFGeometryUtils.centroid(of: geometry) {
+                self.centroid = CLLocationCoordinate2D(latitude: centroid.y.doubleValue, longitude: centroid.x.doubleValue)
+            } else {
+                self.centroid = nil
+            }
+            self.envelope = SFGeometryEnvelopeBuilder.buildEnvelope(with: geometry)
+        }
+    }
+
+    private let cache = NSCache<NSManagedObjectID, Entry>()
+    private let lock = NSLock()
+    private var _hits = 0
+    private var _misses = 0
+    private var saveObserver: AnyObject?
+    private var backgroundObserver: AnyObject?
+
+    @objc public var hits: Int {
+        lock.lock()
+        defer { lock.unlock() }
+        return _hits
+    }
+
+    @objc public var misses: Int {
+        lock.lock()
+        defer { lock.unlock() }
+        return _misses
+    }
+
+    init(countLimit: Int = 5000) {
+        super.init()
+        cache.countLimit = countLimit
+        saveObserver = NotificationCenter.default.addObserver(forName: .NSManagedObjectContextDidSave, object: nil, queue: nil) { [weak self] notification in
+            self?.invalidate(notification: notification)
+        }
+        backgroundObserver = NotificationCenter.default.addObserver(forName: UIApplication.didEnterBackgroundNotification, object: nil, queue: nil) { [weak self] _ in
+            self?.logMetrics()
+        }
+    }
+
+    deinit {
+        if let saveObserver = saveObserver {
+            NotificationCenter.default.removeObserver(saveObserver)
+        }
+        if let backgroundObserver = backgroundObserver {
+            NotificationCenter.default.removeObserver(backgroundObserver)
+        }
+    }
+
+    /// A copy of the decoded geometry, callers are free to mutate it
+    func geometry(for object: GeometryEnvelopeStoring) -> SFGeometry? {
+        return entry(for: object)?.geometry.mutableCopy() as? SFGeometry
+    }
+
+    func centroid(for object: GeometryEnvelopeStoring) -> CLLocationCoordinate2D? {
+        return entry(for: object)?.centroid
+    }
+
+    func envelope(for object: GeometryEnvelopeStoring) -> SFGeometryEnvelope? {
+        return entry(for: object)?.envelope?.mutableCopy() as? SFGeometryEnvelope
+    }
+
+    @objc public func removeAll() {
+        cache.removeAllObjects()
+        lock.lock()
+        _hits = 0
+        _misses = 0
+        lock.unlock()
+    }
+
+    @objc public func logMetrics() {
+        lock.lock()
+        let hits = _hits
+        let misses = _misses
+        lock.unlock()
+        let total = hits + misses
+        let hitRate = total == 0 ? 0 : Double(hits) / Double(total) * 100.0
+        NSLog("METRICS Geometry cache hits: \(hits) misses: \(misses) hit rate: \(String(format: "%.1f", hitRate))%")
+    }
+
+    private func entry(for object: GeometryEnvelopeStoring) -> Entry? {
+        guard let data = object.geometryData else {
+            return nil
+        }
+        let objectID = object.objectID
+        // temporary ids change when the object is saved, decode without caching
+        if objectID.isTemporaryID {
+            return decode(data: data)
+        }
+
+        if let entry = cache.object(forKey: objectID), entry.data == data {
+            recordHit()
+            return entry
+        }
+
+        recordMiss()
+        guard let entry = decode(data: data) else {
+            cache.removeObject(forKey: objectID)
+            return nil
+        }
+        cache.setObject(entry, forKey: objectID)
+        return entry
+    }
+
+    private func decode(data: Data) -> Entry? {
+        guard let geometry = GeometryDataTransformer.decode(data) else {
+            return nil
+        }
+        return Entry(data: data, geometry: geometry)
+    }
+
+    private func recordHit() {
+        lock.lock()
+        _hits += 1
+        lock.unlock()
+    }
+
+    private func recordMiss() {
+        lock.lock()
+        _misses += 1
+        lock.unlock()
+    }
+
+    private func invalidate(notification: Notification) {
+        for key in [NSUpdatedObjectsKey, NSDeletedObjectsKey] {
+            guard let objects = notification.userInfo?[key] as? Set<NSManagedObject> else {
+                continue
+            }
+            for object in objects where object is GeometryEnvelopeStoring {
+                cache.removeObject(forKey: object.objectID)
+            }
+        }
+    }
+}
@@ -0,0 +1,103 @@
+//
+//  GeometryDataTransformer.swift
+//  mage-ios-sdk
+//
+//  Copyright © 2026 National Geospatial-Intelligence Agency. All rights reserved.
+//
+
+import Foundation
+import CoreData
+import SimpleFeatures
+import SimpleFeaturesWKB
+import MagicalRecord
+
+/// Encodes and decodes the geometries stored in the geometryData attributes.  The attributes
+/// are plain binary attributes read and written by the geometry accessors of each entity.
+/// Geometries are written as well known binary.  Data written by older versions as keyed
+/// archives of SFGeometry is still read so stores can be migrated in the background.
+enum GeometryDataTransformer {
+
+    // keyed archives are binary plists and always begin with bplist
+    private static let keyedArchivePrefix = Data("bplist".utf8)
+
+    static func encode(_ geometry: SFGeometry) -> Data? {
+        return SFWBGeometryWriter.write(geometry)
+    }
+
+    static func decode(_ data: Data) -> SFGeometry? {
+        if isKeyedArchive(data) {
+            return SFGeometryUtils.decodeGeometry(data)
+        }
+        return SFWBGeometryReader.readGeometry(with: data)
+    }
+
+    static func isKeyedArchive(_ data: Data) -> Bool {
+        return data.starts(with: keyedArchivePrefix)
+    }
+}
+
+/// Rewrites geometryData stored as keyed archives into well known binary, one entity and one batch at a time
+@objc public class GeometryStorageMigration: NSObject {
+    static let batchSize = 500
+    static let completedKey = "geometryStorageMigrationCompleted"
+
+    static let geometryAttributes = [
+        ("Observation", "geometryData"),
+        ("Location", "geometryData"),
+        ("GPSLocation", "geometryData"),
+        ("FeedItem", "geometry")
+    ]
+
+    /// Saves in batches and blocks until done, call this off of the main thread
+    @objc public static func migrateIfNeeded() {
+        let start = Date()
+        var count = 0
+        for (entityName, attribute) in geometryAttributes {
+            count += migrate(entityName: entityName, attribute: attribute)
+        }
+        if count > 0 {
+            NSLog("TIMING Migrated \(count) geometries to well known binary. Elapsed: \(start.timeIntervalSinceNow) seconds")
+        }
+    }
+
+    @discardableResult
+    static func migrate(entityName: String, attribute: String = "geometryData") -> Int {
+        var completed = UserDefaults.standard.stringArray(forKey: completedKey) ?? []
+        if completed.contains(entityName) {
+            return 0
+        }
+        var migrated = 0
+        var offset = 0
+        var batchCount = 0
+        repeat {
+            batchCount = 0
+            autoreleasepool {
+                MagicalRecord.save(blockAndWait: { localContext in
+                    let fetchRequest = NSFetchRequest<NSManagedObject>(entityName: entityName)
+                    fetchRequest.predicate = NSPredicate(format: "%K != nil", attribute)
+                    fetchRequest.fetchOffset = offset
+                    fetchRequest.fetchLimit = batchSize
+                    fetchRequest.propertiesToFetch = [attribute]
+                    guard let objects = try? localContext.fetch(fetchRequest) else {
+                        return
+                    }
+                    for object in objects {
+                        guard let data = object.value(forKey: attribute) as? Data,
+                              GeometryDataTransformer.isKeyedArchive(data),
+                              let geometry = SFGeometryUtils.decodeGeometry(data),
+                              let wkb = GeometryDataTransformer.encode(geometry) else {
+                            continue
+                        }
+                        object.setValue(wkb, forKey: attribute)
+                        migrated += 1
+                    }
+                    batchCount = objects.count
+                })
+            }
+            offset += batchCount
+        } while batchCount == batchSize
+        completed.append(entityName)
+        UserDefaults.standard.set(completed, forKey: completedKey)
+        return migrated
+    }
+}
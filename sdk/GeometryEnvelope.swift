@@ -0,0 +1,188 @@
+//
+//  GeometryEnvelope.swift
+//  mage-ios-sdk
+//
+//  Copyright © 2026 National Geospatial-Intelligence Agency. All rights reserved.
+//
+
+import Foundation
+import CoreData
+import MapKit
+import SimpleFeatures
+import MagicalRecord
+
+/// Managed objects which store their geometry in geometryData and keep a denormalized
+/// bounding box of that geometry so that spatial filtering can be done in the store
+protocol GeometryEnvelopeStoring: NSManagedObject {
+    var geometryData: Data? { get set }
+    var minLatitude: NSNumber? { get set }
+    var maxLatitude: NSNumber? { get set }
+    var minLongitude: NSNumber? { get set }
+    var maxLongitude: NSNumber? { get set }
+}
+
+/// The R-tree fetch index over the four envelope columns, every entity storing an envelope declares it
+let geometryEnvelopeIndexName = "byEnvelopeIndex"
+
+extension GeometryEnvelopeStoring {
+
+    func updateEnvelope(geometry: SFGeometry?) {
+        guard let geometry = geometry else {
+            minLatitude = nil
+            maxLatitude = nil
+            minLongitude = nil
+            maxLongitude = nil
+            return
+        }
+        guard let envelope = SFGeometryEnvelopeBuilder.buildEnvelope(with: geometry) else {
+            setEmptyEnvelope()
+            return
+        }
+        minLatitude = NSNumber(value: envelope.minY.doubleValue)
+        maxLatitude = NSNumber(value: envelope.maxY.doubleValue)
+        minLongitude = NSNumber(value: envelope.minX.doubleValue)
+        maxLongitude = NSNumber(value: envelope.maxX.doubleValue)
+    }
+
+    /// For geometries without an envelope, an inverted box outside of the world so the row is neither
+    /// matched by a bounding box fetch nor picked up again by the backfill
+    func setEmptyEnvelope() {
+        minLatitude = 91
+        maxLatitude = -91
+        minLongitude = 181
+        maxLongitude = -181
+    }
+
+    /// Predicate matching objects whose envelope intersects the map rect, handles map rects which cross the antimeridian
+    /// in either direction.  The ranges are asked of the R-tree index, the plain comparisons leave out rows without an envelope.
+    static func envelopePredicate(intersecting mapRect: MKMapRect) -> NSPredicate {
+        let world = MKMapRect.world
+        let north = MKMapPoint(x: mapRect.minX, y: mapRect.minY).coordinate.latitude
+        let south = MKMapPoint(x: mapRect.minX, y: mapRect.maxY).coordinate.latitude
+        var predicates = [
+            indexedRange("minLatitude", from: -90, to: north),
+            indexedRange("maxLatitude", from: south, to: 90),
+            NSPredicate(format: "minLatitude <= %f AND maxLatitude >= %f", north, south)
+        ]
+
+        if mapRect.width >= world.width {
+            return NSCompoundPredicate(andPredicateWithSubpredicates: predicates)
+        }
+
+        // a rect which wraps to the west is the same rect one world to the east
+        var rect = mapRect
+        if rect.minX < world.minX {
+            rect.origin.x += world.width
+        }
+        let west = MKMapPoint(x: rect.minX, y: rect.minY).coordinate.longitude
+        if rect.maxX > world.maxX {
+            let east = MKMapPoint(x: rect.maxX - world.width, y: rect.minY).coordinate.longitude
+            predicates.append(NSCompoundPredicate(orPredicateWithSubpredicates: [
+                NSCompoundPredicate(andPredicateWithSubpredicates: [
+                    indexedRange("maxLongitude", from: west, to: 180),
+                    NSPredicate(format: "maxLongitude >= %f", west)
+                ]),
+                NSCompoundPredicate(andPredicateWithSubpredicates: [
+                    indexedRange("minLongitude", from: -180, to: east),
+                    NSPredicate(format: "minLongitude <= %f", east)
+                ])
+            ]))
+            return NSCompoundPredicate(andPredicateWithSubpredicates: predicates)
+        }
+
+        let east = MKMapPoint(x: rect.maxX, y: rect.minY).coordinate.longitude
+        predicates.append(indexedRange("minLongitude", from: -180, to: east))
+        predicates.append(indexedRange("maxLongitude", from: west, to: 180))
+        predicates.append(NSPredicate(format: "minLongitude <= %f AND maxLongitude >= %f", east, west))
+        return NSCompoundPredicate(andPredicateWithSubpredicates: predicates)
+    }
+
+    private static func indexedRange(_ key: String, from: Double, to: Double) -> NSPredicate {
+        return NSPredicate(format: "indexed:by:(%K, %@) between { %f, %f }", key, geometryEnvelopeIndexName, from, to)
+    }
+
+    /// Fetch the objects whose envelope intersects the map rect, further filtered by the optional predicate
+    static func fetch(intersecting mapRect: MKMapRect, predicate: NSPredicate? = nil, sortDescriptors: [NSSortDescriptor]? = nil, context: NSManagedObjectContext) -> [Self] {
+        guard let entityName = entity().name else {
+            return []
+        }
+        let fetchRequest = NSFetchRequest<Self>(entityName: entityName)
+        var predicates = [envelopePredicate(intersecting: mapRect)]
+        if let predicate = predicate {
+            predicates.append(predicate)
+        }
+        fetchRequest.predicate = NSCompoundPredicate(andPredicateWithSubpredicates: predicates)
+        fetchRequest.sortDescriptors = sortDescriptors
+        return (try? context.fetch(fetchRequest)) ?? []
+    }
+}
+
+extension Observation: GeometryEnvelopeStoring {
+
+    /// Observations in the current event whose geometry intersects the map rect
+    @objc public static func fetchObservations(intersecting mapRect: MKMapRect, context: NSManagedObjectContext) -> [Observation] {
+        guard let currentEventId = Server.currentEventId() else {
+            return []
+        }
+        return fetch(intersecting: mapRect, predicate: NSPredicate(format: "eventId == %@", currentEventId), sortDescriptors: [NSSortDescriptor(key: ObservationKey.timestamp.key, ascending: false)], context: context)
+    }
+}
+
+extension Location: GeometryEnvelopeStoring {
+
+    /// Locations in the current event whose geometry intersects the map rect
+    @objc public static func fetchLocations(intersecting mapRect: MKMapRect, context: NSManagedObjectContext) -> [Location] {
+        guard let currentEventId = Server.currentEventId() else {
+            return []
+        }
+        return fetch(intersecting: mapRect, predicate: NSPredicate(format: "eventId == %@", currentEventId), sortDescriptors: [NSSortDescriptor(key: LocationKey.timestamp.key, ascending: false)], context: context)
+    }
+}
+
+extension GPSLocation: GeometryEnvelopeStoring {}
+
+/// Fills in the envelope columns of rows written before the envelope columns existed
+@objc public class GeometryEnvelopeBackfill: NSObject {
+    static let batchSize = 500
+
+    /// Saves in batches and blocks until done, call this off of the main thread
+    @objc public static func backfillIfNeeded() {
+        let start = Date()
+        let count = backfill(Observation.self) + backfill(Location.self) + backfill(GPSLocation.self)
+        if count > 0 {
+            NSLog("TIMING Backfilled \(count) geometry envelopes. Elapsed: \(start.timeIntervalSinceNow) seconds")
+        }
+    }
+
+    @discardableResult
+    static func backfill<T: GeometryEnvelopeStoring>(_ type: T.Type) -> Int {
+        guard let entityName = T.entity().name else {
+            return 0
+        }
+        var total = 0
+        var batchCount = 0
+        repeat {
+            batchCount = 0
+            MagicalRecord.save(blockAndWait: { localContext in
+                let fetchRequest = NSFetchRequest<T>(entityName: entityName)
+                fetchRequest.predicate = NSPredicate(format: "geometryData != nil AND minLatitude == nil")
+                fetchRequest.fetchLimit = batchSize
+                guard let objects = try? localContext.fetch(fetchRequest) else {
+                    return
+                }
+                for object in objects {
+                    guard let geometryData = object.geometryData, let geometry = GeometryDataTransformer.decode(geometryData) else {
+                        // give undecodable geometries an empty envelope so they are not fetched again
+                        object.setEmptyEnvelope()
+                        continue
+                    }
+                    // geometries without an envelope get the empty envelope too
+                    object.updateEnvelope(geometry: geometry)
+                }
+                batchCount = objects.count
+            })
+            total += batchCount
+        } while batchCount == batchSize
+        return total
+    }
+}
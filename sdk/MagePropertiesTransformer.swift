@@ -6,9 +6,419 @@
 //  Copyright © 2021 National Geospatial Intelligence Agency. All rights reserved.
 //
 
+import Foundation
+import CoreData
+import SimpleFeatures
+import SimpleFeaturesWKB
+import MagicalRecord
+import SQLite3
+
+/// Transforms the properties dictionaries of observations, locations, GPS locations and feed items.
+/// Properties are written with MagePropertiesCodec, anything the codec cannot write is archived as
+/// before.  Keyed archives written by older versions are still read so stores can be migrated in
+/// the background.
 @objc(MagePropertiesTransformer)
 class MagePropertiesTransformer: NSSecureUnarchiveFromDataTransformer {
     override class var allowedTopLevelClasses: [AnyClass] {
         return super.allowedTopLevelClasses + [SFGeometry.self]
     }
+
+    override func transformedValue(_ value: Any?) -> Any? {
+        if let properties = value as? [AnyHashable: Any], let data = MagePropertiesCodec.encode(properties) {
+            return data
+        }
+        return super.transformedValue(value)
+    }
+
+    override func reverseTransformedValue(_ value: Any?) -> Any? {
+        if let data = value as? Data, MagePropertiesCodec.isEncoded(data) {
+            return MagePropertiesCodec.decode(data) as NSDictionary?
+        }
+        return super.reverseTransformedValue(value)
+    }
+}
+
+/// Compact typed binary encoding of a properties dictionary.  Each value is a one byte type tag
+/// followed by its payload, integers and lengths are varints and geometries are well known binary.
+/// Every top level value is preceded by its length so one key can be decoded without decoding
+/// the rest.  Dictionary keys must be strings.
+enum MagePropertiesCodec {
+
+    static let magic: [UInt8] = Array("MPC1".utf8)
+
+    enum Tag: UInt8 {
+        case null = 0
+        case falseValue
+        case trueValue
+        case integer
+        case double
+        case string
+        case array
+        case dictionary
+        case geometry
+        case data
+        case date
+    }
+
+    struct DecodingError: Error {}
+
+    static func isEncoded(_ data: Data) -> Bool {
+        return data.starts(with: magic)
+    }
+
+    /// Nil if the dictionary holds a key or a value the codec cannot write
+    static func encode(_ properties: [AnyHashable: Any]) -> Data? {
+        var writer = Writer()
+        writer.bytes.append(contentsOf: magic)
+        writer.varint(UInt64(properties.count))
+        var valueWriter = Writer()
+        for (key, value) in properties {
+            guard let key = key.base as? String else {
+                return nil
+            }
+            valueWriter.bytes.removeAll(keepingCapacity: true)
+            guard valueWriter.value(value) else {
+                return nil
+            }
+            writer.string(key)
+            writer.varint(UInt64(valueWriter.bytes.count))
+            writer.bytes.append(contentsOf: valueWriter.bytes)
+        }
+        return Data(writer.bytes)
+    }
+
+    /// Decode the top level keys, or every key when keys is nil.  The values of other keys are skipped without being read.
+    static func decode(_ data: Data, keys: Set<String>? = nil) -> [String: Any]? {
+        return data.withUnsafeBytes { (buffer: UnsafeRawBufferPointer) -> [String: Any]? in
+            guard buffer.count >= magic.count else {
+                return nil
+            }
+            var reader = Reader(bytes: buffer, offset: magic.count)
+            do {
+                let count = try reader.count()
+                var properties: [String: Any] = Dictionary(minimumCapacity: keys?.count ?? count)
+                for _ in 0..<count {
+                    let key = try reader.string()
+                    let length = try reader.count()
+                    if let keys = keys, !keys.contains(key) {
+                        try reader.skip(length)
+                        continue
+                    }
+                    properties[key] = try reader.value()
+                }
+                return properties
+            } catch {
+                NSLog("Unable to decode properties")
+                return nil
+            }
+        }
+    }
+
+    struct Writer {
+        var bytes: [UInt8] = []
+
+        mutating func varint(_ value: UInt64) {
+            var value = value
+            while value >= 0x80 {
+                bytes.append(UInt8(value & 0x7f) | 0x80)
+                value >>= 7
+            }
+            bytes.append(UInt8(value))
+        }
+
+        mutating func string(_ string: String) {
+            var string = string
+            string.withUTF8 { utf8 in
+                varint(UInt64(utf8.count))
+                bytes.append(contentsOf: utf8)
+            }
+        }
+
+        mutating func tag(_ tag: Tag) {
+            bytes.append(tag.rawValue)
+        }
+
+        mutating func double(_ value: Double) {
+            withUnsafeBytes(of: value.bitPattern.littleEndian) { bytes.append(contentsOf: $0) }
+        }
+
+        mutating func value(_ value: Any) -> Bool {
+            switch value {
+            case is NSNull:
+                tag(.null)
+            case let string as String:
+                tag(.string)
+                self.string(string)
+            case let number as NSNumber:
+                if CFGetTypeID(number) == CFBooleanGetTypeID() {
+                    tag(number.boolValue ? .trueValue : .falseValue)
+                } else if CFNumberIsFloatType(number) {
+                    tag(.double)
+                    double(number.doubleValue)
+                } else {
+                    // zig zag so small negative numbers stay small
+                    let integer = number.int64Value
+                    tag(.integer)
+                    varint(UInt64(bitPattern: (integer << 1) ^ (integer >> 63)))
+                }
+            case let geometry as SFGeometry:
+                guard let wkb = GeometryDataTransformer.encode(geometry) else {
+                    return false
+                }
+                tag(.geometry)
+                varint(UInt64(wkb.count))
+                bytes.append(contentsOf: wkb)
+            case let date as Date:
+                tag(.date)
+                double(date.timeIntervalSince1970)
+            case let data as Data:
+                tag(.data)
+                varint(UInt64(data.count))
+                bytes.append(contentsOf: data)
+            case let array as [Any]:
+                tag(.array)
+                varint(UInt64(array.count))
+                for element in array {
+                    guard self.value(element) else {
+                        return false
+                    }
+                }
+            case let dictionary as [AnyHashable: Any]:
+                tag(.dictionary)
+                varint(UInt64(dictionary.count))
+                for (key, element) in dictionary {
+                    guard let key = key.base as? String else {
+                        return false
+                    }
+                    string(key)
+                    guard self.value(element) else {
+                        return false
+                    }
+                }
+            default:
+                return false
+            }
+            return true
+        }
+    }
+
+    struct Reader {
+        let bytes: UnsafeRawBufferPointer
+        var offset: Int
+
+        mutating func byte() throws -> UInt8 {
+            guard offset < bytes.count else {
+                throw DecodingError()
+            }
+            let byte = bytes[offset]
+            offset += 1
+            return byte
+        }
+
+        mutating func varint() throws -> UInt64 {
+            var value: UInt64 = 0
+            var shift: UInt64 = 0
+            while true {
+                let byte = try self.byte()
+                value |= UInt64(byte & 0x7f) << shift
+                if byte & 0x80 == 0 {
+                    return value
+                }
+                shift += 7
+                if shift > 63 {
+                    throw DecodingError()
+                }
+            }
+        }
+
+        mutating func count() throws -> Int {
+            let count = try varint()
+            guard count <= UInt64(bytes.count - offset) else {
+                throw DecodingError()
+            }
+            return Int(count)
+        }
+
+        mutating func skip(_ length: Int) throws {
+            guard length <= bytes.count - offset else {
+                throw DecodingError()
+            }
+            offset += length
+        }
+
+        mutating func slice(_ length: Int) throws -> UnsafeRawBufferPointer {
+            guard length <= bytes.count - offset else {
+                throw DecodingError()
+            }
+            let slice = UnsafeRawBufferPointer(rebasing: bytes[offset..<offset + length])
+            offset += length
+            return slice
+        }
+
+        mutating func string() throws -> String {
+            return String(decoding: try slice(try count()), as: UTF8.self)
+        }
+
+        mutating func double() throws -> Double {
+            var bitPattern: UInt64 = 0
+            let slice = try self.slice(8)
+            for index in 0..<8 {
+                bitPattern |= UInt64(slice[index]) << (8 * UInt64(index))
+            }
+            return Double(bitPattern: bitPattern)
+        }
+
+        mutating func value() throws -> Any {
+            guard let tag = Tag(rawValue: try byte()) else {
+                throw DecodingError()
+            }
+            switch tag {
+            case .null:
+                return NSNull()
+            case .falseValue:
+                return false
+            case .trueValue:
+                return true
+            case .integer:
+                let zigzag = try varint()
+                return NSNumber(value: Int64(bitPattern: zigzag >> 1) ^ -Int64(bitPattern: zigzag & 1))
+            case .double:
+                return NSNumber(value: try double())
+            case .string:
+                return try string()
+            case .array:
+                let count = try self.count()
+                var array: [Any] = []
+                array.reserveCapacity(count)
+                for _ in 0..<count {
+                    array.append(try value())
+                }
+                return array
+            case .dictionary:
+                let count = try self.count()
+                var dictionary: [String: Any] = Dictionary(minimumCapacity: count)
+                for _ in 0..<count {
+                    let key = try string()
+                    dictionary[key] = try value()
+                }
+                return dictionary
+            case .geometry:
+                let wkb = Data(try slice(try self.count()))
+                guard let geometry = GeometryDataTransformer.decode(wkb) else {
+                    throw DecodingError()
+                }
+                return geometry
+            case .date:
+                return Date(timeIntervalSince1970: try double())
+            case .data:
+                return Data(try slice(try self.count()))
+            }
+        }
+    }
+}
+
+/// Rewrites properties stored as keyed archives with MagePropertiesCodec, one entity and one batch at a time.
+/// Rows already written with the codec are left alone, and the rewrite is saved as the maintenance author so
+/// subscribers to the store history do not hear about values which did not change.
+@objc public class PropertiesStorageMigration: NSObject {
+    static let batchSize = 500
+    static let completedKey = "propertiesStorageMigrationCompleted"
+
+    static let entityNames = ["Observation", "Location", "GPSLocation", "FeedItem"]
+
+    @objc public static var isNeeded: Bool {
+        let completed = UserDefaults.standard.stringArray(forKey: completedKey) ?? []
+        return !Set(entityNames).isSubset(of: completed)
+    }
+
+    /// Saves in batches and blocks until done, call this off of the main thread
+    @objc public static func migrateIfNeeded() {
+        let start = Date()
+        var count = 0
+        for entityName in entityNames {
+            count += migrate(entityName: entityName)
+        }
+        if count > 0 {
+            NSLog("TIMING Migrated \(count) properties to the properties codec. Elapsed: \(start.timeIntervalSinceNow) seconds")
+        }
+    }
+
+    @discardableResult
+    static func migrate(entityName: String) -> Int {
+        var completed = UserDefaults.standard.stringArray(forKey: completedKey) ?? []
+        if completed.contains(entityName) {
+            return 0
+        }
+        guard let coordinator = NSManagedObjectContext.mr_default().persistentStoreCoordinator,
+              let objectIds = legacyObjectIds(entityName: entityName, coordinator: coordinator) else {
+            return 0
+        }
+        let context = NSManagedObjectContext(concurrencyType: .privateQueueConcurrencyType)
+        context.persistentStoreCoordinator = coordinator
+        context.transactionAuthor = PersistentHistoryChangeProcessor.maintenanceAuthor
+        var migrated = 0
+        for batchStart in stride(from: 0, to: objectIds.count, by: batchSize) {
+            autoreleasepool {
+                context.performAndWait {
+                    let fetchRequest = NSFetchRequest<NSManagedObject>(entityName: entityName)
+                    fetchRequest.predicate = NSPredicate(format: "self IN %@", Array(objectIds[batchStart..<min(batchStart + batchSize, objectIds.count)]))
+                    fetchRequest.propertiesToFetch = ["properties"]
+                    guard let objects = try? context.fetch(fetchRequest) else {
+                        return
+                    }
+                    // setting the value writes it again with the codec
+                    for object in objects {
+                        if let properties = object.value(forKey: "properties") {
+                            object.setValue(properties, forKey: "properties")
+                            migrated += 1
+                        }
+                    }
+                    do {
+                        try context.save()
+                    } catch {
+                        NSLog("Could not migrate the properties of \(entityName): \(error)")
+                    }
+                    context.reset()
+                }
+            }
+        }
+        completed.append(entityName)
+        UserDefaults.standard.set(completed, forKey: completedKey)
+        return migrated
+    }
+
+    /// The rows of the entity whose properties are not written with the codec.  The stored bytes are not visible
+    /// through a context, so they are read from the store file.  Nil if the store could not be read.
+    static func legacyObjectIds(entityName: String, coordinator: NSPersistentStoreCoordinator) -> [NSManagedObjectID]? {
+        guard let store = coordinator.persistentStores.first(where: { $0.type == NSSQLiteStoreType }), let url = store.url else {
+            return nil
+        }
+        var db: OpaquePointer?
+        guard sqlite3_open_v2(url.path, &db, SQLITE_OPEN_READONLY, nil) == SQLITE_OK else {
+            NSLog("Could not open the store to migrate the properties of \(entityName)")
+            sqlite3_close(db)
+            return nil
+        }
+        defer { sqlite3_close(db) }
+        var statement: OpaquePointer?
+        let sql = "SELECT Z_PK FROM Z\(entityName.uppercased()) WHERE ZPROPERTIES IS NOT NULL AND substr(ZPROPERTIES, 1, \(MagePropertiesCodec.magic.count)) != ?"
+        guard sqlite3_prepare_v2(db, sql, -1, &statement, nil) == SQLITE_OK else {
+            NSLog("Could not find the properties of \(entityName) to migrate: \(String(cString: sqlite3_errmsg(db)))")
+            return nil
+        }
+        defer { sqlite3_finalize(statement) }
+        let magic = Data(MagePropertiesCodec.magic)
+        _ = magic.withUnsafeBytes { bytes in
+            // SQLite copies the bytes
+            sqlite3_bind_blob(statement, 1, bytes.baseAddress, Int32(magic.count), unsafeBitCast(-1, to: sqlite3_destructor_type.self))
+        }
+        var objectIds: [NSManagedObjectID] = []
+        while sqlite3_step(statement) == SQLITE_ROW {
+            let primaryKey = sqlite3_column_int64(statement, 0)
+            if let uri = URL(string: "x-coredata://\(store.identifier ?? "")/\(entityName)/p\(primaryKey)"), let objectId = coordinator.managedObjectID(forURIRepresentation: uri) {
+                objectIds.append(objectId)
+            }
+        }
+        return objectIds
+    }
 }
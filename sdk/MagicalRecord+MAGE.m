@@ -23,6 +23,9 @@
                              [NSNumber numberWithBool:YES], NSInferMappingModelAutomaticallyOption,
                              NSFileProtectionCompleteUnlessOpen, NSPersistentStoreFileProtectionKey,
                              sqliteOptions, NSSQLitePragmasOption,
+                             // changes are handed to consumers from the store history by the PersistentHistoryChangeProcessor
+                             [NSNumber numberWithBool:YES], NSPersistentHistoryTrackingKey,
+                             [NSNumber numberWithBool:YES], NSPersistentStoreRemoteChangeNotificationPostOptionKey,
                              nil];
 
     [coordinator MR_addSqliteStoreNamed:@"Mage.sqlite" withOptions:options];
@@ -0,0 +1,142 @@
+//
+//  ObservationIconResolver.swift
+//  mage-ios-sdk
+//
+//  Copyright © 2026 National Geospatial-Intelligence Agency. All rights reserved.
+//
+
+import Foundation
+
+/// Index of the observation icons downloaded for each event.  The icon folder of an event is
+/// walked once into a tree keyed by form id, primary value and secondary value so resolving the
+/// icon for an observation does not touch the file system.  The index for an event must be
+/// invalidated whenever its icons are downloaded again.
+@objc public class ObservationIconResolver: NSObject {
+
+    @objc public static let shared = ObservationIconResolver()
+
+    private final class Node {
+        var iconFile: String?
+        var children: [String: Node] = [:]
+
+        func child(_ name: String) -> Node {
+            if let child = children[name] {
+                return child
+            }
+            let child = Node()
+            children[name] = child
+            return child
+        }
+    }
+
+    private var indexes: [NSNumber: Node] = [:]
+    private let lock = NSLock()
+
+    static func iconFolder(eventId: NSNumber) -> String {
+        return "\(ObservationImage.getDocumentsDirectory())/events/icons-\(eventId)/icons"
+    }
+
+    /// The path of the most specific icon for the icon properties, the form id followed by the primary and secondary values.
+    /// When there is no icon for all of the properties the last property is dropped until an icon is found.
+    @objc public func iconPath(eventId: NSNumber, iconProperties: [String]) -> String? {
+        let root = index(eventId: eventId)
+
+        // a value containing a slash is nested folders on disk
+        var nodes = [root]
+        for property in iconProperties {
+            var node: Node? = nodes[nodes.count - 1]
+            for component in property.split(separator: "/", omittingEmptySubsequences: false) {
+                node = node?.children[String(component)]
+            }
+            guard let found = node else {
+                break
+            }
+            nodes.append(found)
+        }
+
+        for depth in stride(from: nodes.count - 1, through: 0, by: -1) {
+            guard let iconFile = nodes[depth].iconFile else {
+                continue
+            }
+            let iconPath = iconProperties[0..<depth].joined(separator: "/")
+            if iconPath.isEmpty {
+                return "\(ObservationIconResolver.iconFolder(eventId: eventId))/\(iconFile)"
+            }
+            return "\(ObservationIconResolver.iconFolder(eventId: eventId))/\(iconPath)/\(iconFile)"
+        }
+        return nil
+    }
+
+    /// Every icon of the event
+    func iconPaths(eventId: NSNumber) -> [String] {
+        var iconPaths: [String] = []
+        var stack: [(path: String, node: Node)] = [(path: ObservationIconResolver.iconFolder(eventId: eventId), node: index(eventId: eventId))]
+        while let (path, node) = stack.popLast() {
+            if let iconFile = node.iconFile {
+                iconPaths.append("\(path)/\(iconFile)")
+            }
+            for (name, child) in node.children {
+                stack.append((path: "\(path)/\(name)", node: child))
+            }
+        }
+        return iconPaths
+    }
+
+    /// Drop the index for the event, it is rebuilt on the next lookup
+    @objc public func invalidate(eventId: NSNumber) {
+        lock.lock()
+        indexes.removeValue(forKey: eventId)
+        lock.unlock()
+    }
+
+    @objc public func invalidateAll() {
+        lock.lock()
+        indexes.removeAll()
+        lock.unlock()
+    }
+
+    /// Rebuild the index for the event now rather than on the next lookup
+    @objc public func rebuild(eventId: NSNumber) {
+        let root = ObservationIconResolver.buildIndex(eventId: eventId)
+        lock.lock()
+        indexes[eventId] = root
+        lock.unlock()
+    }
+
+    private func index(eventId: NSNumber) -> Node {
+        lock.lock()
+        defer { lock.unlock() }
+        if let root = indexes[eventId] {
+            return root
+        }
+        let root = ObservationIconResolver.buildIndex(eventId: eventId)
+        indexes[eventId] = root
+        return root
+    }
+
+    private static func buildIndex(eventId: NSNumber) -> Node {
+        let start = Date()
+        let root = Node()
+        let iconFolder = URL(fileURLWithPath: iconFolder(eventId: eventId), isDirectory: true)
+        guard let enumerator = FileManager.default.enumerator(at: iconFolder, includingPropertiesForKeys: [.isRegularFileKey], options: [.skipsHiddenFiles]) else {
+            return root
+        }
+        var iconCount = 0
+        let rootComponentCount = iconFolder.resolvingSymlinksInPath().pathComponents.count
+        for case let url as URL in enumerator {
+            let filename = url.lastPathComponent
+            guard filename.hasPrefix("icon"), (try? url.resourceValues(forKeys: [.isRegularFileKey]))?.isRegularFile == true else {
+                continue
+            }
+            let folders = url.resolvingSymlinksInPath().pathComponents.dropFirst(rootComponentCount).dropLast()
+            let node = folders.reduce(root) { $0.child($1) }
+            // more than one icon in a folder, use the same one every time
+            if node.iconFile == nil || filename < node.iconFile! {
+                node.iconFile = filename
+            }
+            iconCount += 1
+        }
+        NSLog("TIMING Indexed \(iconCount) observation icons for event \(eventId). Elapsed: \(start.timeIntervalSinceNow) seconds")
+        return root
+    }
+}
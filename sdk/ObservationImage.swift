@@ -10,12 +10,6 @@ import Foundation
     
     static let annotationScaleWidth = 35.0
     
-    private static var imageCache: NSCache<NSString, UIImage> = {
-        let cache = NSCache<NSString, UIImage>()
-        cache.countLimit = 100
-        return cache
-    }()
-    
     static func getDocumentsDirectory() -> String {
         let paths = NSSearchPathForDirectoriesInDomains(.documentDirectory, .userDomainMask, true)
         let documentsDirectory = paths[0]
@@ -41,68 +35,24 @@ import Foundation
             iconProperties.append(secondaryFieldText)
         }
         
-        let rootIconFolder = "\(getDocumentsDirectory())/events/icons-\(eventId)/icons"
-        var foundIcon = false
-        let fileManager = FileManager.default
-        
-        while (!foundIcon) {
-            let iconPath = iconProperties.joined(separator: "/")
-            var directoryToSearch = "\(rootIconFolder)/\(iconPath)"
-            if iconPath.count != 0 {
-                directoryToSearch = directoryToSearch + "/"
-            }
-            if fileManager.fileExists(atPath: directoryToSearch) {
-                do {
-                    let directoryContents = try fileManager.contentsOfDirectory(atPath: directoryToSearch)
-                    if directoryContents.count != 0 {
-                        for path in directoryContents {
-                            let url = URL(fileURLWithPath: path)
-                            let filename = url.lastPathComponent
-                            if filename.hasPrefix("icon") {
-                                return "\(directoryToSearch)\(path)"
-                            }
-                        }
-                    }
-                    
-                    if iconProperties.count == 0 {
-                        foundIcon = true;
-                    } else {
-                        iconProperties.removeLast()
-                    }
-                } catch {
-                    
-                }
-            } else {
-                if iconProperties.count == 0 {
-                    foundIcon = true;
-                } else {
-                    iconProperties.removeLast()
-                }
-            }
-        }
-        return nil
+        return ObservationIconResolver.shared.iconPath(eventId: eventId, iconProperties: iconProperties)
     }
     
     @objc public static func image(observation: Observation) -> UIImage {
-        guard let imagePath = ObservationImage.imageName(observation: observation) as NSString? else {
+        return image(imagePath: ObservationImage.imageName(observation: observation))
+    }
+    
+    /// The image for an icon path already resolved by imageName
+    @objc public static func image(imagePath: String?) -> UIImage {
+        guard let imagePath = imagePath as NSString? else {
             return UIImage(named: "defaultMarker")!
         }
         
-        if let image = ObservationImage.imageCache.object(forKey: imagePath) {
-            // image is cached
+        if let image = AnnotationImageCache.shared.image(path: imagePath as String, width: CGFloat(annotationScaleWidth)) {
             image.accessibilityIdentifier = imagePath as String
             return image
         }
         
-        if let image = UIImage(contentsOfFile: imagePath as String), let cgImage = image.cgImage {
-            let scale = image.size.width / annotationScaleWidth
-            
-            let scaledImage = UIImage(cgImage: cgImage, scale: scale, orientation: image.imageOrientation)
-            ObservationImage.imageCache.setObject(scaledImage, forKey: imagePath)
-            scaledImage.accessibilityIdentifier = imagePath as String
-            return scaledImage
-        }
-        
         let image = UIImage(named:"defaultMarker")!
         image.accessibilityIdentifier = imagePath as String
         return image
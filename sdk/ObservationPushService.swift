@@ -19,9 +19,8 @@ public class ObservationPushService: NSObject {
     let interval: TimeInterval = Double(UserDefaults.standard.observationPushFrequency)
     var delegates: [ObservationPushDelegate] = []
     var observationPushTimer: Timer?;
-    var fetchedResultsController: NSFetchedResultsController<NSFetchRequestResult>?;
-    var favoritesFetchedResultsController: NSFetchedResultsController<NSFetchRequestResult>?;
-    var importantFetchedResultsController: NSFetchedResultsController<NSFetchRequestResult>?;
+    var subscription: PersistentHistorySubscription?
+    let changeQueue = DispatchQueue(label: "mil.nga.giat.mage.observationPush", qos: .utility)
     var pushingObservations: [NSManagedObjectID : Observation] = [:]
     var pushingFavorites: [NSManagedObjectID : ObservationFavorite] = [:]
     var pushingImportant: [String : ObservationImportant] = [:]
@@ -32,28 +31,11 @@ public class ObservationPushService: NSObject {
     public func start() {
         NSLog("start pushing observations");
         self.started = true;
-        let context = NSManagedObjectContext.mr_default();
         
-        self.fetchedResultsController = Observation.mr_fetchAllSorted(by: ObservationKey.timestamp.key,
-                                                                      ascending: false,
-                                                                      with: NSPredicate(format: "\(ObservationKey.dirty.key) == true"),
-                                                                      groupBy: nil,
-                                                                      delegate: self,
-                                                                      in: context);
-        
-        self.favoritesFetchedResultsController = ObservationFavorite.mr_fetchAllSorted(by: "observation.\(ObservationKey.timestamp.key)",
-                                                                      ascending: false,
-                                                                      with: NSPredicate(format: "\(ObservationKey.dirty.key) == true"),
-                                                                      groupBy: nil,
-                                                                      delegate: self,
-                                                                      in: context);
-        
-        self.importantFetchedResultsController = ObservationImportant.mr_fetchAllSorted(by: "observation.\(ObservationKey.timestamp.key)",
-                                                                               ascending: false,
-                                                                               with: NSPredicate(format: "\(ObservationKey.dirty.key) == true"),
-                                                                               groupBy: nil,
-                                                                               delegate: self,
-                                                                               in: context);
+        // dirty objects are narrowed down off of the main thread so a sync does not wake the push service for every observation it saves
+        subscription = PersistentHistoryChangeProcessor.shared.subscribe(entityNames: ["Observation", "ObservationFavorite", "ObservationImportant"], keys: nil, queue: changeQueue) { [weak self] changeSets in
+            self?.pushChanges(changeSets: changeSets)
+        }
         onTimerFire();
         scheduleTimer();
     }
@@ -67,9 +49,8 @@ public class ObservationPushService: NSObject {
             }
         }
         
-        self.fetchedResultsController = nil;
-        self.importantFetchedResultsController = nil;
-        self.favoritesFetchedResultsController = nil;
+        subscription?.cancel();
+        subscription = nil;
         self.started = false;
     }
     
@@ -88,12 +69,30 @@ public class ObservationPushService: NSObject {
     
     @objc func onTimerFire() {
         if !UserUtility.singleton.isTokenExpired && DataConnectionUtilities.shouldPushObservations() {
-            pushObservations(observations: fetchedResultsController?.fetchedObjects as? [Observation])
-            pushFavorites(favorites: self.favoritesFetchedResultsController?.fetchedObjects as? [ObservationFavorite])
-            pushImportant(importants: self.importantFetchedResultsController?.fetchedObjects as? [ObservationImportant])
+            let context = NSManagedObjectContext.mr_default();
+            pushObservations(observations: ObservationPushService.dirtyObservations(context: context))
+            pushFavorites(favorites: ObservationPushService.dirtyFavorites(context: context))
+            pushImportant(importants: ObservationPushService.dirtyImportants(context: context))
         }
     }
 
+    static var dirtyPredicate: NSPredicate {
+        return NSPredicate(format: "\(ObservationKey.dirty.key) == true");
+    }
+
+    /// Observations with changes to push, newest first
+    static func dirtyObservations(context: NSManagedObjectContext) -> [Observation]? {
+        return Observation.mr_findAllSorted(by: ObservationKey.timestamp.key, ascending: false, with: dirtyPredicate, in: context) as? [Observation]
+    }
+
+    static func dirtyFavorites(context: NSManagedObjectContext) -> [ObservationFavorite]? {
+        return ObservationFavorite.mr_findAll(with: dirtyPredicate, in: context) as? [ObservationFavorite]
+    }
+
+    static func dirtyImportants(context: NSManagedObjectContext) -> [ObservationImportant]? {
+        return ObservationImportant.mr_findAll(with: dirtyPredicate, in: context) as? [ObservationImportant]
+    }
+
     func addDelegate(delegate: ObservationPushDelegate) {
         if !self.delegates.contains(where: { delegateInArray in
             delegate == delegateInArray
@@ -341,61 +340,45 @@ public class ObservationPushService: NSObject {
     }
 }
 
-extension ObservationPushService : NSFetchedResultsControllerDelegate {
-    public func controller(_ controller: NSFetchedResultsController<NSFetchRequestResult>, didChange anObject: Any, at indexPath: IndexPath?, for type: NSFetchedResultsChangeType, newIndexPath: IndexPath?) {
-        
-        if let observation = anObject as? Observation {
-            switch type {
-            case .insert:
-                NSLog("observations inserted, push em")
-                pushObservations(observations: [observation])
-            case .delete:
-                break
-            case .move:
-                break
-            case .update:
-                NSLog("observations updated, push em")
-                if observation.remoteId != nil {
-                    pushObservations(observations: [observation])
-                }
-            @unknown default:
+extension ObservationPushService {
+    /// Called with the changes from the store history, pushes the same objects the push service was told about when it watched the dirty objects:
+    /// new dirty observations and favorites, and changes to dirty objects the server already knows about
+    func pushChanges(changeSets: [EntityChangeSet]) {
+        let processor = PersistentHistoryChangeProcessor.shared
+        var observationIds: [NSManagedObjectID] = []
+        var favoriteIds: [NSManagedObjectID] = []
+        var importantIds: [NSManagedObjectID] = []
+        for changeSet in changeSets {
+            switch changeSet.entityName {
+            case "Observation":
+                observationIds.append(contentsOf: processor.objectIDs(entityName: changeSet.entityName, matching: NSPredicate(format: "\(ObservationKey.dirty.key) == true AND (remoteId != nil OR self IN %@)", Array(changeSet.inserted)), among: changeSet.insertedOrUpdated))
+            case "ObservationFavorite":
+                favoriteIds.append(contentsOf: processor.objectIDs(entityName: changeSet.entityName, matching: NSPredicate(format: "\(ObservationKey.dirty.key) == true AND (observation.remoteId != nil OR self IN %@)", Array(changeSet.inserted)), among: changeSet.insertedOrUpdated))
+            case "ObservationImportant":
+                importantIds.append(contentsOf: processor.objectIDs(entityName: changeSet.entityName, matching: NSPredicate(format: "\(ObservationKey.dirty.key) == true AND observation.remoteId != nil"), among: changeSet.insertedOrUpdated))
+            default:
                 break
             }
-        } else if let observationFavorite = anObject as? ObservationFavorite {
-            switch type {
-            case .insert:
-                NSLog("favorites inserted, push em")
-                pushFavorites(favorites: [observationFavorite])
-            case .delete:
-                break
-            case .move:
-                break
-            case .update:
-                NSLog("favorites updated, push em")
-                if observationFavorite.observation?.remoteId != nil {
-                    pushFavorites(favorites: [observationFavorite])
-                }
-            @unknown default:
-                break
+        }
+        if observationIds.isEmpty && favoriteIds.isEmpty && importantIds.isEmpty {
+            return
+        }
+        DispatchQueue.main.async { [weak self] in
+            guard let self = self, self.started else {
+                return
             }
-        } else if let observationImportant = anObject as? ObservationImportant {
-            switch type {
-            case .insert:
-                NSLog("important inserted, push em")
-                if observationImportant.observation?.remoteId != nil {
-                    pushImportant(importants: [observationImportant])
-                }
-            case .delete:
-                break
-            case .move:
-                break
-            case .update:
-                NSLog("important updated, push em")
-                if observationImportant.observation?.remoteId != nil {
-                    pushImportant(importants: [observationImportant])
-                }
-            @unknown default:
-                break
+            let context = NSManagedObjectContext.mr_default()
+            if !observationIds.isEmpty {
+                NSLog("observations changed, push em")
+                self.pushObservations(observations: observationIds.compactMap { try? context.existingObject(with: $0) as? Observation })
+            }
+            if !favoriteIds.isEmpty {
+                NSLog("favorites changed, push em")
+                self.pushFavorites(favorites: favoriteIds.compactMap { try? context.existingObject(with: $0) as? ObservationFavorite })
+            }
+            if !importantIds.isEmpty {
+                NSLog("important changed, push em")
+                self.pushImportant(importants: importantIds.compactMap { try? context.existingObject(with: $0) as? ObservationImportant })
             }
         }
     }
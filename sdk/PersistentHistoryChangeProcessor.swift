@@ -0,0 +1,448 @@
+//
+//  PersistentHistoryChangeProcessor.swift
+//  mage-ios-sdk
+//
+//  Copyright © 2026 National Geospatial-Intelligence Agency. All rights reserved.
+//
+
+import Foundation
+import CoreData
+
+/// The objects of one entity which changed in the transactions processed together.  An object
+/// inserted and then updated is only inserted, an object inserted and then deleted is dropped.
+@objc public class EntityChangeSet: NSObject {
+    @objc public let entity: NSEntityDescription
+    @objc public private(set) var inserted: Set<NSManagedObjectID> = []
+    @objc public private(set) var updated: Set<NSManagedObjectID> = []
+    @objc public private(set) var deleted: Set<NSManagedObjectID> = []
+    /// The keys changed on each updated object, missing when the store did not record them
+    public private(set) var changedKeys: [NSManagedObjectID: Set<String>] = [:]
+
+    @objc public var entityName: String {
+        return entity.name ?? ""
+    }
+
+    @objc public var insertedOrUpdated: Set<NSManagedObjectID> {
+        return inserted.union(updated)
+    }
+
+    @objc public var isEmpty: Bool {
+        return inserted.isEmpty && updated.isEmpty && deleted.isEmpty
+    }
+
+    init(entity: NSEntityDescription) {
+        self.entity = entity
+    }
+
+    /// Whether the entity is one of the entity names or inherits from one of them
+    func matches(entityNames: Set<String>) -> Bool {
+        var entity: NSEntityDescription? = self.entity
+        while let current = entity {
+            if let name = current.name, entityNames.contains(name) {
+                return true
+            }
+            entity = current.superentity
+        }
+        return false
+    }
+
+    func record(_ change: NSPersistentHistoryChange) {
+        let objectID = change.changedObjectID
+        switch change.changeType {
+        case .insert:
+            inserted.insert(objectID)
+        case .update:
+            if inserted.contains(objectID) {
+                return
+            }
+            updated.insert(objectID)
+            if let properties = change.updatedProperties {
+                changedKeys[objectID, default: []].formUnion(properties.map { $0.name })
+            }
+        case .delete:
+            updated.remove(objectID)
+            changedKeys.removeValue(forKey: objectID)
+            if inserted.remove(objectID) == nil {
+                deleted.insert(objectID)
+            }
+        @unknown default:
+            break
+        }
+    }
+
+    /// The changes a subscriber to the keys should hear about, updates to other keys are dropped
+    func filtered(keys: Set<String>?) -> EntityChangeSet? {
+        guard let keys = keys else {
+            return isEmpty ? nil : self
+        }
+        let filtered = EntityChangeSet(entity: entity)
+        filtered.inserted = inserted
+        filtered.deleted = deleted
+        for objectID in updated {
+            // no recorded keys, assume anything changed
+            guard let objectKeys = changedKeys[objectID] else {
+                filtered.updated.insert(objectID)
+                continue
+            }
+            if !objectKeys.isDisjoint(with: keys) {
+                filtered.updated.insert(objectID)
+                filtered.changedKeys[objectID] = objectKeys
+            }
+        }
+        return filtered.isEmpty ? nil : filtered
+    }
+}
+
+/// A transaction in the store history
+struct PersistentHistoryPosition {
+    let transactionNumber: Int64
+    let token: NSPersistentHistoryToken
+
+    init(transactionNumber: Int64, token: NSPersistentHistoryToken) {
+        self.transactionNumber = transactionNumber
+        self.token = token
+    }
+
+    init(_ transaction: NSPersistentHistoryTransaction) {
+        self.init(transactionNumber: transaction.transactionNumber, token: transaction.token)
+    }
+}
+
+/// Returned from subscribing, cancel it to stop hearing about changes
+@objc public class PersistentHistorySubscription: NSObject {
+    let entityNames: Set<String>
+    let keys: Set<String>?
+    let queue: DispatchQueue
+    let handler: ([EntityChangeSet], NSPersistentHistoryToken) -> Void
+    let expired: (() -> Void)?
+    weak var processor: PersistentHistoryChangeProcessor?
+    /// The history after this token is delivered before any new changes, only used on the process queue
+    var replayToken: NSPersistentHistoryToken?
+
+    private let lock = NSLock()
+    private var acknowledgedPosition: PersistentHistoryPosition?
+
+    init(entityNames: Set<String>, keys: Set<String>?, queue: DispatchQueue, replayToken: NSPersistentHistoryToken?, acknowledged: PersistentHistoryPosition?, expired: (() -> Void)?, handler: @escaping ([EntityChangeSet], NSPersistentHistoryToken) -> Void) {
+        self.entityNames = entityNames
+        self.keys = keys
+        self.queue = queue
+        self.replayToken = replayToken
+        self.acknowledgedPosition = acknowledged
+        self.expired = expired
+        self.handler = handler
+    }
+
+    /// The last transaction whose changes the handler has run with, history up to it is no longer needed by this subscriber
+    var acknowledged: PersistentHistoryPosition? {
+        lock.lock()
+        defer { lock.unlock() }
+        return acknowledgedPosition
+    }
+
+    func acknowledge(_ position: PersistentHistoryPosition) {
+        lock.lock()
+        defer { lock.unlock() }
+        if position.transactionNumber > acknowledgedPosition?.transactionNumber ?? Int64.min {
+            acknowledgedPosition = position
+        }
+    }
+
+    @objc public func cancel() {
+        processor?.unsubscribe(self)
+    }
+}
+
+/// Reads the persistent history of the store after every save and hands each subscriber the
+/// changes to the entities and keys it subscribed to, rather than every consumer keeping a
+/// fetched results controller on the main context just to hear about changes.  The transactions
+/// are read on a private queue and saves which land while the history is being read are picked up
+/// by the same pass.  Each subscriber acknowledges the transactions it was handed once its handler
+/// has run, and the history is only purged up to the oldest transaction every subscriber has
+/// acknowledged, so a subscriber which keeps a token across launches can replay what it missed.
+@objc public class PersistentHistoryChangeProcessor: NSObject {
+
+    @objc public static let shared = PersistentHistoryChangeProcessor()
+
+    /// History older than this is purged on start even when a subscriber from an earlier launch may still want it,
+    /// a subscriber whose token has been purged is told it expired
+    static let maximumHistoryAge: TimeInterval = 7 * 24 * 60 * 60
+
+    /// The transaction author of saves which rewrite stored values without changing them, such as storage migrations.
+    /// Their transactions are read past but not handed to subscribers.
+    static let maintenanceAuthor = "mil.nga.giat.mage.maintenance"
+
+    private let processQueue = DispatchQueue(label: "mil.nga.giat.mage.persistentHistory", qos: .utility)
+    private let lock = NSLock()
+    private var context: NSManagedObjectContext?
+    // the last transaction read, only written on the process queue
+    private var position: PersistentHistoryPosition?
+    private var purgedTransactionNumber: Int64?
+    private var processScheduled = false
+    private var subscriptions: [PersistentHistorySubscription] = []
+    private var observers: [NSObjectProtocol] = []
+
+    /// Start reading the history of the stores of the coordinator from now on
+    @objc public func start(coordinator: NSPersistentStoreCoordinator) {
+        start(coordinator: coordinator, after: PersistentHistoryChangeProcessor.lastTransaction(coordinator: coordinator))
+    }
+
+    /// Start reading the history of the stores of the coordinator after the transaction, or from the oldest history there is
+    func start(coordinator: NSPersistentStoreCoordinator, after position: PersistentHistoryPosition?) {
+        stop()
+        let context = NSManagedObjectContext(concurrencyType: .privateQueueConcurrencyType)
+        context.persistentStoreCoordinator = coordinator
+        context.performAndWait {
+            _ = try? context.execute(NSPersistentHistoryChangeRequest.deleteHistory(before: Date(timeIntervalSinceNow: -PersistentHistoryChangeProcessor.maximumHistoryAge)))
+        }
+        processQueue.sync {
+            lock.lock()
+            self.context = context
+            self.position = position
+            self.purgedTransactionNumber = nil
+            lock.unlock()
+        }
+
+        observers.append(NotificationCenter.default.addObserver(forName: .NSPersistentStoreRemoteChange, object: coordinator, queue: nil) { [weak self] _ in
+            self?.scheduleProcessing()
+        })
+        // saves by this app which reached the store
+        observers.append(NotificationCenter.default.addObserver(forName: .NSManagedObjectContextDidSave, object: nil, queue: nil) { [weak self] notification in
+            guard let savedContext = notification.object as? NSManagedObjectContext, savedContext.parent == nil, savedContext.persistentStoreCoordinator === coordinator else {
+                return
+            }
+            self?.scheduleProcessing()
+        })
+        scheduleProcessing()
+    }
+
+    @objc public func stop() {
+        for observer in observers {
+            NotificationCenter.default.removeObserver(observer)
+        }
+        observers.removeAll()
+        lock.lock()
+        context = nil
+        lock.unlock()
+    }
+
+    /// The handler is called on the queue with the changes to the entities, or to entities inheriting from them, once for each
+    /// pass over the history.  When keys are given updates which did not change one of the keys are left out, inserts and deletes are always included.
+    @objc public func subscribe(entityNames: [String], keys: [String]?, queue: DispatchQueue, handler: @escaping ([EntityChangeSet]) -> Void) -> PersistentHistorySubscription {
+        return subscribe(entityNames: entityNames, keys: keys, after: nil, queue: queue) { changeSets, _ in
+            handler(changeSets)
+        }
+    }
+
+    /// As above, with the token of the last transaction the changes came from so the subscriber can keep it and pass it
+    /// back as the after token the next time it subscribes, which first replays the changes after the token.  When the
+    /// history after the token has already been purged expired is called on the queue instead and the subscriber hears
+    /// about new changes only.
+    public func subscribe(entityNames: [String], keys: [String]?, after token: NSPersistentHistoryToken?, queue: DispatchQueue, expired: (() -> Void)? = nil, handler: @escaping ([EntityChangeSet], NSPersistentHistoryToken) -> Void) -> PersistentHistorySubscription {
+        lock.lock()
+        // a subscriber which replays has acknowledged nothing until the replay is delivered
+        let acknowledged = token == nil ? position : nil
+        let subscription = PersistentHistorySubscription(entityNames: Set(entityNames), keys: keys.map { Set($0) }, queue: queue, replayToken: token, acknowledged: acknowledged, expired: expired, handler: handler)
+        subscription.processor = self
+        subscriptions.append(subscription)
+        lock.unlock()
+        if token != nil {
+            scheduleProcessing()
+        }
+        return subscription
+    }
+
+    func unsubscribe(_ subscription: PersistentHistorySubscription) {
+        lock.lock()
+        subscriptions.removeAll { $0 === subscription }
+        lock.unlock()
+    }
+
+    /// Read and deliver any history which has not been delivered yet, blocks until the handlers have been queued
+    @objc public func processPendingChanges() {
+        processQueue.sync {
+            process()
+        }
+    }
+
+    /// The object ids from the ids which match the predicate, fetched from the store on a private context so subscribers
+    /// can narrow large change sets down before touching the main context
+    @objc public func objectIDs(entityName: String, matching predicate: NSPredicate, among objectIDs: Set<NSManagedObjectID>) -> [NSManagedObjectID] {
+        guard !objectIDs.isEmpty, let context = currentContext() else {
+            return []
+        }
+        var matched: [NSManagedObjectID] = []
+        context.performAndWait {
+            let fetchRequest = NSFetchRequest<NSManagedObjectID>(entityName: entityName)
+            fetchRequest.resultType = .managedObjectIDResultType
+            fetchRequest.predicate = NSCompoundPredicate(andPredicateWithSubpredicates: [NSPredicate(format: "self IN %@", Array(objectIDs)), predicate])
+            matched = (try? context.fetch(fetchRequest)) ?? []
+        }
+        return matched
+    }
+
+    /// Count from the store on a private context
+    @objc public func count(entityName: String, matching predicate: NSPredicate) -> Int {
+        guard let context = currentContext() else {
+            return 0
+        }
+        var count = 0
+        context.performAndWait {
+            let fetchRequest = NSFetchRequest<NSNumber>(entityName: entityName)
+            fetchRequest.predicate = predicate
+            count = (try? context.count(for: fetchRequest)) ?? 0
+        }
+        return count
+    }
+
+    private func currentContext() -> NSManagedObjectContext? {
+        lock.lock()
+        defer { lock.unlock() }
+        return context
+    }
+
+    private func scheduleProcessing() {
+        lock.lock()
+        defer { lock.unlock() }
+        if processScheduled {
+            return
+        }
+        processScheduled = true
+        processQueue.async { [weak self] in
+            self?.process()
+        }
+    }
+
+    // only called on the process queue
+    private func process() {
+        lock.lock()
+        processScheduled = false
+        let context = self.context
+        let subscriptions = self.subscriptions
+        lock.unlock()
+        guard let context = context else {
+            return
+        }
+
+        let start = Date()
+        var transactionCount = 0
+        var changeSets: [String: EntityChangeSet] = [:]
+        var replays: [(subscription: PersistentHistorySubscription, changeSets: [String: EntityChangeSet], position: PersistentHistoryPosition?)] = []
+        var expired: [PersistentHistorySubscription] = []
+        context.performAndWait {
+            let transactions = (try? PersistentHistoryChangeProcessor.fetchTransactions(after: position?.token, context: context)) ?? []
+            if let last = transactions.last {
+                lock.lock()
+                position = PersistentHistoryPosition(last)
+                lock.unlock()
+            }
+            transactionCount = transactions.count
+            changeSets = PersistentHistoryChangeProcessor.changeSets(transactions: transactions)
+
+            // replay up to where every other subscriber is now, later changes are delivered to it by the next pass
+            for subscription in subscriptions {
+                guard let replayToken = subscription.replayToken else {
+                    continue
+                }
+                subscription.replayToken = nil
+                do {
+                    let replayed = try PersistentHistoryChangeProcessor.fetchTransactions(after: replayToken, context: context).filter { $0.transactionNumber <= position?.transactionNumber ?? 0 }
+                    replays.append((subscription, PersistentHistoryChangeProcessor.changeSets(transactions: replayed), replayed.last.map { PersistentHistoryPosition($0) } ?? position))
+                } catch {
+                    // NSPersistentHistoryTokenExpiredError when the history after the token was purged
+                    NSLog("Could not replay the persistent history: \(error)")
+                    expired.append(subscription)
+                }
+            }
+        }
+
+        for replay in replays {
+            deliver(changeSets: replay.changeSets, through: replay.position, to: replay.subscription)
+        }
+        for subscription in expired {
+            let position = self.position
+            subscription.queue.async {
+                subscription.expired?()
+                if let position = position {
+                    subscription.acknowledge(position)
+                }
+            }
+        }
+        if transactionCount > 0, let position = position {
+            for subscription in subscriptions where !replays.contains(where: { $0.subscription === subscription }) && !expired.contains(where: { $0 === subscription }) {
+                deliver(changeSets: changeSets, through: position, to: subscription)
+            }
+            NSLog("TIMING Processed \(transactionCount) history transactions changing \(changeSets.values.map { $0.inserted.count + $0.updated.count + $0.deleted.count }.reduce(0, +)) objects. Elapsed: \(start.timeIntervalSinceNow) seconds")
+        }
+        purgeAcknowledgedHistory(context: context)
+    }
+
+    private func deliver(changeSets: [String: EntityChangeSet], through position: PersistentHistoryPosition?, to subscription: PersistentHistorySubscription) {
+        guard let position = position else {
+            return
+        }
+        let changes = changeSets.values.filter { $0.matches(entityNames: subscription.entityNames) }.compactMap { $0.filtered(keys: subscription.keys) }
+        // acknowledged on the queue so it follows the handlers of earlier passes
+        subscription.queue.async {
+            if !changes.isEmpty {
+                subscription.handler(changes, position.token)
+            }
+            subscription.acknowledge(position)
+        }
+    }
+
+    /// Delete the history every subscriber has acknowledged, nothing is deleted while a subscriber has yet to acknowledge anything
+    private func purgeAcknowledgedHistory(context: NSManagedObjectContext) {
+        lock.lock()
+        let acknowledged = subscriptions.map { $0.acknowledged }
+        lock.unlock()
+        guard !acknowledged.isEmpty, !acknowledged.contains(where: { $0 == nil }),
+              let oldest = acknowledged.compactMap({ $0 }).min(by: { $0.transactionNumber < $1.transactionNumber }),
+              oldest.transactionNumber > purgedTransactionNumber ?? Int64.min else {
+            return
+        }
+        context.performAndWait {
+            _ = try? context.execute(NSPersistentHistoryChangeRequest.deleteHistory(before: oldest.token))
+        }
+        purgedTransactionNumber = oldest.transactionNumber
+    }
+
+    private static func fetchTransactions(after token: NSPersistentHistoryToken?, context: NSManagedObjectContext) throws -> [NSPersistentHistoryTransaction] {
+        let request = NSPersistentHistoryChangeRequest.fetchHistory(after: token)
+        request.resultType = .transactionsAndChanges
+        let result = try context.execute(request) as? NSPersistentHistoryResult
+        return result?.result as? [NSPersistentHistoryTransaction] ?? []
+    }
+
+    /// The newest transaction in the history
+    static func lastTransaction(coordinator: NSPersistentStoreCoordinator) -> PersistentHistoryPosition? {
+        guard let fetchRequest = NSPersistentHistoryTransaction.fetchRequest else {
+            return nil
+        }
+        fetchRequest.sortDescriptors = [NSSortDescriptor(key: "transactionNumber", ascending: false)]
+        fetchRequest.fetchLimit = 1
+        let request = NSPersistentHistoryChangeRequest.fetchHistory(withFetch: fetchRequest)
+        request.resultType = .transactionsOnly
+        let context = NSManagedObjectContext(concurrencyType: .privateQueueConcurrencyType)
+        context.persistentStoreCoordinator = coordinator
+        var position: PersistentHistoryPosition?
+        context.performAndWait {
+            let result = (try? context.execute(request)) as? NSPersistentHistoryResult
+            position = (result?.result as? [NSPersistentHistoryTransaction])?.first.map { PersistentHistoryPosition($0) }
+        }
+        return position
+    }
+
+    private static func changeSets(transactions: [NSPersistentHistoryTransaction]) -> [String: EntityChangeSet] {
+        var changeSets: [String: EntityChangeSet] = [:]
+        for transaction in transactions where transaction.author != maintenanceAuthor {
+            for change in transaction.changes ?? [] {
+                let entity = change.changedObjectID.entity
+                let name = entity.name ?? ""
+                let changeSet = changeSets[name] ?? EntityChangeSet(entity: entity)
+                changeSet.record(change)
+                changeSets[name] = changeSet
+            }
+        }
+        return changeSets
+    }
+}
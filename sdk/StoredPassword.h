@@ -6,6 +6,9 @@
 
 #import <Foundation/Foundation.h>
 
+// posted when the token is stored or cleared so copies of it can be dropped
+extern NSString * const StoredPasswordTokenChangedNotification;
+
 @interface StoredPassword : NSObject
 
 + (NSString *) retrieveStoredToken;
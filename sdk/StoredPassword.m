@@ -8,6 +8,8 @@
 #import <Security/Security.h>
 
 
+NSString * const StoredPasswordTokenChangedNotification = @"mil.nga.mage.token.changed";
+
 @implementation StoredPassword
 
 static NSString * const kKeyChainPassword = @"mil.nga.mage.password";
@@ -19,11 +21,14 @@ static NSString * const kKeyChainToken = @"mil.nga.mage.token";
 
 + (NSString *) persistTokenToKeyChain: (NSString *) token {
     NSString *currentToken = [self retrieveStoredToken];
-    return [StoredPassword persistItemToKeyChain:token withService:kKeyChainToken forCurrentItem:currentToken];
+    NSString *storedToken = [StoredPassword persistItemToKeyChain:token withService:kKeyChainToken forCurrentItem:currentToken];
+    [[NSNotificationCenter defaultCenter] postNotificationName:StoredPasswordTokenChangedNotification object:nil];
+    return storedToken;
 }
 
 + (void) clearToken {
     [StoredPassword deleteItemWithService:kKeyChainToken];
+    [[NSNotificationCenter defaultCenter] postNotificationName:StoredPasswordTokenChangedNotification object:nil];
 }
 
 + (void) clearPassword {